@@ -0,0 +1,2063 @@
+#ifndef __BASIC_FRACTION_H__
+#define __BASIC_FRACTION_H__
+
+#include <charconv>
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+#include <cstdlib>
+#include <functional>
+#if defined(__cpp_impl_three_way_comparison) && __cpp_impl_three_way_comparison>=201907L
+#include <compare>
+#endif
+#include <iostream>
+#include <limits>
+#include <ratio>
+#include <stdexcept>
+#include <string>
+#include <type_traits>
+
+#include "FractionGCD.h"
+#include "FractionStats.h"
+
+//FractionWidth describes the integer types used by a BasicFraction whose numerator is Bytes wide.
+//Unsigned is the type of the denominator. It has the same width as the numerator, so that BasicFraction<int> stays 8 bytes.
+//Wide and UWide are the intermediate types of the arithmetic operators. They are twice as wide as the numerator where such a type exists.
+//For the 128 bit numerator there is no wider type, so the intermediates are checked with the overflow builtins instead.
+template<std::size_t Bytes>
+struct FractionWidth;
+
+template<>
+struct FractionWidth<4>
+{
+	typedef std::uint32_t Unsigned;
+	typedef std::int64_t Wide;
+	typedef std::uint64_t UWide;
+};
+
+#ifdef __SIZEOF_INT128__
+template<>
+struct FractionWidth<8>
+{
+	typedef std::uint64_t Unsigned;
+	typedef __int128 Wide;
+	typedef unsigned __int128 UWide;
+};
+
+template<>
+struct FractionWidth<16>
+{
+	typedef unsigned __int128 Unsigned;
+	typedef __int128 Wide;
+	typedef unsigned __int128 UWide;
+};
+#endif
+
+//Status of a checked arithmetic operation.
+enum FractionStatus
+{
+	eFractionOk,	//The exact result is stored in the value
+	eFractionOverflow,	//The exact result does not fit in the Fraction type
+	eFractionDivideByZero	//The divisor is zero
+};
+
+template<typename IntT>
+struct BasicCheckedFraction;
+
+template<typename IntT>
+struct BasicFractionDivMod;
+
+class FractionVector;
+class BigFraction;
+
+template<typename IntT>
+class BasicLazyFraction;
+
+template<typename IntT,typename Slot>
+class BasicFractionHashTable;
+
+//writeInteger() and readInteger() move a numerator or denominator through a stream.
+//The standard streams have no overloads for 128 bit integers, so those are converted through a decimal string.
+template<typename T>
+inline void writeInteger(std::ostream& OUT,T x)
+{
+	OUT << x;
+}
+
+//readInteger() reads an optionally signed decimal integer as a sign and an unsigned magnitude, so a denominator above the maximum of the numerator type reads back.
+//Like the built-in extractions, it stops at the first character that is not a digit, so "1/2" is read as 1 followed by "/2".
+//It sets the failbit if there are no digits or the magnitude does not fit in U.
+template<typename U>
+inline void readInteger(std::istream& IN,bool& negative,U& magnitude)
+{
+	if(!(IN >> std::ws))
+		return;
+	negative=(IN.peek()=='-');
+	if(IN.peek()=='-' || IN.peek()=='+')
+		IN.get();
+	U m=0;
+	bool digits=false,overflow=false;
+	for(int c=IN.peek();c>='0' && c<='9';c=IN.peek())
+	{
+		U digit=static_cast<U>(IN.get()-'0');
+		overflow=overflow || __builtin_mul_overflow(m,static_cast<U>(10),&m) || __builtin_add_overflow(m,digit,&m);
+		digits=true;
+	}
+	if(!digits || overflow)
+	{
+		IN.setstate(std::ios::failbit);
+		return;
+	}
+	magnitude=m;
+}
+
+#ifdef __SIZEOF_INT128__
+inline void writeInteger(std::ostream& OUT,unsigned __int128 x)
+{
+	char buffer[40];
+	char* end=buffer+sizeof(buffer);
+	char* begin=end;
+	do
+	{
+		*--begin=static_cast<char>('0'+static_cast<int>(x%10));
+		x/=10;
+	}
+	while(x!=0);
+	OUT << std::string(begin,end);
+}
+
+inline void writeInteger(std::ostream& OUT,__int128 x)
+{
+	if(x<0)
+	{
+		OUT << '-';
+		writeInteger(OUT,0-static_cast<unsigned __int128>(x));
+		return;
+	}
+	writeInteger(OUT,static_cast<unsigned __int128>(x));
+}
+#endif
+
+//BasicFraction is the Fraction data type for a signed numerator type IntT.
+//The instantiations are BasicFraction<std::int32_t> (the classic Fraction), BasicFraction<std::int64_t> and BasicFraction<__int128>.
+//The numerator carries the sign and the denominator is an unsigned integer of the same width.
+//Every object is normalized: the denominator is positive, the two are coprime and zero is stored as 0/1.
+//Everything except the floating point Constructor and the stream operators is constexpr, so Fractions can be computed at compile time.
+template<typename IntT>
+class BasicFraction
+{
+public:
+	//Unsigned is the type of the denominator.
+	typedef typename FractionWidth<sizeof(IntT)>::Unsigned Unsigned;
+
+private:
+	//Wide and UWide are the signed and unsigned intermediate types of the arithmetic operators.
+	typedef typename FractionWidth<sizeof(IntT)>::Wide Wide;
+	typedef typename FractionWidth<sizeof(IntT)>::UWide UWide;
+
+	//The data members have been made private for information hiding.
+	//The user feels like he is actually dealing with a Fraction data type and not with two integers.
+
+	IntT p;	//Numerator
+	Unsigned q;	//Denominator
+
+public:
+	//The static constants declared here are made public in order to be used by the user whenever he needs them.
+	//They are defined constexpr after the class, so they are constant-initialized and need no code at startup.
+
+	static const BasicFraction sc_fUnity;	//Fraction Unity 1/1
+	static const BasicFraction sc_fZero;	//Fraction Zero 0/1
+
+private:
+	//Utility Functions
+	//Utitlity Functions are functions that are to be accessed by the class alone for its internal computations.
+	//These are not be seen by the user and thus are made private.
+	//Some of them are made static because they are part of the class and not part of the behaviour of an instance of the class.
+
+	//maxUnsigned() and maxNumerator() return the largest denominator and the largest positive numerator.
+	//They are computed from Unsigned because std::numeric_limits is not specialized for __int128 in strict standard modes.
+	static constexpr Unsigned maxUnsigned() {return static_cast<Unsigned>(~static_cast<Unsigned>(0));}
+	static constexpr Unsigned maxNumerator() {return static_cast<Unsigned>(maxUnsigned()>>1);}
+
+	//magnitude() returns the absolute value of a signed integer as unsigned so that the most negative value is handled.
+	static constexpr Unsigned magnitude(IntT x) {return x<0 ? static_cast<Unsigned>(0-static_cast<Unsigned>(x)) : static_cast<Unsigned>(x);}
+	static constexpr UWide magnitudeWide(Wide x) {return x<0 ? static_cast<UWide>(0-static_cast<UWide>(x)) : static_cast<UWide>(x);}
+
+	//gcd(Unsigned,Unsigned) function returns a Greatest Common Divisor of two positive integers passed to it as arguments.
+	//Built-in types are passed by value.(To avoid overheads caused by referencing to built-in types)
+	//The function returns the GCD of the two integers by value.(It is fatal to return a temporary local variable to a function by reference)
+	//It is made static as it is only a part of the class and there is no meaning for an instance of the Fraction class i.e. a Fraction object to have gcd() as a non-static member function.
+	//It delegates to the GCD engine in FractionGCD.h, which is specialized on the width of Unsigned.
+	//32 and 64 bit denominators use the binary GCD in a single register, 128 bit denominators may use Lehmer steps (FRACTION_GCD_ALGORITHM).
+	static constexpr Unsigned gcd(Unsigned a,Unsigned b) {return FractionGCD::gcd<Unsigned>(a,b);}
+
+	//lcm(Unsigned,Unsigned) function returns a Least Commmon Multiple of two positive integers passed to it as arguments.
+	//Built-in types are passed by value.(To avoid overheads caused by referencing to built-in types)
+	//The function returns the LCM of the two integers by value.(It is fatal to return a temporary local variable to a function by reference)
+	//It is made static as it is only a part of the class and there is no meaning for an instance of the Fraction class i.e. a Fraction object to have lcm() as a non-static member function.
+	static constexpr Unsigned lcm(Unsigned a,Unsigned b) {return (a/gcd(a,b))*b;}
+
+	//normalize() function acts on a Fraction Object to normalize it's data members p and q.
+	//It is a utility function to be only used by the class internally and is not exposed to the user.
+	//It normalizes the Fraction p/q as per the norms mentioned in the assignment.
+	//It does not take any explicit arguments but the Fraction *const this is implcitly passes when the function is called upon by an instance of the class.
+	//It's return type is void as it only makes changes to the data members of the object and does bot explicitly return anything.
+	//The sign has already been moved to the numerator by the constructor, so only the gcd remains to be cancelled.
+	constexpr void normalize();
+
+	//Reduced is a tag type selecting the private constructor that stores an already normalized pair without calling normalize().
+	struct Reduced {};
+
+	//FractionVector stores normalized pairs in its own arrays and rebuilds Fractions from them with the Reduced constructor.
+	friend class FractionVector;
+
+	//BasicLazyFraction and BigFraction reduce their terms themselves and build the normalized result with the Reduced constructor.
+	friend class BasicLazyFraction<IntT>;
+	friend class BigFraction;
+
+	//BasicFractionHashTable keeps the normalized pairs in its slots and rebuilds the keys with the Reduced constructor.
+	template<typename,typename> friend class BasicFractionHashTable;
+
+	//This private Constructor is used by the arithmetic operators which produce their results in lowest terms by cross-cancellation.
+	//It skips the gcd computation of the public Constructor.
+	constexpr BasicFraction(IntT m,Unsigned n,Reduced) : p(m),q(n) {}
+
+	//fit(bool,UWide,UWide) function converts an exact result computed in wide intermediates to a checked Fraction.
+	//The result is the negated magnitude num/den if negative is true. The pair must already be in lowest terms with den>0.
+	//It reports an overflow if the numerator does not fit in IntT or den does not fit in Unsigned.
+	static constexpr BasicCheckedFraction<IntT> fit(bool,UWide,UWide) noexcept;
+
+	//reduce(bool,UWide,UWide) divides a pair of wide terms by their gcd and converts it with fit(). den must be positive.
+	//It is the final step of fromChars() and of the extraction operator.
+	static constexpr BasicCheckedFraction<IntT> reduce(bool,UWide,UWide) noexcept;
+
+	//overflow() and divideByZero() return the checked results of the failed operations.
+	static constexpr BasicCheckedFraction<IntT> overflow() noexcept;
+	static constexpr BasicCheckedFraction<IntT> divideByZero() noexcept;
+
+	//addSub(const BasicFraction&,const BasicFraction&,bool) function adds or subtracts rhs to lhs.
+	//It is the common implementation of checkedAdd() and checkedSub().
+	static constexpr BasicCheckedFraction<IntT> addSub(const BasicFraction&,const BasicFraction&,bool) noexcept;
+
+	//mul(const BasicFraction&,const BasicFraction&) and div(const BasicFraction&,const BasicFraction&) are the implementations of checkedMul() and checkedDiv().
+	static constexpr BasicCheckedFraction<IntT> mul(const BasicFraction&,const BasicFraction&) noexcept;
+	static constexpr BasicCheckedFraction<IntT> div(const BasicFraction&,const BasicFraction&) noexcept;
+
+	//Integer is an integer operand of the operators below, split into its sign and its magnitude.
+	struct Integer
+	{
+		bool negative;
+		UWide magnitude;
+	};
+
+	//integerOperand(k) splits an integer of any type K without converting it to IntT, so a wide or unsigned k keeps its value.
+	//A magnitude beyond UWide is saturated to the largest UWide: that is still far beyond any term of a result that fits, so the kernels report the overflow.
+	template<typename K>
+	static constexpr Integer integerOperand(K k) noexcept
+	{
+		typedef typename std::make_unsigned<K>::type UK;
+		Integer m={false,0};
+		UK u=static_cast<UK>(k);
+		if constexpr(std::is_signed<K>::value)
+		{
+			if(k<0)
+			{
+				m.negative=true;
+				u=static_cast<UK>(0-u);
+			}
+		}
+		if constexpr(sizeof(UK)>sizeof(UWide))
+		{
+			if(u>static_cast<UK>(~static_cast<UWide>(0)))
+			{
+				m.magnitude=~static_cast<UWide>(0);
+				return m;
+			}
+		}
+		m.magnitude=static_cast<UWide>(u);
+		return m;
+	}
+
+	//gcdInteger(c,d) returns gcd(c,d) of a magnitude c and a positive d with the gcd of Unsigned, reducing c modulo d first when it is wider.
+	static constexpr Unsigned gcdInteger(UWide c,Unsigned d) {return gcd(c<=maxUnsigned() ? static_cast<Unsigned>(c) : static_cast<Unsigned>(c%d),d);}
+
+	//addInteger(), mulInteger() and divInteger() are the implementations of the operators with an integer operand m.
+	//addInteger(F,m,subtract,reversed) returns F+m, F-m or, if reversed, m-F. divInteger(F,m,reversed) returns F/m or, if reversed, m/F.
+	//They never build a Fraction from m, so m takes no normalization of its own.
+	static constexpr BasicCheckedFraction<IntT> addInteger(const BasicFraction&,Integer,bool subtract,bool reversed) noexcept;
+	static constexpr BasicCheckedFraction<IntT> mulInteger(const BasicFraction&,Integer) noexcept;
+	static constexpr BasicCheckedFraction<IntT> divInteger(const BasicFraction&,Integer,bool reversed) noexcept;
+
+	//Division is the result of divide(): an integer quotient and the remainder, as signs and magnitudes so that no quotient overflows.
+	//The remainder is not reduced, and den is 0 if it does not fit in UWide.
+	struct Division
+	{
+		FractionStatus status;
+		bool negative;	//Sign of the quotient
+		UWide quotient;
+		bool remainderNegative;
+		UWide remainder;
+		UWide den;
+	};
+
+	//divide(const BasicFraction&,const BasicFraction&,bool) divides lhs by rhs with a quotient truncated towards zero, or rounded down if floored is true.
+	//It is the common implementation of operator%, floorDiv() and divmod().
+	static constexpr Division divide(const BasicFraction&,const BasicFraction&,bool floored) noexcept;
+
+	//Double is an unsigned integer of twice the width of Unsigned, as a high and a low word.
+	//It holds the products of two terms where UWide is not wider than Unsigned, i.e. for the 128 bit Fraction.
+	//Its shifts take a count below its width, and the subtraction wraps like the one of an unsigned type.
+	struct Double
+	{
+		static constexpr int sc_nBits=std::numeric_limits<Unsigned>::digits;
+
+		Unsigned high;
+		Unsigned low;
+
+		constexpr bool isZero() const {return high==0 && low==0;}
+		constexpr bool bit(int i) const {return ((i<sc_nBits ? low>>i : high>>(i-sc_nBits))&1)!=0;}
+		constexpr int countTrailingZeros() const {return low ? FractionGCD::countTrailingZeros(low) : sc_nBits+FractionGCD::countTrailingZeros(high);}
+		constexpr int length() const {return high ? 2*sc_nBits-countLeadingZeros(high) : sc_nBits-countLeadingZeros(low);}
+
+		friend constexpr bool operator==(Double x,Double y) {return x.high==y.high && x.low==y.low;}
+		friend constexpr bool operator<(Double x,Double y) {return x.high!=y.high ? x.high<y.high : x.low<y.low;}
+		friend constexpr Double operator-(Double x,Double y) {return Double{x.high-y.high-(x.low<y.low ? 1 : 0),x.low-y.low};}
+		friend constexpr Double operator<<(Double x,int n)
+		{
+			if(n==0)
+				return x;
+			return n<sc_nBits ? Double{(x.high<<n)|(x.low>>(sc_nBits-n)),x.low<<n} : Double{x.low<<(n-sc_nBits),0};
+		}
+		friend constexpr Double operator>>(Double x,int n)
+		{
+			if(n==0)
+				return x;
+			return n<sc_nBits ? Double{x.high>>n,(x.low>>n)|(x.high<<(sc_nBits-n))} : Double{0,x.high>>(n-sc_nBits)};
+		}
+
+		//countLeadingZeros(Unsigned) returns the leading zero bits of a word, sc_nBits for 0.
+		static constexpr int countLeadingZeros(Unsigned x)
+		{
+			int n=0;
+			for(int half=sc_nBits/2;half>0;half/=2)
+			{
+				if((x>>(sc_nBits-half))==0)
+				{
+					n+=half;
+					x<<=half;
+				}
+			}
+			return x ? n : sc_nBits;
+		}
+	};
+
+	//multiplyDouble(Unsigned,Unsigned) returns the exact product of two words, formed from their half words.
+	static constexpr Double multiplyDouble(Unsigned,Unsigned) noexcept;
+
+	//divideDouble(Double,Double,Double&) returns x/y for y>0 by shifting and subtracting, and stores x%y in remainder. x and y must be below 2^(2*sc_nBits-1).
+	static constexpr Double divideDouble(Double x,Double y,Double& remainder) noexcept;
+
+	//gcdDouble(Double,Double) returns the gcd of two Doubles by the binary algorithm.
+	static constexpr Double gcdDouble(Double,Double) noexcept;
+
+	//divideExact(const BasicFraction&,const BasicFraction&,bool,Unsigned) is the part of divide() for the operands whose scaled numerators do not fit in Wide
+	//or whose common denominator does not fit in UWide.
+	//It forms them and the common denominator as Doubles, so the remainder is exact whatever the quotient. g is gcd(lhs.q,rhs.q).
+	static constexpr Division divideExact(const BasicFraction&,const BasicFraction&,bool floored,Unsigned g) noexcept;
+
+	//integer(const Division&) returns the quotient as a checked Fraction and remainder(const Division&) the reduced remainder.
+	static constexpr BasicCheckedFraction<IntT> integer(const Division&) noexcept;
+	static constexpr BasicCheckedFraction<IntT> remainder(const Division&) noexcept;
+
+	//compareProducts(Unsigned,Unsigned,Unsigned,Unsigned) returns the sign of a*b-c*d.
+	//The products are formed in UWide. For the 128 bit Fraction UWide is not wider than Unsigned, so they are formed as Doubles.
+	static constexpr int compareProducts(Unsigned,Unsigned,Unsigned,Unsigned) noexcept;
+
+	//value() returns the value of a checked result or throws the exception matching its status.
+	//It is used by the binary arithmetic operators which report errors by exceptions.
+	static constexpr BasicFraction value(const BasicCheckedFraction<IntT>&);
+
+	//fail(FractionStatus) throws the exception matching a failed status.
+	//It is kept out of line and marked cold, so the operators inline only a test of the status and their loops are optimized like those of the checked functions.
+	[[noreturn]] __attribute__((noinline,cold)) static void fail(FractionStatus);
+
+	//Exact is the unsigned type of the continued fraction expansion in fromBinary(). It holds a 64 bit mantissa over a denominator of up to 2^126.
+#ifdef __SIZEOF_INT128__
+	typedef unsigned __int128 Exact;
+#else
+	typedef std::uint64_t Exact;
+#endif
+
+	//quotient(W,W) divides with a 64 bit division when both operands fit, which is much faster than a 128 bit one.
+	template<typename W>
+	static W quotient(W n,W d)
+	{
+		if(sizeof(W)<=sizeof(std::uint64_t) || ((n|d)>>63>>1)==0)
+			return static_cast<std::uint64_t>(n)/static_cast<std::uint64_t>(d);
+		return n/d;
+	}
+
+	//continuedFraction(bool,W,W,W,W) returns the best approximation of (-1)^negative*n/d with a numerator at most largest and a denominator at most maxDenominator.
+	//It is instantiated for 64 bit words, which cover every double of moderate exponent for Fraction and Fraction64, and for Exact.
+	template<typename W>
+	static BasicFraction continuedFraction(bool negative,W n,W d,W largest,W maxDenominator);
+
+	//fromBinary(bool,std::uint64_t,int,Unsigned) returns the best approximation of (-1)^negative*m*2^e whose denominator is at most maxDenominator.
+	//It is the common implementation of the floating point Constructor and bestRational().
+	static BasicFraction fromBinary(bool negative,std::uint64_t m,int e,Unsigned maxDenominator);
+
+	//fromFloat(FloatT,Unsigned) splits a floating point value into its mantissa and exponent with frexp() and calls fromBinary().
+	template<typename FloatT>
+	static BasicFraction fromFloat(FloatT d,Unsigned maxDenominator)
+	{
+		if(!std::isfinite(d))
+		{
+			throw std::invalid_argument("Fraction: the floating point value is not finite");
+		}
+		int e=0;
+		FloatT m=std::frexp(std::fabs(d),&e);
+		const int digits=std::numeric_limits<FloatT>::digits<=64 ? std::numeric_limits<FloatT>::digits : 64;
+		return fromBinary(d<0,static_cast<std::uint64_t>(std::ldexp(m,digits)),e-digits,maxDenominator);
+	}
+
+	//writeDigits(char*,Unsigned) writes the decimal digits of x backwards from end, two at a time, and returns the first digit written.
+	static constexpr char* writeDigits(char* end,Unsigned x);
+
+	//readDigits(const char*,const char*,UWide&,bool&) accumulates the decimal digits at the start of [s,last) in x and returns the end of the digits.
+	//overflow is set if x does not hold them.
+	static constexpr const char* readDigits(const char* s,const char* last,UWide& x,bool& overflow);
+
+	//mix(std::uint64_t) is the 64 bit finalizer of MurmurHash3: every input bit affects every output bit.
+	static constexpr std::uint64_t mix(std::uint64_t x)
+	{
+		x^=x>>33;
+		x*=0xff51afd7ed558ccdULL;
+		x^=x>>33;
+		x*=0xc4ceb9fe1a85ec53ULL;
+		x^=x>>33;
+		return x;
+	}
+
+	//fitsIntmax(std::intmax_t) returns true if a std::ratio term fits in the numerator type.
+	static constexpr bool fitsIntmax(std::intmax_t x)
+	{
+		return sizeof(IntT)>=sizeof(std::intmax_t) || (x<=static_cast<std::intmax_t>(maxNumerator()) && x>=-static_cast<std::intmax_t>(maxNumerator())-1);
+	}
+
+public:
+
+	//Constructors
+
+	//This is a Constructor of the Fraction class and has three ways of being called.
+	//1)As a default no args Constructor Fraction().
+	//2)As a one arg Constructor Fraction(int).
+	//3)As a two args Constructor Fraction(int,int).
+	//These three ways are possible because the parameters are defaulted.
+	//Built-in type parameters passed to the constructor are by value.(To avoid overheads caused by referencing to built-in types)
+	//This Constructor takes two integer arguments as parameters and constructs a normalized Fraction based on them.
+	//A negative denominator moves its sign to the numerator.
+	//If n=0 then, it throws std::runtime_error like the division operators, and if m/n does not fit, e.g. INT_MIN/-1, std::overflow_error.
+	//make() reports both without an exception.
+	constexpr BasicFraction(IntT m=1,IntT n=1);
+
+	//make(m,n) is the checked form of the Constructor: it returns the normalized m/n, eFractionDivideByZero if n=0 and eFractionOverflow if m/n does not fit, e.g. for INT_MIN/-1.
+	//It never throws.
+	static constexpr BasicCheckedFraction<IntT> make(IntT m,IntT n=1) noexcept;
+
+	//This is another Constructor of the Fraction class which takes a floating point value as an argument.
+	//Built-in type parameters passed to the constructor are by value.(To avoid overheads caused by referencing to built-in types)
+	//The value is split into its binary mantissa and exponent, so a value m*2^e whose terms fit, e.g. 0.375 or 1e6, is converted exactly.
+	//Any other value is converted to its best rational approximation with a denominator that fits, bestRational(d,~0), e.g. 7.2 becomes 36/5.
+	//It throws std::overflow_error if the integer part of d does not fit in IntT and std::invalid_argument for NaN and infinities.
+	//It is a template restricted to floating point types so that an integer argument always selects the integer Constructor, whatever the width of IntT.
+	template<typename FloatT,typename=typename std::enable_if<std::is_floating_point<FloatT>::value>::type>
+	BasicFraction(FloatT d)
+	{
+		*this=fromFloat(d,maxUnsigned());
+	}
+
+
+	//This Constructor converts a compile-time std::ratio, e.g. Fraction(std::milli()).
+	//std::ratio is already normalized, so no gcd is computed. A ratio whose terms do not fit in IntT does not compile.
+	template<std::intmax_t N,std::intmax_t D>
+	constexpr BasicFraction(std::ratio<N,D>)
+	: p(static_cast<IntT>(std::ratio<N,D>::num)),q(static_cast<Unsigned>(std::ratio<N,D>::den))
+	{
+		static_assert(fitsIntmax(std::ratio<N,D>::num) && fitsIntmax(std::ratio<N,D>::den),"The std::ratio does not fit in this Fraction type");
+	}
+
+	//bestRational(double,Unsigned) returns the Fraction closest to a double among those whose denominator is at most maxDenominator,
+	//e.g. bestRational(3.14159265358979,1000) is 355/113. Ties go to the smaller denominator, then to the smaller magnitude.
+	//It walks the continued fraction expansion of the exact binary value and picks the best convergent or semiconvergent (Stern-Brocot search), so it needs no floating point arithmetic.
+	//It throws std::invalid_argument if maxDenominator is 0 or the value is not finite, and std::overflow_error if its integer part does not fit in IntT.
+	static BasicFraction bestRational(double d,Unsigned maxDenominator) {return fromFloat(d,maxDenominator);}
+
+	//fromDecimal(const char*) returns the exact value of a decimal string such as "42", "-0.125" or "6.02e3".
+	//Digit separators (') are skipped. It is the parser of the _fr literals.
+	//It throws std::invalid_argument for a malformed string and std::overflow_error if the value does not fit, so a bad literal fails to compile.
+	static constexpr BasicFraction fromDecimal(const char*);
+
+	//toChars(char*,char*) writes the Fraction to the buffer [first,last) as "p/q", or as "p" if it is an integer, like std::to_chars.
+	//It returns the end of the text, or {last,std::errc::value_too_large} if the buffer is too small. It never allocates.
+	constexpr std::to_chars_result toChars(char* first,char* last) const;
+
+	//fromChars(const char*,const char*,BasicFraction&) parses the text [first,last) like std::from_chars.
+	//It accepts "p/q", "p / q", integers and decimals such as "-0.125" or "6.02e3", and normalizes the value, e.g. "6/4" is 3/2.
+	//Like std::from_chars it skips no leading whitespace, accepts no '+' sign and matches the longest valid prefix, so "3 4" reads 3.
+	//It returns the end of the match. A value that does not fit gives std::errc::result_out_of_range, and a malformed text or a zero denominator std::errc::invalid_argument.
+	//The value is only assigned on success. It never allocates.
+	static constexpr std::from_chars_result fromChars(const char* first,const char* last,BasicFraction& value);
+
+
+	//Accessors
+
+	//numerator() returns the numerator of the normalized Fraction. It carries the sign of the Fraction.
+	constexpr IntT numerator() const noexcept {return p;}
+
+	//denominator() returns the denominator of the normalized Fraction. It is always positive.
+	constexpr Unsigned denominator() const noexcept {return q;}
+
+	//hash() returns a 64 bit hash of the Fraction, used by std::hash and FractionHashMap.
+	//Equal Fractions have equal normalized terms, so the terms are mixed directly without any gcd or division.
+	constexpr std::uint64_t hash() const;
+
+
+	//Copy Constructor
+
+	//This is the copy constructor of the Fraction Class.
+	//It takes a Fraction object as const so that the constructor is forbidden from arbitarily altering the data members of the passed object and has only read-only access to them.
+	//It takes a Fraction object by reference.(If it was taken by value the program falls into an infinite loop of copying as Call by value uses the Copy Constructor to construct the formal parameter object based on the actual parameter object)
+	//The Copy Constructor simply constructs a new object of class Fraction based on the data members of the Parameter Object.
+	//It is defaulted so that Fraction is trivially copyable: copies are plain register moves and loops over Fractions can be vectorized.
+	BasicFraction(const BasicFraction&) = default;
+
+
+	//Destructor
+
+	//This is the destructor of the Fraction Class and has the default semantics as there are no pointers or allocated memory that's needs to be explicitly destroyed.
+	//It is defaulted so that it stays trivial, which a literal type usable in constant expressions requires.
+	~BasicFraction() = default;
+
+
+	//Copy Assignment Operator
+
+	//This is the copy assignment operator.
+	//The left operand is implicitly passed as Fraction *const this.
+	//The right operand has to be explicitly passed. It is passed by reference to avoid the overhead of copying. It is passed as const so that no changes can be made to the actual source object.
+	//It returns Fraction object by reference to support chaining of assignments. Thus (F1=F2) returns a reference to F1 and then this can be done (F3=F1=F2).
+	//Self-copy needs no check because copying the two data members onto themselves is harmless.
+	//It is defaulted for the same reason as the Copy Constructor.
+	//F1=F2 <------> F1.operator=(F2)
+	BasicFraction& operator=(const BasicFraction&) = default;
+
+
+	//Unary Arithmetic Operators
+
+	//The overloaded unary minus operator is a public member function and is const qualified.
+	//It is made const so that it does not alter the operand.
+	//Implicitly const Fraction *const this is passed to the function.
+	//It returns by value because it creates a new object based on the semantics of the operator and the operand.
+	//-F1 <-------> F1.operator-()
+	constexpr BasicFraction operator-() const;
+
+	//The overloaded unary plus operator is a public member function and is const qualified.
+	//It is made const so that it does not alter the operand.
+	//Implicitly const Fraction *const this is passed to the function.
+	//It returns by value because it creates a new object based on the semantics of the operator and the operand.
+	//+F1 <-------> F1.operator+()
+	constexpr BasicFraction operator+() const;
+
+	//The overloaded unary pre-drecrement operator is a public member function.
+	//It is not const because it needs to make changes to the operand.
+	//Implicitly Fraction *const this is passed to the function.
+	//It returns by value because it creates a new object based on the semantics of the operator and the operand.
+	//This function first alters the operand and then returns a copy of it.
+	//--F1 <-------> F1.operator--()
+	constexpr BasicFraction operator--();
+
+	//The overloaded unary post-drecrement operator is a public member function.
+	//It is not const because it needs to make changes to the operand.
+	//Implicitly Fraction *const this is passed to the function.
+	//It returns by value because it creates a new object based on the semantics of the operator and the operand.
+	//This function creates a copy of the operand and then alters the original,finally it returns the copy.
+	//F1-- <-------> F1.operator--(int)
+	constexpr BasicFraction operator--(int);
+
+	//The overloaded unary pre-increment operator is a public member function.
+	//It is not const because it needs to make changes to the operand.
+	//Implicitly Fraction *const this is passed to the function.
+	//It returns by value because it creates a new object based on the semantics of the operator and the operand.
+	//This function first alters the operand and then returns a copy of it.
+	//++F1 <-------> F1.operator++()
+	constexpr BasicFraction operator++();
+
+	//The overloaded unary post-increment operator is a public member function.
+	//It is not const because it needs to make changes to the operand.
+	//Implicitly Fraction *const this is passed to the function.
+	//It returns by value because it creates a new object based on the semantics of the operator and the operand.
+	//This function creates a copy of the operand and then alters the original,finally it returns the copy.
+	//F1++ <-------> F1.operator++(int)
+	constexpr BasicFraction operator++(int);
+
+
+	//Binary Arithmetic Operators
+	//The binary operators are friends defined inside the class so that they are found by argument dependent lookup and still accept implicit conversions of either operand, e.g. F1+0.5.
+	//An integer operand, e.g. F1+3, selects the faster overloads below instead of a conversion.
+
+	//The overloaded binary plus operator is a friend to the Fraction class.
+	//It takes two arguments of type Fraction as const reference to avoid the overhead of copying and to forbid any changes to the operands.
+	//It returns by value the sum of the two Fractions because it creates a new Fraction object with the sum of the two Fractions passed to it.
+	//F1+F2 <------> operator+(F1,F2)
+	//If the sum does not fit in a Fraction, it throws std::overflow_error.
+	friend constexpr BasicFraction operator+(const BasicFraction& lhs,const BasicFraction& rhs)
+	{
+		return(value(addSub(lhs,rhs,false)));
+	}
+
+	//The overloaded binary minus operator is a friend to the Fraction class.
+	//It takes two arguments of type Fraction as const reference to avoid the overhead of copying and to forbid any changes to the operands.
+	//It returns by value the difference of the two Fractions because it creates a new Fraction object with the diferrence of the two Fractions passed to it.
+	//F1-F2 <------> operator-(F1,F2)
+	//If the difference does not fit in a Fraction, it throws std::overflow_error.
+	friend constexpr BasicFraction operator-(const BasicFraction& lhs,const BasicFraction& rhs)
+	{
+		return(value(addSub(lhs,rhs,true)));
+	}
+
+	//The overloaded binary multiply operator is a friend to the Fraction class.
+	//It takes two arguments of type Fraction as const reference to avoid the overhead of copying and to forbid any changes to the operands.
+	//It returns by value the product of the two Fractions because it creates a new Fraction object with the product of the two Fractions passed to it.
+	//F1*F2 <------> operator*(F1,F2)
+	//If the product does not fit in a Fraction, it throws std::overflow_error.
+	friend constexpr BasicFraction operator*(const BasicFraction& lhs,const BasicFraction& rhs)
+	{
+		return(value(mul(lhs,rhs)));
+	}
+
+	//The overloaded binary divide operator is a friend to the Fraction class.
+	//It takes two arguments of type Fraction as const reference to avoid the overhead of copying and to forbid any changes to the operands.
+	//It returns by value the quotient of the two Fractions because it creates a new Fraction object with the quotient of the two Fractions passed to it.
+	//F1/F2 <------> operator/(F1,F2)
+	//If F2=0 then, it throws an exception because the value F1/F2 becomes undefined and cannot be further used in the program.
+	//If the quotient does not fit in a Fraction, it throws std::overflow_error.
+	friend constexpr BasicFraction operator/(const BasicFraction& lhs,const BasicFraction& rhs)
+	{
+		return(value(div(lhs,rhs)));
+	}
+
+	//Binary Arithmetic Operators with an integer operand
+	//F1+k, k+F1, F1-k, k-F1, F1*k, k*F1, F1/k and k/F1 take any integer type K but bool. The integer keeps its exact value whatever its width and signedness,
+	//e.g. Fraction(1,3000)*3000000000u is 1000000, and no temporary Fraction is built and normalized:
+	//a/b+k is (a+k*b)/b, which is already in lowest terms, and a/b*k and a/b/k cancel a single gcd of k with b or with a.
+	//They are templates restricted to integer types, so a floating point operand still converts through the floating point Constructor.
+	//They throw like the operators on two Fractions.
+	template<typename K,typename=typename std::enable_if<std::is_integral<K>::value && !std::is_same<K,bool>::value>::type>
+	friend constexpr BasicFraction operator+(const BasicFraction& lhs,K rhs)
+	{
+		return(value(addInteger(lhs,integerOperand(rhs),false,false)));
+	}
+
+	template<typename K,typename=typename std::enable_if<std::is_integral<K>::value && !std::is_same<K,bool>::value>::type>
+	friend constexpr BasicFraction operator+(K lhs,const BasicFraction& rhs)
+	{
+		return(value(addInteger(rhs,integerOperand(lhs),false,false)));
+	}
+
+	template<typename K,typename=typename std::enable_if<std::is_integral<K>::value && !std::is_same<K,bool>::value>::type>
+	friend constexpr BasicFraction operator-(const BasicFraction& lhs,K rhs)
+	{
+		return(value(addInteger(lhs,integerOperand(rhs),true,false)));
+	}
+
+	template<typename K,typename=typename std::enable_if<std::is_integral<K>::value && !std::is_same<K,bool>::value>::type>
+	friend constexpr BasicFraction operator-(K lhs,const BasicFraction& rhs)
+	{
+		return(value(addInteger(rhs,integerOperand(lhs),true,true)));
+	}
+
+	template<typename K,typename=typename std::enable_if<std::is_integral<K>::value && !std::is_same<K,bool>::value>::type>
+	friend constexpr BasicFraction operator*(const BasicFraction& lhs,K rhs)
+	{
+		return(value(mulInteger(lhs,integerOperand(rhs))));
+	}
+
+	template<typename K,typename=typename std::enable_if<std::is_integral<K>::value && !std::is_same<K,bool>::value>::type>
+	friend constexpr BasicFraction operator*(K lhs,const BasicFraction& rhs)
+	{
+		return(value(mulInteger(rhs,integerOperand(lhs))));
+	}
+
+	template<typename K,typename=typename std::enable_if<std::is_integral<K>::value && !std::is_same<K,bool>::value>::type>
+	friend constexpr BasicFraction operator/(const BasicFraction& lhs,K rhs)
+	{
+		return(value(divInteger(lhs,integerOperand(rhs),false)));
+	}
+
+	template<typename K,typename=typename std::enable_if<std::is_integral<K>::value && !std::is_same<K,bool>::value>::type>
+	friend constexpr BasicFraction operator/(K lhs,const BasicFraction& rhs)
+	{
+		return(value(divInteger(rhs,integerOperand(lhs),true)));
+	}
+
+	//The overloaded binary modulo operator is a friend to the Fraction class.
+	//It takes two arguments of type Fraction as const reference to avoid the overhead of copying and to forbid any changes to the operands.
+	//It returns by value the remainder of the two Fractions upon division because it creates a new Fraction object with the remainder of the two Fractions passed to it.
+	//The remainder is F1-t*F2 for the quotient t of F1/F2 truncated towards zero, so it has the sign of F1 like fmod() and the built-in %, e.g. (-7/2)%1 is -1/2.
+	//It is computed exactly with one integer division, however large the quotient is.
+	//F1%F2 <------> operator%(F1,F2)
+	//If F2=0 then, it throws an exception because the value F1/F2 becomes undefined and cannot be further used in the program.
+	//If the remainder does not fit in a Fraction, it throws std::overflow_error.
+	friend constexpr BasicFraction operator%(const BasicFraction& lhs,const BasicFraction& rhs)
+	{
+		return(value(checkedMod(lhs,rhs)));
+	}
+
+	//floorDiv(F1,F2) returns the largest integer not greater than F1/F2, e.g. floorDiv(-7/2,1) is -4.
+	//If F2=0 then, it throws std::runtime_error. If the quotient does not fit in a Fraction, it throws std::overflow_error.
+	friend constexpr BasicFraction floorDiv(const BasicFraction& lhs,const BasicFraction& rhs)
+	{
+		return(value(integer(divide(lhs,rhs,true))));
+	}
+
+	//divmod(F1,F2) returns floorDiv(F1,F2) and the remainder F1-floorDiv(F1,F2)*F2, which has the sign of F2, e.g. divmod(-7/2,1) is {-4,1/2}.
+	//It throws like floorDiv() and operator%.
+	friend constexpr BasicFractionDivMod<IntT> divmod(const BasicFraction& lhs,const BasicFraction& rhs)
+	{
+		Division d=divide(lhs,rhs,true);
+		BasicFractionDivMod<IntT> result={value(integer(d)),value(remainder(d))};
+		return result;
+	}
+
+
+	//Checked Arithmetic
+
+	//The checked arithmetic functions are friends to the Fraction class.
+	//They compute the exact result of the operation and report in the returned BasicCheckedFraction whether it fits in the Fraction type, instead of producing a wrapped value.
+	//Common factors are cancelled across the operands before multiplying (Knuth, TAOCP 4.5.1) and products are formed in the Wide intermediate type, so no result that fits is ever lost.
+	//For the 128 bit Fraction an intermediate that overflows 128 bits is reported as an overflow.
+	//The binary arithmetic operators are implemented on top of them and throw std::overflow_error when the result does not fit.
+	//They are noexcept: a server that must not stop calls them and tests the status, or collects the statuses of a loop in a FractionStickyStatus.
+	//checkedAdd(F1,F2) <------> F1+F2
+	friend constexpr BasicCheckedFraction<IntT> checkedAdd(const BasicFraction& lhs,const BasicFraction& rhs) noexcept {return addSub(lhs,rhs,false);}
+
+	//checkedSub(F1,F2) <------> F1-F2
+	friend constexpr BasicCheckedFraction<IntT> checkedSub(const BasicFraction& lhs,const BasicFraction& rhs) noexcept {return addSub(lhs,rhs,true);}
+
+	//checkedMul(F1,F2) <------> F1*F2
+	friend constexpr BasicCheckedFraction<IntT> checkedMul(const BasicFraction& lhs,const BasicFraction& rhs) noexcept {return mul(lhs,rhs);}
+
+	//checkedDiv(F1,F2) <------> F1/F2
+	//If F2=0 then, the status is eFractionDivideByZero.
+	friend constexpr BasicCheckedFraction<IntT> checkedDiv(const BasicFraction& lhs,const BasicFraction& rhs) noexcept {return div(lhs,rhs);}
+
+	//checkedMod(F1,F2) <------> F1%F2
+	//If F2=0 then, the status is eFractionDivideByZero.
+	friend constexpr BasicCheckedFraction<IntT> checkedMod(const BasicFraction& lhs,const BasicFraction& rhs) noexcept
+	{
+		return remainder(divide(lhs,rhs,false));
+	}
+
+	//checkedFloorDiv(F1,F2) <------> floorDiv(F1,F2)
+	//If F2=0 then, the status is eFractionDivideByZero.
+	friend constexpr BasicCheckedFraction<IntT> checkedFloorDiv(const BasicFraction& lhs,const BasicFraction& rhs) noexcept
+	{
+		return integer(divide(lhs,rhs,true));
+	}
+
+	//checkedNeg(F1) <------> -F1
+	//Only the most negative numerator has no opposite.
+	friend constexpr BasicCheckedFraction<IntT> checkedNeg(const BasicFraction& rhs) noexcept
+	{
+		return fit(rhs.p>0,magnitude(rhs.p),rhs.q);
+	}
+
+	//checkedInverse(F1) <------> !F1
+	//If F1=0 then, the status is eFractionDivideByZero. The reciprocal overflows if the denominator is larger than the largest numerator.
+	friend constexpr BasicCheckedFraction<IntT> checkedInverse(const BasicFraction& rhs) noexcept
+	{
+		if(rhs.p==0)
+		{
+			return divideByZero();
+		}
+		return fit(rhs.p<0,rhs.q,magnitude(rhs.p));
+	}
+
+
+	//Binary Relational Operators
+	//The ordering operators compare by cross-multiplying in the Wide intermediate type, which needs no gcd, no division and cannot overflow.
+	//Operands of different signs, or with equal denominators, are decided without any multiplication.
+
+	//compare(F1,F2) is the three-way comparison of two Fractions.
+	//It returns a negative value, zero or a positive value if F1 is less than, equal to or greater than F2, so a sort or a merge computes each comparison once.
+	friend constexpr int compare(const BasicFraction& lhs,const BasicFraction& rhs) noexcept
+	{
+		FRACTION_STATS_RECORD(count(FractionStats::eCompare));
+		int ls=(lhs.p>0)-(lhs.p<0);
+		int rs=(rhs.p>0)-(rhs.p<0);
+		if(ls!=rs)
+		{
+			return ls-rs;
+		}
+		if(lhs.q==rhs.q)
+		{
+			return (lhs.p>rhs.p)-(lhs.p<rhs.p);
+		}
+		//Same sign: |a|*d against |c|*b, with the order reversed for negative operands.
+		int c=compareProducts(magnitude(lhs.p),rhs.q,magnitude(rhs.p),lhs.q);
+		return ls<0 ? -c : c;
+	}
+
+#if defined(__cpp_impl_three_way_comparison) && __cpp_impl_three_way_comparison>=201907L
+	//F1<=>F2 <------> compare(F1,F2)<=>0
+	//Normalized Fractions are equal exactly when their members are equal, so the ordering is strong.
+	friend constexpr std::strong_ordering operator<=>(const BasicFraction& lhs,const BasicFraction& rhs) noexcept
+	{
+		return compare(lhs,rhs)<=>0;
+	}
+#endif
+
+	//The overloaded equality operator is a public member function.
+	//It is made const so that it does not alter the operands.
+	//Implicitly the left hand operand is passed as const Fraction *const this to the function.
+	//EXplicitly the right hand operand is passed to the function as const reference.
+	//It takes the argument of type Fraction as const reference to avoid the overhead of copying and to forbid any changes to the operand.
+	//It returns by boolean value true if the two Fractions are equal else false.
+	//F1==F2 <-------> F1.operator==(F2)
+	constexpr bool operator==(const BasicFraction&) const noexcept;
+
+	//The overloaded inequality operator is a public member function.
+	//It is made const so that it does not alter the operands.
+	//Implicitly the left hand operand is passed as const Fraction *const this to the function.
+	//EXplicitly the right hand operand is passed to the function as const reference.
+	//It takes the argument of type Fraction as const reference to avoid the overhead of copying and to forbid any changes to the operand.
+	//It returns by boolean value true if the two Fractions are not equal else false.
+	//F1!=F2 <-------> F1.operator!=(F2)
+	constexpr bool operator!=(const BasicFraction&) const noexcept;
+
+	//The overloaded less than operator is a public member function.
+	//It is made const so that it does not alter the operands.
+	//Implicitly the left hand operand is passed as const Fraction *const this to the function.
+	//EXplicitly the right hand operand is passed to the function as const reference.
+	//It takes the argument of type Fraction as const reference to avoid the overhead of copying and to forbid any changes to the operand.
+	//It returns by boolean value true if the left operand is less than the right operand else false.
+	//F1<F2 <-------> F1.operator<(F2)
+	constexpr bool operator<(const BasicFraction&) const noexcept;
+
+	//The overloaded less than or equal to operator is a public member function.
+	//It is made const so that it does not alter the operands.
+	//Implicitly the left hand operand is passed as const Fraction *const this to the function.
+	//EXplicitly the right hand operand is passed to the function as const reference.
+	//It takes the argument of type Fraction as const reference to avoid the overhead of copying and to forbid any changes to the operand.
+	//It returns by boolean value true if the left operand is less than or equal to the right operand else false.
+	//F1<=F2 <-------> F1.operator<=(F2)
+	constexpr bool operator<=(const BasicFraction&) const noexcept;
+
+	//The overloaded greater than operator is a public member function.
+	//It is made const so that it does not alter the operands.
+	//Implicitly the left hand operand is passed as const Fraction *const this to the function.
+	//EXplicitly the right hand operand is passed to the function as const reference.
+	//It takes the argument of type Fraction as const reference to avoid the overhead of copying and to forbid any changes to the operand.
+	//It returns by boolean value true if the left operand is greater than the right operand else false.
+	//F1>F2 <-------> F1.operator>(F2)
+	constexpr bool operator>(const BasicFraction&) const noexcept;
+
+	//The overloaded greater than or equal to operator is a public member function.
+	//It is made const so that it does not alter the operands.
+	//Implicitly the left hand operand is passed as const Fraction *const this to the function.
+	//EXplicitly the right hand operand is passed to the function as const reference.
+	//It takes the argument of type Fraction as const reference to avoid the overhead of copying and to forbid any changes to the operand.
+	//It returns by boolean value true if the left operand is greater than or equal to the right operand else false.
+	//F1>=F2 <-------> F1.operator>=(F2)
+	constexpr bool operator>=(const BasicFraction&) const noexcept;
+
+	//Special Operators
+
+	//The overloaded not operator is a public member function.
+	//It is made const so that it does not alter the operands.
+	//Implicitly the left hand operand is passed as const Fraction *const this to the function.
+	//It returns by value the reciprocal of the Fraction because it creates a new Fraction object and stores the reciprocal in it.
+	//If F1=0 then, it throws std::runtime_error, and std::overflow_error if the reciprocal does not fit. checkedInverse() reports both without an exception.
+	//!F1 <-------> F1.operator!()
+	constexpr BasicFraction operator!() const;
+
+	//Input/Output Operators
+
+	//The overloaded insertion operator is a friend to the Fraction class.
+	//It takes two arguments.
+	//First is a reference to the output stream to print the Fraction to the same stream and not to a copy of it.
+	//Second type is Fraction as const reference to avoid the overhead of copying and to forbid any changes to the operand.
+	//It returns by reference the same output stream to facilitate chaining.
+	//std::cout << F1 <------> operator<<(cout,F1)
+	friend std::ostream& operator<<(std::ostream &OUT,const BasicFraction &rhs)
+	{
+		if(rhs.q==1)
+		{
+			writeInteger(OUT,rhs.p);
+			return OUT;
+		}
+		writeInteger(OUT,rhs.p);
+		OUT << " / ";
+		writeInteger(OUT,rhs.q);
+		return OUT;
+	}
+
+	//The overloaded extraction operator is a friend to the Fraction class.
+	//It takes two arguments.
+	//First is a reference to the input stream to obtain the parameters for the construction of the Fraction object.
+	//Second type is Fraction as reference because changes are to be made to the actual parameter.
+	//It returns by reference the same input stream to facilitate chaining.
+	//It reads the form written by the insertion operator, "p / q" or "p" for an integer, with or without the spaces around the slash.
+	//The terms are read as magnitudes in UWide, so every denominator that operator<< writes reads back.
+	//A zero denominator or a value that does not fit sets the failbit of the stream and leaves the Fraction unchanged.
+	//std::cin >> F1 <------> operator>>(cin,F1)
+	friend std::istream& operator>>(std::istream &IN,BasicFraction &rhs)
+	{
+		bool mNegative=false,nNegative=false;
+		UWide m=0,n=1;
+		readInteger(IN,mNegative,m);
+		if(!IN)
+		{
+			return IN;
+		}
+		//An integer that ends the stream is complete: skipping the trailing spaces must not fail the extraction.
+		IN >> std::ws;
+		if(IN.eof())
+		{
+			IN.clear(std::ios::eofbit);
+		}
+		else if(IN.peek()=='/')
+		{
+			IN.get();
+			readInteger(IN,nNegative,n);
+		}
+		if(IN && n==0)
+		{
+			IN.setstate(std::ios::failbit);
+		}
+		if(IN)
+		{
+			BasicCheckedFraction<IntT> r=reduce(mNegative!=nNegative,m,n);
+			if(r.ok())
+			{
+				rhs=r.value;
+			}
+			else
+			{
+				IN.setstate(std::ios::failbit);
+			}
+		}
+		return IN;
+	}
+};
+
+//BasicCheckedFraction is returned by value from the checked arithmetic functions.
+//The value is only meaningful when status is eFractionOk; a failed operation stores 0/1.
+//It reads like std::expected<BasicFraction<IntT>,FractionStatus>: has_value(), the conversion to bool, error() and value_or().
+template<typename IntT>
+struct BasicCheckedFraction
+{
+	BasicFraction<IntT> value;
+	FractionStatus status;
+
+	constexpr bool ok() const noexcept {return status==eFractionOk;}
+	constexpr bool has_value() const noexcept {return status==eFractionOk;}
+	constexpr explicit operator bool() const noexcept {return status==eFractionOk;}
+	constexpr FractionStatus error() const noexcept {return status;}
+
+	//value_or(F) returns the value, or F if the operation failed.
+	constexpr BasicFraction<IntT> value_or(const BasicFraction<IntT>& fallback) const noexcept {return status==eFractionOk ? value : fallback;}
+};
+
+//FractionStickyStatus collects the statuses of a sequence of checked operations, like the status flags of floating point arithmetic.
+//It keeps the first failure and passes the values through, so a loop tests nothing per element and checks once at the end:
+//FractionStickyStatus s; for(...) sum=s(checkedAdd(sum,x[i])); if(!s.ok()) ...
+//After a failure the value is 0/1 like the value of the failed operation, as in the batch kernels of FractionVector.
+struct FractionStickyStatus
+{
+	FractionStatus status=eFractionOk;
+
+	template<typename IntT>
+	constexpr BasicFraction<IntT> operator()(const BasicCheckedFraction<IntT>& r) noexcept
+	{
+		status=(status==eFractionOk) ? r.status : status;
+		return r.value;
+	}
+
+	//merge(s) records a status returned by a batch kernel.
+	constexpr void merge(FractionStatus s) noexcept {status=(status==eFractionOk) ? s : status;}
+
+	constexpr bool ok() const noexcept {return status==eFractionOk;}
+	constexpr void clear() noexcept {status=eFractionOk;}
+};
+
+//BasicFractionDivMod is returned by value from divmod().
+//The quotient is an integer valued Fraction.
+template<typename IntT>
+struct BasicFractionDivMod
+{
+	BasicFraction<IntT> quotient;
+	BasicFraction<IntT> remainder;
+};
+
+//Unity Constant
+template<typename IntT>
+constexpr BasicFraction<IntT> BasicFraction<IntT>::sc_fUnity=BasicFraction<IntT>();
+
+//Zero Constant
+template<typename IntT>
+constexpr BasicFraction<IntT> BasicFraction<IntT>::sc_fZero=BasicFraction<IntT>(0);
+
+
+//Normalizes the fraction to its proper form.
+template<typename IntT>
+constexpr void BasicFraction<IntT>::normalize()
+{
+	FRACTION_STATS_RECORD(normalization());
+	if(this->p==0)
+	{
+		this->q=1;
+	}
+	else
+	{
+		Unsigned GCD=gcd(magnitude(this->p),this->q);
+		if(GCD!=1)
+		{
+			Unsigned m=magnitude(this->p)/GCD;
+			this->p=(this->p<0) ? static_cast<IntT>(0-m) : static_cast<IntT>(m);
+			this->q=this->q/GCD;
+		}
+	}
+}
+
+//Constructor with a pair of integer values for the numerator and denominator properly defaulted
+template<typename IntT>
+constexpr BasicFraction<IntT>::BasicFraction(IntT m,IntT n)
+: p(m),q(magnitude(n))
+{
+	if(n==0) //The fraction is undefined
+	{
+		fail(eFractionDivideByZero);
+	}
+	if(n<0)
+	{
+		//The most negative numerator has no opposite. make() reduces first, so e.g. INT_MIN/-2 is built and INT_MIN/-1 throws std::overflow_error.
+		if(m==std::numeric_limits<IntT>::min())
+		{
+			*this=value(make(m,n));
+			return;
+		}
+		this->p=static_cast<IntT>(0-m);
+	}
+	FRACTION_STATS_RECORD(count(FractionStats::eConstruct));
+	this->normalize();
+}
+
+//Checked Construction
+//The sign and the magnitudes are separated first, so the most negative numerator or denominator cannot wrap.
+template<typename IntT>
+constexpr BasicCheckedFraction<IntT> BasicFraction<IntT>::make(IntT m,IntT n) noexcept
+{
+	FRACTION_STATS_RECORD(count(FractionStats::eConstruct));
+	if(n==0)
+	{
+		return divideByZero();
+	}
+	if(m==0)
+	{
+		BasicCheckedFraction<IntT> r={BasicFraction(0,1,Reduced()),eFractionOk};
+		return r;
+	}
+	Unsigned a=magnitude(m),b=magnitude(n);
+	Unsigned g=gcd(a,b);
+	return fit((m<0)!=(n<0),a/g,b/g);
+}
+
+//Converting a binary floating point value
+//The magnitude m*2^e is first tried as an exact Fraction: an integer, or the odd mantissa over a power of two denominator.
+//Otherwise the continued fraction expansion of the exact value n/d=m/2^k is walked while the convergents p1/q1 fit in the bounds.
+//When the next convergent would exceed a bound, the best candidates are the convergent p1/q1 and the largest semiconvergent (p0+j*p1)/(q0+j*q1).
+//With the complete quotient x=n/d left over, p1/q1 is at least as close as the semiconvergent exactly when x>=2j+q0/q1.
+template<typename IntT>
+BasicFraction<IntT> BasicFraction<IntT>::fromBinary(bool negative,std::uint64_t m,int e,Unsigned maxDenominator)
+{
+	if(maxDenominator==0)
+	{
+		throw std::invalid_argument("Fraction: the largest denominator must be positive");
+	}
+	if(m==0)
+	{
+		return BasicFraction(0,1,Reduced());
+	}
+	Unsigned largest=static_cast<Unsigned>(maxNumerator()+negative);
+	int zeros=FractionGCD::countTrailingZeros(static_cast<unsigned long long>(m));
+	m>>=zeros;
+	e+=zeros;
+	const int bits=static_cast<int>(8*sizeof(Unsigned));
+	if(e>=0)
+	{
+		//An integer: m*2^e.
+		if(e>=bits || (static_cast<Unsigned>(m)!=m) || ((static_cast<Unsigned>(m)<<e)>>e)!=m || (static_cast<Unsigned>(m)<<e)>largest)
+		{
+			throw std::overflow_error("Math error: Fraction overflow\n");
+		}
+		Unsigned v=static_cast<Unsigned>(m)<<e;
+		return BasicFraction(negative ? static_cast<IntT>(0-v) : static_cast<IntT>(v),1,Reduced());
+	}
+	int k=-e;
+	if(k<bits && m<=largest && (static_cast<Unsigned>(1)<<k)<=maxDenominator)
+	{
+		//The odd mantissa over 2^k is already in lowest terms.
+		return BasicFraction(negative ? static_cast<IntT>(0-static_cast<Unsigned>(m)) : static_cast<IntT>(m),static_cast<Unsigned>(1)<<k,Reduced());
+	}
+	//Values below 2^-(limit-64) lose their lowest mantissa bits, which cannot change a best approximation with denominators below 2^64.
+	const int limit=static_cast<int>(8*sizeof(Exact))-2;
+	if(k>limit)
+	{
+		m=(k-limit<64) ? (m>>(k-limit)) : 0;
+		k=limit;
+		if(m==0)
+		{
+			return BasicFraction(0,1,Reduced());
+		}
+	}
+	if(sizeof(Unsigned)<=sizeof(std::uint64_t) && k<64)
+	{
+		return continuedFraction<std::uint64_t>(negative,m,static_cast<std::uint64_t>(1)<<k,largest,maxDenominator);
+	}
+	return continuedFraction<Exact>(negative,m,static_cast<Exact>(1)<<k,largest,maxDenominator);
+}
+
+template<typename IntT>
+template<typename W>
+BasicFraction<IntT> BasicFraction<IntT>::continuedFraction(bool negative,W n,W d,W largest,W maxDenominator)
+{
+	if(quotient(n,d)>largest)
+	{
+		throw std::overflow_error("Math error: Fraction overflow\n");
+	}
+	W p0=0,q0=1,p1=1,q1=0;
+	bool exact=false;
+	for(;;)
+	{
+		W a=quotient(n,d),p2=0,q2=0;
+		if(__builtin_mul_overflow(a,p1,&p2) || __builtin_add_overflow(p2,p0,&p2) || p2>largest
+			|| __builtin_mul_overflow(a,q1,&q2) || __builtin_add_overflow(q2,q0,&q2) || q2>maxDenominator)
+		{
+			break;
+		}
+		p0=p1;
+		q0=q1;
+		p1=p2;
+		q1=q2;
+		W r=n-a*d;
+		n=d;
+		d=r;
+		if(d==0)
+		{
+			exact=true;
+			break;
+		}
+	}
+	W p=p1,q=q1;
+	if(!exact)
+	{
+		//j is the largest multiple of the last convergent that keeps the semiconvergent within both bounds.
+		//The semiconvergent with j=0 is the previous convergent, which does not exist before the first step (q0=0).
+		W j=quotient<W>(maxDenominator-q0,q1);
+		if(p1!=0 && quotient<W>(largest-p0,p1)<j)
+			j=quotient<W>(largest-p0,p1);
+		if(j!=0 || q0!=0)
+		{
+			W a=quotient(n,d);
+			bool convergent;
+			if(a-j>j)
+				convergent=true;
+			else if(a-j<j)
+				convergent=false;
+			else
+				convergent=FractionGCD::compareRatios<W>(n-a*d,d,q0,q1)>=0;
+			if(!convergent)
+			{
+				p=p0+j*p1;
+				q=q0+j*q1;
+			}
+		}
+	}
+	Unsigned u=static_cast<Unsigned>(p);
+	return BasicFraction(negative ? static_cast<IntT>(0-u) : static_cast<IntT>(u),static_cast<Unsigned>(q),Reduced());
+}
+
+//Parsing a decimal string
+//The integer digits are accumulated with the checked operators, each non zero fractional digit d at position k adds d/10^k, and the exponent multiplies or divides by 10.
+//Every step is exact and reports an overflow by the exception of the operator, which makes it a compile error in a constant expression.
+template<typename IntT>
+constexpr BasicFraction<IntT> BasicFraction<IntT>::fromDecimal(const char* text)
+{
+	const char* s=text;
+	bool negative=(*s=='-');
+	if(*s=='-' || *s=='+')
+		s++;
+	BasicFraction r(0),ten(10);
+	Unsigned scale=1;
+	bool fraction=false,digits=false,scaleOverflow=false;
+	for(;*s!=0 && *s!='e' && *s!='E';s++)
+	{
+		if(*s=='\'')
+			continue;
+		if(*s=='.' && !fraction)
+		{
+			fraction=true;
+			continue;
+		}
+		if(*s<'0' || *s>'9')
+		{
+			throw std::invalid_argument("Fraction: not a decimal number");
+		}
+		IntT d=static_cast<IntT>(*s-'0');
+		digits=true;
+		if(!fraction)
+		{
+			r=r*ten+BasicFraction(d);
+			continue;
+		}
+		scaleOverflow=scaleOverflow || __builtin_mul_overflow(scale,static_cast<Unsigned>(10),&scale);
+		if(d!=0)
+		{
+			if(scaleOverflow || scale>maxNumerator())
+			{
+				throw std::overflow_error("Math error: Fraction overflow\n");
+			}
+			r=r+BasicFraction(d,static_cast<IntT>(scale));
+		}
+	}
+	if(!digits)
+	{
+		throw std::invalid_argument("Fraction: not a decimal number");
+	}
+	if(*s=='e' || *s=='E')
+	{
+		s++;
+		bool down=(*s=='-');
+		if(*s=='-' || *s=='+')
+			s++;
+		if(*s==0)
+		{
+			throw std::invalid_argument("Fraction: not a decimal number");
+		}
+		int exponent=0;
+		for(;*s!=0;s++)
+		{
+			if(*s<'0' || *s>'9' || exponent>1000)
+			{
+				throw std::invalid_argument("Fraction: not a decimal number");
+			}
+			exponent=exponent*10+(*s-'0');
+		}
+		for(int i=0;i<exponent && r.p!=0;i++)
+		{
+			r=down ? r/ten : r*ten;
+		}
+	}
+	return negative ? -r : r;
+}
+
+//Writing and reading text
+
+template<typename IntT>
+constexpr char* BasicFraction<IntT>::writeDigits(char* end,Unsigned x)
+{
+	const char* pairs="00010203040506070809101112131415161718192021222324252627282930313233343536373839404142434445464748495051525354555657585960616263646566676869707172737475767778798081828384858687888990919293949596979899";
+	while(x>=100)
+	{
+		unsigned k=static_cast<unsigned>(x%100)*2;
+		x/=100;
+		*--end=pairs[k+1];
+		*--end=pairs[k];
+	}
+	if(x>=10)
+	{
+		unsigned k=static_cast<unsigned>(x)*2;
+		*--end=pairs[k+1];
+		*--end=pairs[k];
+		return end;
+	}
+	*--end=static_cast<char>('0'+static_cast<unsigned>(x));
+	return end;
+}
+
+template<typename IntT>
+constexpr const char* BasicFraction<IntT>::readDigits(const char* s,const char* last,UWide& x,bool& overflow)
+{
+	//The first digits10 digits cannot overflow UWide, so only the rest are checked.
+	const char* safe=(last-s>std::numeric_limits<UWide>::digits10) ? s+std::numeric_limits<UWide>::digits10 : last;
+	if(x==0)
+	{
+		for(;s!=safe && *s>='0' && *s<='9';s++)
+		{
+			x=x*10+static_cast<UWide>(*s-'0');
+		}
+	}
+	for(;s!=last && *s>='0' && *s<='9';s++)
+	{
+		overflow=overflow || __builtin_mul_overflow(x,static_cast<UWide>(10),&x) || __builtin_add_overflow(x,static_cast<UWide>(*s-'0'),&x);
+	}
+	return s;
+}
+
+//The text is formed backwards in a local buffer, which holds the 39 digits of a 128 bit term twice, the sign and the slash.
+template<typename IntT>
+constexpr std::to_chars_result BasicFraction<IntT>::toChars(char* first,char* last) const
+{
+	char buffer[2*40+2]={};
+	char* end=buffer+sizeof(buffer);
+	char* begin=end;
+	if(q!=1)
+	{
+		begin=writeDigits(begin,q);
+		*--begin='/';
+	}
+	begin=writeDigits(begin,magnitude(p));
+	if(p<0)
+	{
+		*--begin='-';
+	}
+	std::size_t n=static_cast<std::size_t>(end-begin);
+	if(static_cast<std::size_t>(last-first)<n)
+	{
+		return std::to_chars_result{last,std::errc::value_too_large};
+	}
+	for(std::size_t i=0;i<n;i++)
+	{
+		first[i]=begin[i];
+	}
+	return std::to_chars_result{first+n,std::errc()};
+}
+
+//The digits are accumulated in UWide as m*10^scale over den, and reduced by one gcd at the end.
+//Trailing zeros of a decimal fraction are not multiplied into m, so "1.5000000000000000000000" fits as well as "1.5".
+template<typename IntT>
+constexpr std::from_chars_result BasicFraction<IntT>::fromChars(const char* first,const char* last,BasicFraction& value)
+{
+	const char* s=first;
+	bool negative=(s!=last && *s=='-');
+	if(negative)
+		s++;
+	UWide m=0,den=1;
+	bool overflow=false,decimal=false;
+	int scale=0;
+	const char* digits=s;
+	s=readDigits(s,last,m,overflow);
+	bool integral=(s!=digits);
+	if(s!=last && *s=='.')
+	{
+		const char* f=s+1;
+		int zeros=0;
+		bool any=false;
+		for(;f!=last && *f>='0' && *f<='9';f++)
+		{
+			any=true;
+			if(*f=='0')
+			{
+				zeros++;
+				continue;
+			}
+			for(;zeros>=0;zeros--)
+			{
+				scale--;
+				overflow=overflow || __builtin_mul_overflow(m,static_cast<UWide>(10),&m);
+			}
+			zeros=0;
+			overflow=overflow || __builtin_add_overflow(m,static_cast<UWide>(*f-'0'),&m);
+		}
+		if(integral || any)
+		{
+			s=f;
+			decimal=true;
+		}
+	}
+	if(!integral && !decimal)
+	{
+		return std::from_chars_result{first,std::errc::invalid_argument};
+	}
+	if(s!=last && (*s=='e' || *s=='E'))
+	{
+		const char* e=s+1;
+		bool down=(e!=last && *e=='-');
+		if(e!=last && (*e=='-' || *e=='+'))
+			e++;
+		int exponent=0;
+		const char* exponentDigits=e;
+		for(;e!=last && *e>='0' && *e<='9';e++)
+		{
+			if(exponent<100000)
+				exponent=exponent*10+(*e-'0');
+		}
+		if(e!=exponentDigits)
+		{
+			s=e;
+			scale+=down ? -exponent : exponent;
+			decimal=true;
+		}
+	}
+	if(!decimal)
+	{
+		const char* t=s;
+		while(t!=last && *t==' ')
+			t++;
+		if(t!=last && *t=='/')
+		{
+			t++;
+			while(t!=last && *t==' ')
+				t++;
+			UWide n=0;
+			const char* denominatorDigits=t;
+			bool denominatorOverflow=false;
+			t=readDigits(t,last,n,denominatorOverflow);
+			if(t!=denominatorDigits)
+			{
+				if(!denominatorOverflow && n==0)
+				{
+					return std::from_chars_result{first,std::errc::invalid_argument};
+				}
+				s=t;
+				den=n;
+				overflow=overflow || denominatorOverflow;
+			}
+		}
+	}
+	if(overflow)
+	{
+		return std::from_chars_result{s,std::errc::result_out_of_range};
+	}
+	if(m==0)
+	{
+		value=BasicFraction(0,1,Reduced());
+		return std::from_chars_result{s,std::errc()};
+	}
+	for(;scale<0 && m%10==0;scale++)
+		m/=10;
+	for(;scale>0;scale--)
+	{
+		if(__builtin_mul_overflow(m,static_cast<UWide>(10),&m))
+			return std::from_chars_result{s,std::errc::result_out_of_range};
+	}
+	for(;scale<0;scale++)
+	{
+		if(__builtin_mul_overflow(den,static_cast<UWide>(10),&den))
+			return std::from_chars_result{s,std::errc::result_out_of_range};
+	}
+	BasicCheckedFraction<IntT> r=reduce(negative,m,den);
+	if(r.status!=eFractionOk)
+	{
+		return std::from_chars_result{s,std::errc::result_out_of_range};
+	}
+	value=r.value;
+	return std::from_chars_result{s,std::errc()};
+}
+
+//Unary Minus Operator
+//The negation of a normalized Fraction is normalized, so no gcd is needed.
+//Only the most negative numerator has no opposite: like 0-F1, it throws std::overflow_error.
+template<typename IntT>
+constexpr BasicFraction<IntT> BasicFraction<IntT>::operator-() const
+{
+	if(__builtin_expect(this->p==std::numeric_limits<IntT>::min(),0))
+	{
+		fail(eFractionOverflow);
+	}
+	return(BasicFraction(static_cast<IntT>(0-this->p),this->q,Reduced()));
+}
+
+//Unary Plus Operator
+template<typename IntT>
+constexpr BasicFraction<IntT> BasicFraction<IntT>::operator+() const
+{
+	return(*this);
+}
+
+//Prefix Pre-Decrement Operator for dividendo
+//gcd(p-q,q)=gcd(p,q)=1, so the result stays normalized: one subtraction, no gcd.
+//Like F1-1, it throws std::overflow_error if the numerator does not fit, and leaves the operand unchanged.
+template<typename IntT>
+constexpr BasicFraction<IntT> BasicFraction<IntT>::operator--()
+{
+	IntT m=0;
+	if(__builtin_expect(__builtin_sub_overflow(this->p,this->q,&m),0))
+	{
+		fail(eFractionOverflow);
+	}
+	this->p=m;
+	return(BasicFraction(*this));
+}
+
+//Postfix Post-Decrement Operator for lazy dividendo
+template<typename IntT>
+constexpr BasicFraction<IntT> BasicFraction<IntT>::operator--(int)
+{
+	BasicFraction temp(*this);
+	--(*this);
+	return(temp);
+}
+
+//Prefix Pre-Increment Operator for componendo
+//gcd(p+q,q)=gcd(p,q)=1, so the result stays normalized: one addition, no gcd.
+//Like F1+1, it throws std::overflow_error if the numerator does not fit, and leaves the operand unchanged.
+template<typename IntT>
+constexpr BasicFraction<IntT> BasicFraction<IntT>::operator++()
+{
+	IntT m=0;
+	if(__builtin_expect(__builtin_add_overflow(this->p,this->q,&m),0))
+	{
+		fail(eFractionOverflow);
+	}
+	this->p=m;
+	return(BasicFraction(*this));
+}
+
+//Postfix Post-Increment Operator for lazy componendo
+template<typename IntT>
+constexpr BasicFraction<IntT> BasicFraction<IntT>::operator++(int)
+{
+	BasicFraction temp(*this);
+	++(*this);
+	return(temp);
+}
+
+//Checked Result
+template<typename IntT>
+constexpr BasicCheckedFraction<IntT> BasicFraction<IntT>::fit(bool negative,UWide num,UWide den) noexcept
+{
+	UWide limit=static_cast<UWide>(maxNumerator())+(negative ? 1 : 0);
+	if(num>limit || den>maxUnsigned())
+	{
+		return overflow();
+	}
+	FRACTION_STATS_RECORD(result(den,num>limit/2 || den>maxUnsigned()/2));
+	IntT m=negative ? static_cast<IntT>(0-static_cast<Unsigned>(num)) : static_cast<IntT>(num);
+	BasicCheckedFraction<IntT> r={BasicFraction(m,static_cast<Unsigned>(den),Reduced()),eFractionOk};
+	return r;
+}
+
+//Terms that fit in Unsigned, as the ones of a normalized "p/q", are reduced by the faster gcd of that width.
+template<typename IntT>
+constexpr BasicCheckedFraction<IntT> BasicFraction<IntT>::reduce(bool negative,UWide num,UWide den) noexcept
+{
+	UWide g=(num<=maxUnsigned() && den<=maxUnsigned()) ? gcd(static_cast<Unsigned>(num),static_cast<Unsigned>(den)) : FractionGCD::gcd<UWide>(num,den);
+	return fit(negative,num/g,den/g);
+}
+
+template<typename IntT>
+constexpr BasicCheckedFraction<IntT> BasicFraction<IntT>::overflow() noexcept
+{
+	FRACTION_STATS_RECORD(overflow());
+	BasicCheckedFraction<IntT> r={BasicFraction(0,1,Reduced()),eFractionOverflow};
+	return r;
+}
+
+template<typename IntT>
+constexpr BasicCheckedFraction<IntT> BasicFraction<IntT>::divideByZero() noexcept
+{
+	BasicCheckedFraction<IntT> r={BasicFraction(0,1,Reduced()),eFractionDivideByZero};
+	return r;
+}
+
+template<typename IntT>
+constexpr BasicFraction<IntT> BasicFraction<IntT>::value(const BasicCheckedFraction<IntT>& r)
+{
+	if(__builtin_expect(r.status!=eFractionOk,0))
+	{
+		fail(r.status);
+	}
+	return r.value;
+}
+
+template<typename IntT>
+void BasicFraction<IntT>::fail(FractionStatus status)
+{
+	if(status==eFractionDivideByZero)
+	{
+		throw std::runtime_error("Math error: Attempted to divide by Zero\n");
+	}
+	throw std::overflow_error("Math error: Fraction overflow\n");
+}
+
+//Adding or subtracting two Fractions
+
+//With g=gcd(b,d), the sum a/b+c/d is t/(b/g*d) where t=a*(d/g)+c*(b/g), and only gcd(t,g) can still be cancelled (Knuth, TAOCP 4.5.1).
+//Every term fits in Wide, so an overflow of the sum already implies that the result does not fit.
+template<typename IntT>
+constexpr BasicCheckedFraction<IntT> BasicFraction<IntT>::addSub(const BasicFraction& lhs,const BasicFraction& rhs,bool subtract) noexcept
+{
+	FRACTION_STATS_RECORD(count(subtract ? FractionStats::eSub : FractionStats::eAdd));
+	Unsigned b=lhs.q,d=rhs.q;
+	Unsigned g=gcd(b,d);
+	Wide x=0,y=0,t=0;
+	if(__builtin_mul_overflow(static_cast<Wide>(lhs.p),d/g,&x) ||
+		__builtin_mul_overflow(static_cast<Wide>(rhs.p),b/g,&y) ||
+		(subtract ? __builtin_sub_overflow(x,y,&t) : __builtin_add_overflow(x,y,&t)))
+	{
+		return overflow();
+	}
+	if(t==0)
+	{
+		BasicCheckedFraction<IntT> r={BasicFraction(0,1,Reduced()),eFractionOk};
+		return r;
+	}
+	UWide den=0;
+	if(g==1)
+	{
+		if(__builtin_mul_overflow(static_cast<UWide>(b),d,&den))
+		{
+			return overflow();
+		}
+		return fit(t<0,magnitudeWide(t),den);
+	}
+	UWide g2=FractionGCD::gcd<UWide>(magnitudeWide(t),g);
+	if(__builtin_mul_overflow(static_cast<UWide>(b/g),d/g2,&den))
+	{
+		return overflow();
+	}
+	return fit(t<0,magnitudeWide(t)/g2,den);
+}
+
+//Multiplying two Fractions
+
+//When the plain products fit in Unsigned they are reduced by a single gcd of that width.
+//Otherwise the numerator of each operand is cancelled against the denominator of the other before multiplying, which leaves the product in lowest terms.
+template<typename IntT>
+constexpr BasicCheckedFraction<IntT> BasicFraction<IntT>::mul(const BasicFraction& lhs,const BasicFraction& rhs) noexcept
+{
+	FRACTION_STATS_RECORD(count(FractionStats::eMul));
+	if(lhs.p==0 || rhs.p==0)
+	{
+		BasicCheckedFraction<IntT> r={BasicFraction(0,1,Reduced()),eFractionOk};
+		return r;
+	}
+	bool negative=(lhs.p<0)!=(rhs.p<0);
+	Unsigned a=magnitude(lhs.p),c=magnitude(rhs.p);
+	UWide num=0,den=0;
+	if(!__builtin_mul_overflow(static_cast<UWide>(a),c,&num) && !__builtin_mul_overflow(static_cast<UWide>(lhs.q),rhs.q,&den) &&
+		num<=maxUnsigned() && den<=maxUnsigned())
+	{
+		Unsigned g=gcd(static_cast<Unsigned>(num),static_cast<Unsigned>(den));
+		return fit(negative,num/g,den/g);
+	}
+	Unsigned g1=gcd(a,rhs.q);
+	Unsigned g2=gcd(c,lhs.q);
+	if(__builtin_mul_overflow(static_cast<UWide>(a/g1),c/g2,&num) || __builtin_mul_overflow(static_cast<UWide>(lhs.q/g2),rhs.q/g1,&den))
+	{
+		return overflow();
+	}
+	return fit(negative,num,den);
+}
+
+//Dividing two Fractions
+
+//The quotient is the product with the reciprocal of the divisor, whose sign is moved to the numerator.
+template<typename IntT>
+constexpr BasicCheckedFraction<IntT> BasicFraction<IntT>::div(const BasicFraction& lhs,const BasicFraction& rhs) noexcept
+{
+	FRACTION_STATS_RECORD(count(FractionStats::eDiv));
+	if(rhs.p==0)
+	{
+		return divideByZero();
+	}
+	if(lhs.p==0)
+	{
+		BasicCheckedFraction<IntT> r={BasicFraction(0,1,Reduced()),eFractionOk};
+		return r;
+	}
+	bool negative=(lhs.p<0)!=(rhs.p<0);
+	Unsigned a=magnitude(lhs.p),c=magnitude(rhs.p);
+	UWide num=0,den=0;
+	if(!__builtin_mul_overflow(static_cast<UWide>(a),rhs.q,&num) && !__builtin_mul_overflow(static_cast<UWide>(lhs.q),c,&den) &&
+		num<=maxUnsigned() && den<=maxUnsigned())
+	{
+		Unsigned g=gcd(static_cast<Unsigned>(num),static_cast<Unsigned>(den));
+		return fit(negative,num/g,den/g);
+	}
+	Unsigned g1=gcd(a,c);
+	Unsigned g2=gcd(lhs.q,rhs.q);
+	if(__builtin_mul_overflow(static_cast<UWide>(a/g1),rhs.q/g2,&num) || __builtin_mul_overflow(static_cast<UWide>(lhs.q/g2),c/g1,&den))
+	{
+		return overflow();
+	}
+	return fit(negative,num,den);
+}
+
+//Adding or subtracting an integer
+
+//a/b+m is (a+m*b)/b and gcd(a+m*b,b)=gcd(a,b)=1, so the sum is in lowest terms without any gcd.
+//When Wide is twice as wide as IntT, an integer in the range of IntT is added in the signed Wide type, with no branch on the signs.
+//Otherwise the terms are added as signs and magnitudes in UWide, which is exact for any m up to the width of UWide.
+template<typename IntT>
+constexpr BasicCheckedFraction<IntT> BasicFraction<IntT>::addInteger(const BasicFraction& lhs,Integer m,bool subtract,bool reversed) noexcept
+{
+	FRACTION_STATS_RECORD(count(subtract ? FractionStats::eSub : FractionStats::eAdd));
+	if(sizeof(Wide)>sizeof(IntT) && __builtin_expect(m.magnitude<=maxNumerator(),1))
+	{
+		Wide k=m.negative ? -static_cast<Wide>(m.magnitude) : static_cast<Wide>(m.magnitude);
+		Wide x=static_cast<Wide>(lhs.p),y=0,t=0;
+		if(__builtin_mul_overflow(k,lhs.q,&y) ||
+			(subtract ? (reversed ? __builtin_sub_overflow(y,x,&t) : __builtin_sub_overflow(x,y,&t)) : __builtin_add_overflow(x,y,&t)))
+		{
+			return overflow();
+		}
+		return fit(t<0,magnitudeWide(t),lhs.q);
+	}
+	bool sx=reversed ? lhs.p>0 : lhs.p<0;	//Sign of the Fraction term, negated in m-F
+	bool sy=(subtract && !reversed) ? !m.negative : m.negative;	//Sign of the integer term, negated in F-m
+	UWide x=magnitude(lhs.p),y=0,t=0;
+	if(__builtin_mul_overflow(m.magnitude,lhs.q,&y))
+	{
+		return overflow();
+	}
+	bool negative=sx;
+	if(sx==sy)
+	{
+		if(__builtin_add_overflow(x,y,&t))
+		{
+			return overflow();
+		}
+	}
+	else if(x>=y)
+	{
+		t=x-y;
+	}
+	else
+	{
+		t=y-x;
+		negative=sy;
+	}
+	return fit(negative && t!=0,t,lhs.q);
+}
+
+//Multiplying by an integer
+
+//a/b is in lowest terms, so with g=gcd(m,b) the product (a*(m/g))/(b/g) is in lowest terms too.
+template<typename IntT>
+constexpr BasicCheckedFraction<IntT> BasicFraction<IntT>::mulInteger(const BasicFraction& lhs,Integer m) noexcept
+{
+	FRACTION_STATS_RECORD(count(FractionStats::eMul));
+	if(lhs.p==0 || m.magnitude==0)
+	{
+		BasicCheckedFraction<IntT> r={BasicFraction(0,1,Reduced()),eFractionOk};
+		return r;
+	}
+	Unsigned g=(lhs.q==1) ? 1 : gcdInteger(m.magnitude,lhs.q);
+	UWide num=0;
+	if(__builtin_mul_overflow(static_cast<UWide>(magnitude(lhs.p)),m.magnitude/g,&num))
+	{
+		return overflow();
+	}
+	return fit((lhs.p<0)!=m.negative,num,lhs.q/g);
+}
+
+//Dividing by an integer, or an integer by a Fraction
+
+//With g=gcd(a,m), a/b/m is (a/g)/(b*(m/g)) and m/(a/b) is ((m/g)*b)/(a/g), both in lowest terms.
+template<typename IntT>
+constexpr BasicCheckedFraction<IntT> BasicFraction<IntT>::divInteger(const BasicFraction& lhs,Integer m,bool reversed) noexcept
+{
+	FRACTION_STATS_RECORD(count(FractionStats::eDiv));
+	if(reversed ? lhs.p==0 : m.magnitude==0)
+	{
+		return divideByZero();
+	}
+	if(reversed ? m.magnitude==0 : lhs.p==0)
+	{
+		BasicCheckedFraction<IntT> r={BasicFraction(0,1,Reduced()),eFractionOk};
+		return r;
+	}
+	Unsigned a=magnitude(lhs.p);
+	Unsigned g=gcdInteger(m.magnitude,a);
+	UWide scaled=0;	//b*(m/g)
+	if(__builtin_mul_overflow(static_cast<UWide>(lhs.q),m.magnitude/g,&scaled))
+	{
+		return overflow();
+	}
+	bool negative=(lhs.p<0)!=m.negative;
+	return reversed ? fit(negative,scaled,a/g) : fit(negative,a/g,scaled);
+}
+
+//Dividing with remainder
+
+//With g=gcd(b,d), a/b and c/d are x/L and y/L for x=a*(d/g), y=c*(b/g) and L=b/g*d, so the quotient is the one of the integers x/y and the remainder is (x%y)/L.
+//This takes one division and one gcd, whatever the ratio of the operands.
+template<typename IntT>
+constexpr typename BasicFraction<IntT>::Division BasicFraction<IntT>::divide(const BasicFraction& lhs,const BasicFraction& rhs,bool floored) noexcept
+{
+	FRACTION_STATS_RECORD(count(FractionStats::eMod));
+	Division r={eFractionOk,false,0,false,0,0};
+	if(rhs.p==0)
+	{
+		r.status=eFractionDivideByZero;
+		return r;
+	}
+	Unsigned b=lhs.q,d=rhs.q;
+	//If |lhs|<|rhs| the quotient is 0 and the remainder lhs, except for a floored quotient of operands of opposite signs, which is -1.
+	if(compareProducts(magnitude(lhs.p),d,magnitude(rhs.p),b)<0 && !(floored && lhs.p!=0 && (lhs.p<0)!=(rhs.p<0)))
+	{
+		r.remainderNegative=lhs.p<0;
+		r.remainder=magnitude(lhs.p);
+		r.den=b;
+		return r;
+	}
+	Unsigned g=gcd(b,d);
+	Wide x=0,y=0;
+	if(__builtin_mul_overflow(static_cast<Wide>(lhs.p),d/g,&x) || __builtin_mul_overflow(static_cast<Wide>(rhs.p),b/g,&y) || __builtin_mul_overflow(static_cast<UWide>(b/g),d,&r.den))
+	{
+		return divideExact(lhs,rhs,floored,g);
+	}
+	UWide mx=magnitudeWide(x),my=magnitudeWide(y);
+	r.negative=(x<0)!=(y<0);
+	r.quotient=mx/my;
+	r.remainder=mx%my;
+	r.remainderNegative=x<0;
+	//Rounding a negative quotient down moves the remainder to the sign of y.
+	if(floored && r.negative && r.remainder!=0)
+	{
+		r.quotient+=1;
+		r.remainder=my-r.remainder;
+		r.remainderNegative=y<0;
+	}
+	return r;
+}
+
+//The products of 128 bit terms take 256 bits. The quotient saturates at the maximum of UWide, which is too large for any result,
+//and a reduced remainder that does not fit in UWide is stored with den 0, which remainder() reports as an overflow.
+template<typename IntT>
+constexpr typename BasicFraction<IntT>::Division BasicFraction<IntT>::divideExact(const BasicFraction& lhs,const BasicFraction& rhs,bool floored,Unsigned g) noexcept
+{
+	Unsigned b=lhs.q,d=rhs.q;
+	Double x=multiplyDouble(magnitude(lhs.p),d/g);
+	Double y=multiplyDouble(magnitude(rhs.p),b/g);
+	Double rest={0,0};
+	Double quotient=divideDouble(x,y,rest);
+	UWide maximum=~static_cast<UWide>(0);
+	Division r={eFractionOk,(lhs.p<0)!=(rhs.p<0),quotient.high!=0 ? maximum : static_cast<UWide>(quotient.low),lhs.p<0,0,0};
+	if(rest.isZero())
+	{
+		return r;
+	}
+	if(floored && r.negative)
+	{
+		r.quotient+=(r.quotient!=maximum) ? 1 : 0;
+		rest=y-rest;
+		r.remainderNegative=rhs.p<0;
+	}
+	Double den=multiplyDouble(b/g,d);
+	Double common=gcdDouble(rest,den);
+	Double unused={0,0};
+	rest=divideDouble(rest,common,unused);
+	den=divideDouble(den,common,unused);
+	if(rest.high!=0 || den.high!=0)
+	{
+		r.remainder=1;
+		return r;
+	}
+	r.remainder=rest.low;
+	r.den=den.low;
+	return r;
+}
+
+//Schoolbook product of half words.
+template<typename IntT>
+constexpr typename BasicFraction<IntT>::Double BasicFraction<IntT>::multiplyDouble(Unsigned u,Unsigned v) noexcept
+{
+	const int half=Double::sc_nBits/2;
+	Unsigned mask=(static_cast<Unsigned>(1)<<half)-1;
+	Unsigned u0=u&mask,u1=u>>half,v0=v&mask,v1=v>>half;
+	Unsigned p00=u0*v0,p01=u0*v1,p10=u1*v0,p11=u1*v1;
+	Unsigned middle=(p00>>half)+(p01&mask)+(p10&mask);
+	return Double{p11+(p01>>half)+(p10>>half)+(middle>>half),(p00&mask)|(middle<<half)};
+}
+
+template<typename IntT>
+constexpr typename BasicFraction<IntT>::Double BasicFraction<IntT>::divideDouble(Double x,Double y,Double& remainder) noexcept
+{
+	Double quotient={0,0},rest={0,0};
+	for(int i=x.length()-1;i>=0;i--)
+	{
+		rest=rest<<1;
+		rest.low|=x.bit(i) ? 1 : 0;
+		if(!(rest<y))
+		{
+			rest=rest-y;
+			if(i<Double::sc_nBits)
+				quotient.low|=static_cast<Unsigned>(1)<<i;
+			else
+				quotient.high|=static_cast<Unsigned>(1)<<(i-Double::sc_nBits);
+		}
+	}
+	remainder=rest;
+	return quotient;
+}
+
+template<typename IntT>
+constexpr typename BasicFraction<IntT>::Double BasicFraction<IntT>::gcdDouble(Double u,Double v) noexcept
+{
+	if(u.isZero())
+		return v;
+	if(v.isZero())
+		return u;
+	int zu=u.countTrailingZeros(),zv=v.countTrailingZeros();
+	int shift=zu<zv ? zu : zv;
+	u=u>>zu;
+	v=v>>zv;
+	while(!(u==v))
+	{
+		if(u<v)
+		{
+			Double t=u;
+			u=v;
+			v=t;
+		}
+		u=u-v;
+		u=u>>u.countTrailingZeros();
+	}
+	return u<<shift;
+}
+
+template<typename IntT>
+constexpr BasicCheckedFraction<IntT> BasicFraction<IntT>::integer(const Division& r) noexcept
+{
+	if(r.status!=eFractionOk)
+	{
+		BasicCheckedFraction<IntT> failed={BasicFraction(0,1,Reduced()),r.status};
+		return failed;
+	}
+	return fit(r.negative,r.quotient,1);
+}
+
+template<typename IntT>
+constexpr BasicCheckedFraction<IntT> BasicFraction<IntT>::remainder(const Division& r) noexcept
+{
+	if(r.status!=eFractionOk)
+	{
+		BasicCheckedFraction<IntT> failed={BasicFraction(0,1,Reduced()),r.status};
+		return failed;
+	}
+	if(r.remainder==0)
+	{
+		BasicCheckedFraction<IntT> zero={BasicFraction(0,1,Reduced()),eFractionOk};
+		return zero;
+	}
+	if(r.den==0)
+	{
+		return overflow();
+	}
+	UWide g=FractionGCD::gcd<UWide>(r.remainder,r.den);
+	return fit(r.remainderNegative,r.remainder/g,r.den/g);
+}
+
+//Operands are Equal.
+template<typename IntT>
+constexpr bool BasicFraction<IntT>::operator==(const BasicFraction& rhs) const noexcept
+{
+	if((*this).p==rhs.p && (*this).q==rhs.q)
+	{
+		return true;
+	}
+	return false;
+}
+
+//Operands are not equal.
+template<typename IntT>
+constexpr bool BasicFraction<IntT>::operator!=(const BasicFraction& rhs) const noexcept
+{
+	if((*this).p!=rhs.p || (*this).q!=rhs.q)
+	{
+		return true;
+	}
+	return false;
+}
+
+//Sign of a*b-c*d
+template<typename IntT>
+constexpr int BasicFraction<IntT>::compareProducts(Unsigned a,Unsigned b,Unsigned c,Unsigned d) noexcept
+{
+	if constexpr(sizeof(UWide)>sizeof(Unsigned))
+	{
+		UWide x=static_cast<UWide>(a)*b;
+		UWide y=static_cast<UWide>(c)*d;
+		return (x>y)-(x<y);
+	}
+	else
+	{
+		Double x=multiplyDouble(a,b),y=multiplyDouble(c,d);
+		return (y<x)-(x<y);
+	}
+}
+
+//First operand is Less than Second operand
+template<typename IntT>
+constexpr bool BasicFraction<IntT>::operator<(const BasicFraction& rhs) const noexcept
+{
+	return compare(*this,rhs)<0;
+}
+
+//First operand is Less than or Equal to Second operand
+template<typename IntT>
+constexpr bool BasicFraction<IntT>::operator<=(const BasicFraction& rhs) const noexcept
+{
+	return compare(*this,rhs)<=0;
+}
+
+//First operand is More than Second operand
+template<typename IntT>
+constexpr bool BasicFraction<IntT>::operator>(const BasicFraction& rhs) const noexcept
+{
+	return compare(*this,rhs)>0;
+}
+
+//First operand is More than or Equal to Second operand
+template<typename IntT>
+constexpr bool BasicFraction<IntT>::operator>=(const BasicFraction& rhs) const noexcept
+{
+	return compare(*this,rhs)>=0;
+}
+
+//Hash
+//A 32 bit Fraction fits in a single word that is mixed once. Wider terms are mixed word by word.
+template<typename IntT>
+constexpr std::uint64_t BasicFraction<IntT>::hash() const
+{
+	if constexpr(sizeof(Unsigned)<=4)
+	{
+		return mix((static_cast<std::uint64_t>(static_cast<Unsigned>(p))<<32)|q);
+	}
+	else
+	{
+		Unsigned m=static_cast<Unsigned>(p),n=q;
+		std::uint64_t h=0;
+		for(std::size_t i=0;i<sizeof(Unsigned);i+=8)
+		{
+			h=mix(h^static_cast<std::uint64_t>(m));
+			h=mix(h+static_cast<std::uint64_t>(n));
+			m=m>>32>>32;	//Two shifts, since shifting a 64 bit word by 64 is undefined
+			n=n>>32>>32;
+		}
+		return h;
+	}
+}
+
+//Special Operator:Reciprocal
+//The sign of the numerator moves to the new numerator, so no gcd is needed.
+template<typename IntT>
+constexpr BasicFraction<IntT> BasicFraction<IntT>::operator!() const
+{
+	return(value(checkedInverse(*this)));
+}
+
+//std::hash<BasicFraction<IntT> > makes Fractions usable as keys of std::unordered_map and std::unordered_set.
+namespace std
+{
+	template<typename IntT>
+	struct hash<BasicFraction<IntT> >
+	{
+		std::size_t operator()(const BasicFraction<IntT>& f) const {return static_cast<std::size_t>(f.hash());}
+	};
+}
+
+#endif // __BASIC_FRACTION_H__
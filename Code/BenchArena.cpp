@@ -0,0 +1,95 @@
+// File: BenchArena.cpp
+// Contains: void BenchArena()
+/************ C++ Headers ************************************/
+
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <iostream>
+#include <string>
+#include <vector>
+using namespace std;
+
+/************ PROJECT Headers ********************************/
+
+#include "BigFraction.h"
+#include "BigInteger.h"
+#include "Benchmark.h"
+#include "Fraction.h"
+#include "FractionArena.h"
+#include "FractionMatrix.h"
+#include "FractionPolynomial.h"
+
+// Runs one request with the default allocator and then in a FractionArena::Scope per request,
+// and prints the time and the heap allocations of each.
+static void Compare(const string& name, const function<void()>& request, int repetitions) {
+	size_t before = FractionArena::heapAllocations();
+	request();
+	size_t heap = FractionArena::heapAllocations() - before;
+	double h = Benchmark::run(name + ", heap", 1, request, repetitions);
+
+	FractionArena arena;
+	auto scoped = [&]() {
+		FractionArena::Scope scope(arena);
+		request();
+	};
+	scoped();
+	before = FractionArena::heapAllocations();
+	size_t blocks = arena.blocks();
+	scoped();
+	size_t pooled = FractionArena::heapAllocations() - before;
+	blocks = arena.blocks() - blocks;
+	double a = Benchmark::run(name + ", arena", 1, scoped, repetitions);
+	cout << "  heap allocations per request: " << heap << " -> " << pooled << " (" << blocks << " arena blocks in "
+		<< arena.reserved() / 1024 << " KiB), speedup " << h / a << "x" << endl;
+}
+
+void BenchArena() {
+	Benchmark::section("FractionArena: requests with and without an arena per request, ns per request");
+
+	// 4000 products and sums of two to eight limb integers, each freed a step later.
+	Benchmark::Random rng(301);
+	vector<BigInteger> operands;
+	for (int i = 0; i < 64; i++) {
+		BigInteger x = BigInteger::fromMagnitude(rng.next(), false);
+		for (int j = static_cast<int>(rng.range(1, 3)); j > 0; j--)
+			x = x * BigInteger::fromMagnitude(rng.next() | 1, false);
+		operands.push_back(x);
+	}
+	Compare("BigInteger x * y + z, 4000 steps", [&]() {
+		BigInteger s(0);
+		for (size_t i = 0; i < 4000; i++)
+			s = (operands[i % 64] * operands[(i * 7 + 3) % 64] + s) % operands[(i * 13 + 5) % 64];
+		Benchmark::doNotOptimize(s);
+	}, 5);
+
+	// The harmonic number H(300) in BigFractions.
+	Compare("BigFraction sum of 1/k, k <= 300", [&]() {
+		BigFraction h(0);
+		for (long long k = 1; k <= 300; k++)
+			h = h + BigFraction(1, k);
+		Benchmark::doNotOptimize(h);
+	}, 5);
+
+	// A product of polynomials of degree 200 with small coefficients.
+	vector<Fraction> x(201), y(201);
+	for (size_t i = 0; i <= 200; i++) {
+		x[i] = Fraction(static_cast<int>(rng.range(-99, 99)), static_cast<int>(rng.range(1, 9)));
+		y[i] = Fraction(static_cast<int>(rng.range(-99, 99)), static_cast<int>(rng.range(1, 9)));
+	}
+	FractionPolynomial P(x), Q(y);
+	Compare("FractionPolynomial product, degree 200", [&]() {
+		Benchmark::doNotOptimize((P * Q).degree());
+	}, 5);
+
+	// The determinant of a 30 x 30 matrix whose minors need BigIntegers.
+	FractionMatrix A(30, 30);
+	for (size_t i = 0; i < 30; i++)
+		for (size_t j = 0; j < 30; j++)
+			A(i, j) = Fraction(static_cast<int>(rng.range(-1000000, 1000000)), static_cast<int>(rng.range(1, 1000)));
+	Compare("FractionMatrix determinant, 30 x 30", [&]() {
+		Benchmark::doNotOptimize(A.determinant());
+	}, 3);
+	return;
+}
+// End-of-File: BenchArena.cpp
@@ -0,0 +1,229 @@
+// File: BenchArithmetic.cpp
+// Contains: void BenchArithmetic()
+/************ C++ Headers ************************************/
+
+#include <cstdint>
+#include <iostream>
+#include <vector>
+using namespace std;
+
+/************ PROJECT Headers ********************************/
+
+#include "Benchmark.h"
+#include "Fraction.h"
+#include "LazyFraction.h"
+
+// Number of operand pairs in every dataset
+static const size_t sc_nOperands = 1 << 16;
+
+// Fractions whose numerator and denominator are below 2^bits.
+// With bits <= 15 no product of the unchecked formulas overflows, so both implementations compute the same values.
+static vector<Fraction> RandomFractions(int bits, uint64_t seed) {
+	Benchmark::Random rng(seed);
+	vector<Fraction> v;
+	v.reserve(sc_nOperands);
+	for (size_t i = 0; i < sc_nOperands; i++) {
+		int p = static_cast<int>(rng.range(-(1 << bits) + 1, (1 << bits) - 1));
+		int q = static_cast<int>(rng.range(1, (1 << bits) - 1));
+		v.push_back(Fraction(p, q));
+	}
+	return v;
+}
+
+// The operators as they were before cross-cancellation: plain int products followed by a full normalize().
+// They wrap silently when a product does not fit in an int.
+static Fraction UncheckedAdd(const Fraction& a, const Fraction& b) {
+	return Fraction(a.numerator() * static_cast<int>(b.denominator()) + static_cast<int>(a.denominator()) * b.numerator(),
+		static_cast<int>(a.denominator() * b.denominator()));
+}
+
+static Fraction UncheckedMul(const Fraction& a, const Fraction& b) {
+	return Fraction(a.numerator() * b.numerator(), static_cast<int>(a.denominator() * b.denominator()));
+}
+
+static Fraction UncheckedDiv(const Fraction& a, const Fraction& b) {
+	int p = a.numerator() * static_cast<int>(b.denominator());
+	int q = static_cast<int>(a.denominator()) * b.numerator();
+	return (q < 0) ? Fraction(-p, -q) : Fraction(p, q);
+}
+
+// The operator% as it was before the exact remainder: repeated subtraction of doubles, O(a/b) iterations.
+static Fraction SubtractionMod(const Fraction& a, const Fraction& b) {
+	double x = static_cast<double>(a.numerator()) / a.denominator();
+	double y = static_cast<double>(b.numerator()) / b.denominator();
+	double mod = x < 0 ? -x : x;
+	if (y < 0)
+		y = -y;
+	while (mod >= y)
+		mod = mod - y;
+	return Fraction(x < 0 ? -mod : mod);
+}
+
+// Dividends about ratio times larger than the divisors, for the modulo benchmark.
+static void ModOperands(int64_t ratio, size_t n, uint64_t seed, vector<Fraction>& x, vector<Fraction>& y) {
+	Benchmark::Random rng(seed);
+	x.clear();
+	y.clear();
+	for (size_t i = 0; i < n; i++) {
+		int64_t q = rng.range(2, 999);
+		y.push_back(Fraction(1, static_cast<int>(q)));
+		x.push_back(Fraction(static_cast<int>(rng.range(ratio / 2, ratio)), static_cast<int>(q + rng.range(-1, 1))));
+	}
+}
+
+template<typename Op>
+static double Measure(const string& name, const vector<Fraction>& x, const vector<Fraction>& y, Op op) {
+	return Benchmark::run(name, x.size(), [&]() {
+		for (size_t i = 0; i < x.size(); i++)
+			Benchmark::doNotOptimize(op(x[i], y[i]));
+	});
+}
+
+static void Compare(const string& name, double unchecked, double checked) {
+	cout << "  " << name << " slowdown of the overflow-safe operator: "
+		<< (checked / unchecked - 1) * 100 << " %" << endl;
+}
+
+// Sums and products over an array of one Fraction width.
+// The same 15 bit values are used for every width so that only the width of the arithmetic differs.
+template<typename F>
+static void MeasureWidth(const string& name, uint64_t seed) {
+	Benchmark::Random rng(seed);
+	vector<F> x, y;
+	for (size_t i = 0; i < sc_nOperands; i++) {
+		x.push_back(F(rng.range(-32767, 32767), rng.range(1, 32767)));
+		y.push_back(F(rng.range(-32767, 32767), rng.range(1, 32767)));
+	}
+	cout << "  sizeof(" << name << ") = " << sizeof(F) << " bytes" << endl;
+	Benchmark::run(name + " construction", x.size(), [&]() {
+		for (size_t i = 0; i < x.size(); i++)
+			Benchmark::doNotOptimize(F(x[i].numerator(), static_cast<typename F::Unsigned>(y[i].denominator())));
+	});
+	Benchmark::run(name + " operator+", x.size(), [&]() {
+		for (size_t i = 0; i < x.size(); i++)
+			Benchmark::doNotOptimize(x[i] + y[i]);
+	});
+	Benchmark::run(name + " operator*", x.size(), [&]() {
+		for (size_t i = 0; i < x.size(); i++)
+			Benchmark::doNotOptimize(x[i] * y[i]);
+	});
+}
+
+// The chain a*b+c*d-e over consecutive elements, evaluated with eager Fractions and with one LazyFraction reduction at the end.
+static void MeasureChain(const string& name, const vector<Fraction>& x) {
+	size_t n = x.size() - 4;
+	double e = Benchmark::run(name + ", Fraction", n, [&]() {
+		for (size_t i = 0; i < n; i++)
+			Benchmark::doNotOptimize(x[i] * x[i + 1] + x[i + 2] * x[i + 3] - x[i + 4]);
+	});
+	double l = Benchmark::run(name + ", LazyFraction", n, [&]() {
+		for (size_t i = 0; i < n; i++)
+			Benchmark::doNotOptimize((LazyFraction(x[i]) * x[i + 1] + LazyFraction(x[i + 2]) * x[i + 3] - x[i + 4]).toFraction());
+	});
+	cout << "  speedup of lazy normalization: " << e / l << "x" << endl;
+}
+
+// Integers in [-1000, 1000] without 0, the second operands of the integer benchmarks.
+static vector<int> RandomIntegers(uint64_t seed) {
+	Benchmark::Random rng(seed);
+	vector<int> v;
+	v.reserve(sc_nOperands);
+	for (size_t i = 0; i < sc_nOperands; i++) {
+		int k = static_cast<int>(rng.range(-1000, 999));
+		v.push_back(k >= 0 ? k + 1 : k);
+	}
+	return v;
+}
+
+// F op k with the integer overload, against F op Fraction(k), the path of the implicit conversion.
+template<typename Op>
+static void MeasureInteger(const string& name, const vector<Fraction>& x, const vector<int>& k, Op op) {
+	double c = Benchmark::run(name + " Fraction(k)", x.size(), [&]() {
+		for (size_t i = 0; i < x.size(); i++)
+			Benchmark::doNotOptimize(op(x[i], Fraction(k[i])));
+	});
+	double f = Benchmark::run(name + " k", x.size(), [&]() {
+		for (size_t i = 0; i < x.size(); i++)
+			Benchmark::doNotOptimize(op(x[i], k[i]));
+	});
+	cout << "  speedup of the integer operand: " << c / f << "x" << endl;
+}
+
+void BenchArithmetic() {
+	Benchmark::section("Arithmetic operators: non-overflowing fast path");
+	vector<Fraction> x = RandomFractions(15, 1), y = RandomFractions(15, 2);
+	for (size_t i = 0; i < y.size(); i++)
+		if (y[i] == Fraction::sc_fZero)
+			y[i] = Fraction::sc_fUnity;
+
+	double u = Measure("unchecked int operator+", x, y, UncheckedAdd);
+	double c = Measure("operator+", x, y, [](const Fraction& a, const Fraction& b) { return a + b; });
+	Measure("checkedAdd", x, y, [](const Fraction& a, const Fraction& b) { return checkedAdd(a, b); });
+	Compare("+", u, c);
+
+	u = Measure("unchecked int operator*", x, y, UncheckedMul);
+	c = Measure("operator*", x, y, [](const Fraction& a, const Fraction& b) { return a * b; });
+	Measure("checkedMul", x, y, [](const Fraction& a, const Fraction& b) { return checkedMul(a, b); });
+	Compare("*", u, c);
+
+	u = Measure("unchecked int operator/", x, y, UncheckedDiv);
+	c = Measure("operator/", x, y, [](const Fraction& a, const Fraction& b) { return a / b; });
+	Measure("checkedDiv", x, y, [](const Fraction& a, const Fraction& b) { return checkedDiv(a, b); });
+	Compare("/", u, c);
+
+	Benchmark::section("Arithmetic operators: 20 bit operands");
+	x = RandomFractions(20, 3);
+	y = RandomFractions(20, 4);
+	size_t overflows = 0;
+	for (size_t i = 0; i < x.size(); i++)
+		overflows += !checkedAdd(x[i], y[i]).ok();
+	Measure("checkedAdd", x, y, [](const Fraction& a, const Fraction& b) { return checkedAdd(a, b); });
+	Measure("checkedMul", x, y, [](const Fraction& a, const Fraction& b) { return checkedMul(a, b); });
+	cout << "  " << overflows << " of " << x.size() << " sums overflow and are reported instead of wrapped" << endl;
+
+	Benchmark::section("Modulo: quotients of about 2^4 to 2^28");
+	for (int bits = 4; bits <= 30; bits += 6) {
+		string ratio = "2^" + to_string(bits);
+		ModOperands(int64_t(1) << bits, 1024, 8, x, y);
+		if (bits <= 16)
+			u = Measure("subtraction loop %, ratio " + ratio, x, y, SubtractionMod);
+		c = Measure("operator%, ratio " + ratio, x, y, [](const Fraction& a, const Fraction& b) { return a % b; });
+		Measure("divmod, ratio " + ratio, x, y, [](const Fraction& a, const Fraction& b) { return divmod(a, b); });
+		if (bits <= 16)
+			cout << "  speedup of the exact remainder: " << u / c << "x" << endl;
+	}
+
+	Benchmark::section("Integer operands: 15 bit Fractions and integers in [-1000, 1000]");
+	x = RandomFractions(15, 9);
+	vector<int> k = RandomIntegers(10);
+	MeasureInteger("F +", x, k, [](const Fraction& a, const auto& b) { return a + b; });
+	MeasureInteger("F -", x, k, [](const Fraction& a, const auto& b) { return a - b; });
+	MeasureInteger("F *", x, k, [](const Fraction& a, const auto& b) { return a * b; });
+	MeasureInteger("F /", x, k, [](const Fraction& a, const auto& b) { return a / b; });
+	// A scaling loop: every element is shifted by an integer and scaled by the ratio 3 / 4.
+	MeasureInteger("(F + k) * 3 / 4, k as", x, k, [](const Fraction& a, const auto& b) { return (a + b) * 3 / 4; });
+	u = Benchmark::run("F + Fraction(1)", x.size(), [&]() {
+		for (size_t i = 0; i < x.size(); i++)
+			Benchmark::doNotOptimize(x[i] + Fraction(1));
+	});
+	c = Benchmark::run("++F", x.size(), [&]() {
+		for (size_t i = 0; i < x.size(); i++) {
+			Fraction t = x[i];
+			Benchmark::doNotOptimize(++t);
+		}
+	});
+	cout << "  speedup of ++: " << u / c << "x" << endl;
+
+	Benchmark::section("Lazy normalization: a*b+c*d-e");
+	MeasureChain("3 bit operands", RandomFractions(3, 6));
+	MeasureChain("6 bit operands", RandomFractions(6, 7));
+
+	Benchmark::section("Arithmetic operators by width: 15 bit operands");
+	MeasureWidth<Fraction>("Fraction", 5);
+	MeasureWidth<Fraction64>("Fraction64", 5);
+#ifdef __SIZEOF_INT128__
+	MeasureWidth<Fraction128>("Fraction128", 5);
+#endif
+	return;
+}
+// End-of-File: BenchArithmetic.cpp
@@ -0,0 +1,97 @@
+// File: BenchBigFraction.cpp
+// Contains: void BenchBigFraction()
+/************ C++ Headers ************************************/
+
+#include <cstdint>
+#include <iostream>
+#include <string>
+#include <vector>
+using namespace std;
+
+/************ PROJECT Headers ********************************/
+
+#include "Benchmark.h"
+#include "BigFraction.h"
+#include "Fraction.h"
+
+// A random positive BigInteger of exactly the given number of bits, a multiple of 64.
+static BigInteger RandomBigInteger(Benchmark::Random& rng, size_t bits) {
+	const BigInteger base = BigInteger::fromMagnitude(~0ULL, false) + 1;
+	BigInteger r = BigInteger::fromMagnitude(rng.next() | (1ULL << 63), false);
+	for (size_t done = 64; done < bits; done += 64)
+		r = r * base + BigInteger::fromMagnitude(rng.next(), false);
+	return r;
+}
+
+// Multiplication and GCD of random operands of growing size.
+// Karatsuba multiplication and the half-GCD show as a growth rate below 4x per doubling of the size.
+static void MeasureScaling() {
+	Benchmark::section("BigInteger: scaling with operand size");
+	Benchmark::Random rng(11);
+	for (size_t bits = 1024; bits <= 131072; bits *= 2) {
+		BigInteger a = RandomBigInteger(rng, bits), b = RandomBigInteger(rng, bits);
+		size_t reps = 1 + (1 << 20) / bits;
+		Benchmark::run("multiply, " + to_string(bits) + " bits", reps, [&]() {
+			for (size_t i = 0; i < reps; i++)
+				Benchmark::doNotOptimize(a * b);
+		}, 3);
+		size_t gcdReps = 1 + (1 << 16) / bits;
+		Benchmark::run("gcd, " + to_string(bits) + " bits", gcdReps, [&]() {
+			for (size_t i = 0; i < gcdReps; i++)
+				Benchmark::doNotOptimize(BigInteger::gcd(a, b));
+		}, 3);
+	}
+}
+
+// Small values are stored inline and must stay close to the cost of the fixed width Fraction.
+static void MeasureSmall() {
+	Benchmark::section("BigFraction: small operands");
+	const size_t n = 1 << 14;
+	Benchmark::Random rng(12);
+	vector<Fraction> fx, fy;
+	vector<BigFraction> bx, by;
+	for (size_t i = 0; i < n; i++) {
+		fx.push_back(Fraction(static_cast<int>(rng.range(-32767, 32767)), static_cast<int>(rng.range(1, 32767))));
+		fy.push_back(Fraction(static_cast<int>(rng.range(-32767, 32767)), static_cast<int>(rng.range(1, 32767))));
+		bx.push_back(BigFraction(fx.back()));
+		by.push_back(BigFraction(fy.back()));
+	}
+	Benchmark::run("Fraction operator+, 15 bit operands", n, [&]() {
+		for (size_t i = 0; i < n; i++)
+			Benchmark::doNotOptimize(fx[i] + fy[i]);
+	});
+	Benchmark::run("BigFraction operator+, 15 bit operands", n, [&]() {
+		for (size_t i = 0; i < n; i++)
+			Benchmark::doNotOptimize(bx[i] + by[i]);
+	});
+	Benchmark::run("Fraction operator*, 15 bit operands", n, [&]() {
+		for (size_t i = 0; i < n; i++)
+			Benchmark::doNotOptimize(fx[i] * fy[i]);
+	});
+	Benchmark::run("BigFraction operator*, 15 bit operands", n, [&]() {
+		for (size_t i = 0; i < n; i++)
+			Benchmark::doNotOptimize(bx[i] * by[i]);
+	});
+}
+
+// Harmonic numbers: the denominators grow to lcm(1..n), so every addition works on growing operands.
+static void MeasureHarmonic() {
+	Benchmark::section("BigFraction: harmonic numbers");
+	for (int n = 500; n <= 4000; n *= 2) {
+		BigFraction h;
+		Benchmark::run("H(" + to_string(n) + ")", n, [&]() {
+			h = BigFraction::sc_fZero;
+			for (int k = 1; k <= n; k++)
+				h = h + BigFraction(1, k);
+		}, 3);
+		cout << "  denominator of H(" << n << ") has " << h.denominator().bitLength() << " bits" << endl;
+	}
+}
+
+void BenchBigFraction() {
+	MeasureScaling();
+	MeasureSmall();
+	MeasureHarmonic();
+	return;
+}
+// End-of-File: BenchBigFraction.cpp
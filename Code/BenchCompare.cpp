@@ -0,0 +1,114 @@
+// File: BenchCompare.cpp
+// Contains: void BenchCompare()
+/************ C++ Headers ************************************/
+
+#include <algorithm>
+#include <cstdint>
+#include <iostream>
+#include <vector>
+using namespace std;
+
+/************ PROJECT Headers ********************************/
+
+#include "Benchmark.h"
+#include "Fraction.h"
+#include "FractionSort.h"
+
+// Number of elements sorted
+static const size_t sc_nSorted = 1 << 20;
+
+// The comparison as it was before cross-multiplication: both numerators brought to lcm(q1,q2) with int products.
+// It costs a gcd and two divisions, and it wraps once the scaled numerators leave the int range.
+static bool LcmLess(const Fraction& a, const Fraction& b) {
+	unsigned int qa = a.denominator(), qb = b.denominator();
+	unsigned int x = qa, y = qb;
+	while (y != 0) {
+		unsigned int t = x % y;
+		x = y;
+		y = t;
+	}
+	unsigned int lcm = (qa / x) * qb;
+	int l = static_cast<int>(static_cast<unsigned int>(a.numerator()) * (lcm / qa));
+	int r = static_cast<int>(static_cast<unsigned int>(b.numerator()) * (lcm / qb));
+	return l < r;
+}
+
+// Fractions with numerators below 2^pbits and denominators below 2^qbits.
+static vector<Fraction> RandomFractions(int pbits, int qbits, uint64_t seed) {
+	Benchmark::Random rng(seed);
+	vector<Fraction> v;
+	v.reserve(sc_nSorted);
+	for (size_t i = 0; i < sc_nSorted; i++)
+		v.push_back(Fraction(static_cast<int>(rng.range(-(1 << pbits) + 1, (1 << pbits) - 1)), static_cast<int>(rng.range(1, (1 << qbits) - 1))));
+	return v;
+}
+
+template<typename Less>
+static double MeasureSort(const string& name, const vector<Fraction>& data, Less less) {
+	vector<Fraction> v;
+	return Benchmark::run(name, data.size(), [&]() {
+		v = data;
+		sort(v.begin(), v.end(), less);
+		Benchmark::doNotOptimize(v[0]);
+	}, 3);
+}
+
+void BenchCompare() {
+	Benchmark::section("Comparison operators: sorting 2^20 Fractions");
+	// With 7 bit numerators and 8 bit denominators the lcm based comparison cannot overflow, so both orders agree.
+	vector<Fraction> small = RandomFractions(7, 8, 31);
+	vector<Fraction> a = small, b = small;
+	sort(a.begin(), a.end(), LcmLess);
+	sort(b.begin(), b.end());
+	if (a != b) {
+		cerr << "BenchCompare: the lcm and cross-multiplication orders differ" << endl;
+		return;
+	}
+	double o = MeasureSort("std::sort, lcm operator<, small operands", small, LcmLess);
+	double n = MeasureSort("std::sort, operator<, small operands", small, [](const Fraction& x, const Fraction& y) { return x < y; });
+	cout << "  speedup of the cross-multiplying operator<: " << o / n << "x" << endl;
+
+	vector<Fraction> full = RandomFractions(30, 30, 32);
+	MeasureSort("std::sort, operator<, 30 bit operands", full, [](const Fraction& x, const Fraction& y) { return x < y; });
+
+	Benchmark::section("Comparison operators: single comparisons, 30 bit operands");
+	Benchmark::run("operator<", full.size() - 1, [&]() {
+		for (size_t i = 0; i + 1 < full.size(); i++)
+			Benchmark::doNotOptimize(full[i] < full[i + 1]);
+	});
+	Benchmark::run("compare", full.size() - 1, [&]() {
+		for (size_t i = 0; i + 1 < full.size(); i++)
+			Benchmark::doNotOptimize(compare(full[i], full[i + 1]));
+	});
+
+	Benchmark::section("Radix sort: sorting 2^20 Fractions");
+	vector<Fraction> sorted = full;
+	sort(sorted.begin(), sorted.end());
+	vector<Fraction> v = full;
+	fraction::sort(v);
+	if (v != sorted) {
+		cerr << "BenchCompare: fraction::sort and std::sort orders differ" << endl;
+		return;
+	}
+	double s = MeasureSort("std::sort, 30 bit operands", full, [](const Fraction& x, const Fraction& y) { return x < y; });
+	double r = Benchmark::run("fraction::sort, 30 bit operands, 1 thread", full.size(), [&]() {
+		v = full;
+		fraction::sort(v, 1);
+		Benchmark::doNotOptimize(v[0]);
+	}, 3);
+	cout << "  speedup of fraction::sort: " << s / r << "x" << endl;
+	Benchmark::run("fraction::sort, 30 bit operands, all threads", full.size(), [&]() {
+		v = full;
+		fraction::sort(v);
+		Benchmark::doNotOptimize(v[0]);
+	}, 3);
+	s = MeasureSort("std::sort, small operands", small, [](const Fraction& x, const Fraction& y) { return x < y; });
+	r = Benchmark::run("fraction::sort, small operands, 1 thread", small.size(), [&]() {
+		v = small;
+		fraction::sort(v, 1);
+		Benchmark::doNotOptimize(v[0]);
+	}, 3);
+	cout << "  speedup of fraction::sort: " << s / r << "x" << endl;
+	return;
+}
+// End-of-File: BenchCompare.cpp
@@ -0,0 +1,64 @@
+// File: BenchConversion.cpp
+// Contains: void BenchConversion()
+/************ C++ Headers ************************************/
+
+#include <cmath>
+#include <cstdint>
+#include <iostream>
+#include <vector>
+using namespace std;
+
+/************ PROJECT Headers ********************************/
+
+#include "Benchmark.h"
+#include "Fraction.h"
+
+// Number of converted values
+static const size_t sc_nValues = 1 << 16;
+
+// The floating point Constructor as it was: the value rounded down to 5 decimal places with pow(10,5) on every call.
+// It overflows above 21474 and loses every digit after the fifth decimal place.
+static Fraction FivePlaces(double d) {
+	int n = static_cast<int>(pow(10, 5));
+	return Fraction(static_cast<int>(floor(d * n)), n);
+}
+
+// Random doubles in [-lim, lim).
+static vector<double> RandomDoubles(double lim, uint64_t seed) {
+	Benchmark::Random rng(seed);
+	vector<double> v;
+	v.reserve(sc_nValues);
+	for (size_t i = 0; i < sc_nValues; i++)
+		v.push_back(lim * (static_cast<double>(rng.next() >> 11) / 4503599627370496.0 - 1.0));
+	return v;
+}
+
+template<typename Convert>
+static double Measure(const string& name, const vector<double>& x, Convert convert) {
+	return Benchmark::run(name, x.size(), [&]() {
+		for (size_t i = 0; i < x.size(); i++)
+			Benchmark::doNotOptimize(convert(x[i]));
+	});
+}
+
+void BenchConversion() {
+	Benchmark::section("Conversion from double");
+	// Short dyadic values such as 0.375 convert exactly without a continued fraction.
+	vector<double> dyadic = RandomDoubles(1000.0, 61);
+	for (size_t i = 0; i < dyadic.size(); i++)
+		dyadic[i] = floor(dyadic[i] * 256.0) / 256.0;
+	vector<double> x = RandomDoubles(20000.0, 62);
+
+	double o = Measure("5 decimal places, dyadic values", dyadic, FivePlaces);
+	double n = Measure("Fraction(double), dyadic values", dyadic, [](double d) { return Fraction(d); });
+	cout << "  speedup of the exact conversion: " << o / n << "x" << endl;
+
+	o = Measure("5 decimal places, random values", x, FivePlaces);
+	n = Measure("Fraction(double), random values", x, [](double d) { return Fraction(d); });
+	cout << "  speedup of the exact conversion: " << o / n << "x" << endl;
+
+	Measure("best_rational(x, 1000)", x, [](double d) { return fraction::best_rational(d, 1000); });
+	Measure("best_rational(x, 2^20)", x, [](double d) { return fraction::best_rational(d, 1 << 20); });
+	return;
+}
+// End-of-File: BenchConversion.cpp
@@ -0,0 +1,81 @@
+// File: BenchFractionFile.cpp
+// Contains: void BenchFractionFile()
+/************ C++ Headers ************************************/
+
+#include <cstdint>
+#include <cstdio>
+#include <fstream>
+#include <iostream>
+#include <string>
+using namespace std;
+
+/************ PROJECT Headers ********************************/
+
+#include "Benchmark.h"
+#include "Fraction.h"
+#include "FractionFile.h"
+#include "FractionVector.h"
+
+// Number of Fractions in the dataset
+static const size_t sc_nFractions = 1 << 22;
+
+static long long FileSize(const string& path) {
+	ifstream in(path.c_str(), ios::binary | ios::ate);
+	return static_cast<long long>(in.tellg());
+}
+
+// Prints the time of the whole dataset, which is what a job pays at startup.
+static void Total(double ns, const string& path) {
+	cout << "  " << ns * sc_nFractions / 1e6 << " ms for " << sc_nFractions << " Fractions, "
+		<< FileSize(path) / 1048576.0 << " MB" << endl;
+}
+
+void BenchFractionFile() {
+	Benchmark::section("Saving and loading 2^22 Fractions");
+	Benchmark::Random rng(81);
+	FractionVector v;
+	v.reserve(sc_nFractions);
+	for (size_t i = 0; i < sc_nFractions; i++)
+		v.push_back(Fraction(static_cast<int>(rng.range(-100000, 100000)), static_cast<int>(rng.range(1, 10000))));
+	const string text = "BenchFractionFile.txt", fixed = "BenchFractionFile.fixed", varint = "BenchFractionFile.varint";
+
+	double ns = Benchmark::run("write text with operator<<", v.size(), [&]() {
+		ofstream out(text.c_str());
+		for (size_t i = 0; i < v.size(); i++)
+			out << v[i] << '\n';
+	}, 1);
+	Total(ns, text);
+	double t = Benchmark::run("read text with operator>>", v.size(), [&]() {
+		ifstream in(text.c_str());
+		FractionVector w;
+		w.reserve(sc_nFractions);
+		Fraction f;
+		while (in >> f)
+			w.push_back(f);
+		Benchmark::doNotOptimize(w.size());
+	}, 1);
+	Total(t, text);
+
+	ns = Benchmark::run("FractionFile::write, fixed", v.size(), [&]() { FractionFile::write(fixed, v); }, 3);
+	Total(ns, fixed);
+	ns = Benchmark::run("FractionFile::write, varint", v.size(), [&]() { FractionFile::write(varint, v, FractionFile::eEncodingVarint); }, 3);
+	Total(ns, varint);
+
+	double f = Benchmark::run("open a mapped view, fixed", v.size(), [&]() {
+		FractionFile file(fixed);
+		Benchmark::doNotOptimize(file.numerators());
+	}, 3);
+	Total(f, fixed);
+	double d = Benchmark::run("open and decode, varint", v.size(), [&]() {
+		FractionFile file(varint);
+		Benchmark::doNotOptimize(file.numerators());
+	}, 3);
+	Total(d, varint);
+	cout << "  speedup over operator>>: fixed " << t / f << "x, varint " << t / d << "x" << endl;
+
+	remove(text.c_str());
+	remove(fixed.c_str());
+	remove(varint.c_str());
+	return;
+}
+// End-of-File: BenchFractionFile.cpp
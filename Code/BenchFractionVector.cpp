@@ -0,0 +1,84 @@
+// File: BenchFractionVector.cpp
+// Contains: void BenchFractionVector()
+/************ C++ Headers ************************************/
+
+#include <cstdint>
+#include <iostream>
+#include <vector>
+using namespace std;
+
+/************ PROJECT Headers ********************************/
+
+#include "Benchmark.h"
+#include "Fraction.h"
+#include "FractionVector.h"
+
+// Number of elements of every array
+static const size_t sc_nElements = 1 << 16;
+
+// Numerators and denominators below 2^bits.
+static vector<Fraction> RandomArray(int bits, uint64_t seed) {
+	Benchmark::Random rng(seed);
+	vector<Fraction> v;
+	v.reserve(sc_nElements);
+	for (size_t i = 0; i < sc_nElements; i++)
+		v.push_back(Fraction(static_cast<int>(rng.range(-(1 << bits) + 1, (1 << bits) - 1)), static_cast<int>(rng.range(1, (1 << bits) - 1))));
+	return v;
+}
+
+// The array of structures baseline: one checked operator per element.
+template<typename Op>
+static void Elementwise(const vector<Fraction>& x, const vector<Fraction>& y, vector<Fraction>& out, Op op) {
+	for (size_t i = 0; i < x.size(); i++)
+		out[i] = op(x[i], y[i]).value;
+}
+
+static void Compare(const string& kernel, double scalar, double batch) {
+	cout << "  " << kernel << " speedup of the batch kernel: " << scalar / batch << "x" << endl;
+}
+
+static void Measure(int bits) {
+	vector<Fraction> x = RandomArray(bits, 41), y = RandomArray(bits, 42), z(sc_nElements);
+	FractionVector vx(x), vy(y), vz;
+	string size = ", " + to_string(bits) + " bit operands";
+	auto checkedAddOp = [](const Fraction& a, const Fraction& b) { return checkedAdd(a, b); };
+	auto checkedMulOp = [](const Fraction& a, const Fraction& b) { return checkedMul(a, b); };
+
+	FractionVector::add(vx, vy, vz);
+	Elementwise(x, y, z, checkedAddOp);
+	if (vz.toVector() != z) {
+		cerr << "BenchFractionVector: the batch and scalar results differ" << endl;
+		return;
+	}
+
+	double s = Benchmark::run("checkedAdd loop" + size, x.size(), [&]() { Elementwise(x, y, z, checkedAddOp); Benchmark::doNotOptimize(z[0]); });
+	double b = Benchmark::run("FractionVector::add" + size, x.size(), [&]() { Benchmark::doNotOptimize(FractionVector::add(vx, vy, vz)); });
+	Compare("add", s, b);
+
+	s = Benchmark::run("checkedMul loop" + size, x.size(), [&]() { Elementwise(x, y, z, checkedMulOp); Benchmark::doNotOptimize(z[0]); });
+	b = Benchmark::run("FractionVector::mul" + size, x.size(), [&]() { Benchmark::doNotOptimize(FractionVector::mul(vx, vy, vz)); });
+	Compare("mul", s, b);
+
+	vector<int8_t> c(x.size()), vc;
+	s = Benchmark::run("compare loop" + size, x.size(), [&]() {
+		for (size_t i = 0; i < x.size(); i++)
+			c[i] = static_cast<int8_t>(compare(x[i], y[i]));
+		Benchmark::doNotOptimize(c[0]);
+	});
+	b = Benchmark::run("FractionVector::compare" + size, x.size(), [&]() { FractionVector::compare(vx, vy, vc); Benchmark::doNotOptimize(vc[0]); });
+	Compare("compare", s, b);
+}
+
+void BenchFractionVector() {
+	Benchmark::section("FractionVector: batch kernels vs loops over the checked operators");
+#if defined(__AVX2__) && !defined(FRACTION_VECTOR_SCALAR)
+	cout << "  kernels: AVX2" << endl;
+#else
+	cout << "  kernels: scalar (compile with -mavx2 for the AVX2 kernels)" << endl;
+#endif
+	// With 8 bit operands every product fits in 32 bits; with 15 bit operands many sums fall back to the scalar path.
+	Measure(8);
+	Measure(15);
+	return;
+}
+// End-of-File: BenchFractionVector.cpp
@@ -0,0 +1,116 @@
+// File: BenchGCD.cpp
+// Contains: void BenchGCD()
+/************ C++ Headers ************************************/
+
+#include <cstdint>
+#include <cstdlib>
+#include <iostream>
+#include <vector>
+using namespace std;
+
+/************ PROJECT Headers ********************************/
+
+#include "Benchmark.h"
+#include "Fraction.h"
+#include "FractionGCD.h"
+
+// Number of operand pairs in every dataset
+static const size_t sc_nPairs = 1 << 16;
+
+// A random word filling every bit of U.
+template<typename U>
+static U RandomWord(Benchmark::Random& rng) {
+	return static_cast<U>(rng.next());
+}
+
+#ifdef __SIZEOF_INT128__
+template<>
+unsigned __int128 RandomWord<unsigned __int128>(Benchmark::Random& rng) {
+	return (static_cast<unsigned __int128>(rng.next()) << 64) | rng.next();
+}
+#endif
+
+// Random pairs with values below 2^bits.
+template<typename U>
+static vector<pair<U, U> > RandomPairs(int bits) {
+	Benchmark::Random rng(bits);
+	U mask = (static_cast<U>(1) << bits) - 1;
+	vector<pair<U, U> > v(sc_nPairs);
+	for (size_t i = 0; i < v.size(); i++) {
+		U a = RandomWord<U>(rng) & mask;
+		U b = RandomWord<U>(rng) & mask;
+		v[i] = make_pair(a | 1, b | 1);
+	}
+	return v;
+}
+
+// Consecutive Fibonacci numbers are the worst case of Euclid's algorithm: every quotient is one.
+// The pairs cycle through the last few Fibonacci numbers that fit in U.
+template<typename U>
+static vector<pair<U, U> > FibonacciPairs() {
+	vector<U> fib(2, 1);
+	while (fib.back() <= static_cast<U>(~static_cast<U>(0)) - fib[fib.size() - 2])
+		fib.push_back(fib.back() + fib[fib.size() - 2]);
+	vector<pair<U, U> > v(sc_nPairs);
+	for (size_t i = 0; i < v.size(); i++) {
+		size_t k = fib.size() - 1 - i % 8;
+		v[i] = make_pair(fib[k], fib[k - 1]);
+	}
+	return v;
+}
+
+template<typename U, typename Gcd>
+static U Checksum(const vector<pair<U, U> >& data, Gcd gcd) {
+	U sum = 0;
+	for (size_t i = 0; i < data.size(); i++)
+		sum += gcd(data[i].first, data[i].second);
+	return sum;
+}
+
+// Times one GCD algorithm over a dataset after checking it against the recursive reference.
+template<typename U, typename Gcd>
+static void Measure(const string& name, const vector<pair<U, U> >& data, Gcd gcd) {
+	if (Checksum(data, gcd) != Checksum(data, FractionGCD::euclid<U>)) {
+		cerr << name << ": result differs from the recursive Euclid reference" << endl;
+		exit(1);
+	}
+	Benchmark::run(name, data.size(), [&]() {
+		for (size_t i = 0; i < data.size(); i++)
+			Benchmark::doNotOptimize(gcd(data[i].first, data[i].second));
+	});
+}
+
+template<typename U>
+static void MeasureWidth(const string& width, const vector<pair<U, U> >& data) {
+	Measure(width + " euclid (recursive)", data, FractionGCD::euclid<U>);
+	Measure(width + " binary", data, FractionGCD::binary<U>);
+}
+
+void BenchGCD() {
+	Benchmark::section("GCD engine: random operands");
+	MeasureWidth<uint32_t>("uint32", RandomPairs<uint32_t>(31));
+	MeasureWidth<uint64_t>("uint64", RandomPairs<uint64_t>(63));
+#ifdef __SIZEOF_INT128__
+	vector<pair<unsigned __int128, unsigned __int128> > wide = RandomPairs<unsigned __int128>(127);
+	MeasureWidth<unsigned __int128>("uint128", wide);
+	Measure("uint128 lehmer", wide, FractionGCD::lehmer);
+#endif
+
+	Benchmark::section("GCD engine: Fibonacci pairs");
+	MeasureWidth<uint32_t>("uint32", FibonacciPairs<uint32_t>());
+	MeasureWidth<uint64_t>("uint64", FibonacciPairs<uint64_t>());
+#ifdef __SIZEOF_INT128__
+	wide = FibonacciPairs<unsigned __int128>();
+	MeasureWidth<unsigned __int128>("uint128", wide);
+	Measure("uint128 lehmer", wide, FractionGCD::lehmer);
+#endif
+
+	Benchmark::section("Fraction(int, int) construction");
+	vector<pair<uint32_t, uint32_t> > data = RandomPairs<uint32_t>(30);
+	Benchmark::run("Fraction(p, q), random 30 bit operands", data.size(), [&]() {
+		for (size_t i = 0; i < data.size(); i++)
+			Benchmark::doNotOptimize(Fraction(static_cast<int>(data[i].first), static_cast<int>(data[i].second)));
+	});
+	return;
+}
+// End-of-File: BenchGCD.cpp
@@ -0,0 +1,79 @@
+// File: BenchHash.cpp
+// Contains: void BenchHash()
+/************ C++ Headers ************************************/
+
+#include <cstdint>
+#include <iostream>
+#include <map>
+#include <string>
+#include <unordered_map>
+#include <vector>
+using namespace std;
+
+/************ PROJECT Headers ********************************/
+
+#include "Benchmark.h"
+#include "Fraction.h"
+#include "FractionHash.h"
+
+// Number of insertions and of lookups
+static const size_t sc_nOperations = 1 << 20;
+
+// Keys drawn from about 2^17 distinct Fractions, so every key is inserted about 8 times.
+static vector<Fraction> RandomKeys(uint64_t seed) {
+	Benchmark::Random rng(seed);
+	vector<Fraction> v;
+	v.reserve(sc_nOperations);
+	for (size_t i = 0; i < sc_nOperations; i++)
+		v.push_back(Fraction(static_cast<int>(rng.range(-255, 255)), static_cast<int>(rng.range(1, 511))));
+	return v;
+}
+
+// Counts the keys, then looks up a second key set of which about half is present.
+template<typename Map, typename Find>
+static void Measure(const string& name, const vector<Fraction>& keys, const vector<Fraction>& probes, Find find, long& checksum) {
+	Benchmark::run(name + ": insert", keys.size(), [&]() {
+		Map m;
+		for (size_t i = 0; i < keys.size(); i++)
+			m[keys[i]]++;
+		Benchmark::doNotOptimize(m.size());
+	}, 3);
+	Map m;
+	for (size_t i = 0; i < keys.size(); i++)
+		m[keys[i]]++;
+	long found = 0;
+	Benchmark::run(name + ": lookup", probes.size(), [&]() {
+		found = 0;
+		for (size_t i = 0; i < probes.size(); i++)
+			found += find(m, probes[i]);
+		Benchmark::doNotOptimize(found);
+	}, 3);
+	if (checksum >= 0 && checksum != found)
+		cerr << "BenchHash: " << name << " found different counts" << endl;
+	checksum = found;
+}
+
+void BenchHash() {
+	Benchmark::section("Hash containers: counting 2^20 keys, then 2^20 lookups");
+	vector<Fraction> keys = RandomKeys(81);
+	// The probes have twice the numerator range, so about half of them are absent.
+	Benchmark::Random rng(82);
+	vector<Fraction> probes;
+	for (size_t i = 0; i < sc_nOperations; i++)
+		probes.push_back(Fraction(static_cast<int>(rng.range(-511, 511)), static_cast<int>(rng.range(1, 511))));
+
+	long checksum = -1;
+	Measure<FractionHashMap<int> >("FractionHashMap", keys, probes, [](const FractionHashMap<int>& m, const Fraction& f) {
+		const int* v = m.find(f);
+		return v ? *v : 0;
+	}, checksum);
+	Measure<unordered_map<Fraction, int> >("std::unordered_map", keys, probes, [](const unordered_map<Fraction, int>& m, const Fraction& f) {
+		unordered_map<Fraction, int>::const_iterator it = m.find(f);
+		return it != m.end() ? it->second : 0;
+	}, checksum);
+	Measure<map<Fraction, int> >("std::map", keys, probes, [](const map<Fraction, int>& m, const Fraction& f) {
+		map<Fraction, int>::const_iterator it = m.find(f);
+		return it != m.end() ? it->second : 0;
+	}, checksum);
+}
+// End-of-File: BenchHash.cpp
@@ -0,0 +1,95 @@
+// File: BenchKernels.cpp
+// Contains: void BenchKernels()
+/************ C++ Headers ************************************/
+
+#include <cstdint>
+#include <iostream>
+#include <type_traits>
+#include <vector>
+using namespace std;
+
+/************ PROJECT Headers ********************************/
+
+#include "Benchmark.h"
+#include "Fraction.h"
+
+// Number of elements of every array
+static const size_t sc_nElements = 1 << 16;
+
+// The operators as the compiler saw them when they were defined out of line in Fraction.cpp:
+// an opaque call per operation, with every argument and result passed through memory.
+__attribute__((noinline)) static Fraction OutOfLineAdd(const Fraction& a, const Fraction& b) { return a + b; }
+__attribute__((noinline)) static Fraction OutOfLineMul(const Fraction& a, const Fraction& b) { return a * b; }
+__attribute__((noinline)) static bool OutOfLineLess(const Fraction& a, const Fraction& b) { return a < b; }
+
+// Numerators below 100 over power of two denominators up to 64, so that a sum over the whole array fits in a Fraction.
+static vector<Fraction> RandomArray(uint64_t seed) {
+	Benchmark::Random rng(seed);
+	vector<Fraction> v;
+	v.reserve(sc_nElements);
+	for (size_t i = 0; i < sc_nElements; i++)
+		v.push_back(Fraction(static_cast<int>(rng.range(-99, 99)), 1 << rng.range(0, 6)));
+	return v;
+}
+
+template<typename Add>
+static Fraction Sum(const vector<Fraction>& x, Add add) {
+	Fraction s = Fraction::sc_fZero;
+	for (size_t i = 0; i < x.size(); i++)
+		s = add(s, x[i]);
+	return s;
+}
+
+template<typename Add, typename Mul>
+static Fraction Dot(const vector<Fraction>& x, const vector<Fraction>& y, Add add, Mul mul) {
+	Fraction s = Fraction::sc_fZero;
+	for (size_t i = 0; i < x.size(); i++)
+		s = add(s, mul(x[i], y[i]));
+	return s;
+}
+
+template<typename Less>
+static size_t CountLess(const vector<Fraction>& x, const vector<Fraction>& y, Less less) {
+	size_t n = 0;
+	for (size_t i = 0; i < x.size(); i++)
+		n += less(x[i], y[i]);
+	return n;
+}
+
+static void Compare(const string& kernel, double outOfLine, double inlined) {
+	cout << "  " << kernel << " speedup of the inline operators: " << outOfLine / inlined << "x" << endl;
+}
+
+void BenchKernels() {
+	Benchmark::section("Loop kernels: inline vs out-of-line operators");
+	cout << "  Fraction is trivially copyable: " << (is_trivially_copyable<Fraction>::value ? "yes" : "no") << endl;
+	vector<Fraction> x = RandomArray(21), y = RandomArray(22);
+	auto add = [](const Fraction& a, const Fraction& b) { return a + b; };
+	auto mul = [](const Fraction& a, const Fraction& b) { return a * b; };
+	auto less = [](const Fraction& a, const Fraction& b) { return a < b; };
+	if (Sum(x, add) != Sum(x, OutOfLineAdd) || Dot(x, y, add, mul) != Dot(x, y, OutOfLineAdd, OutOfLineMul)) {
+		cerr << "BenchKernels: inline and out-of-line kernels disagree" << endl;
+		return;
+	}
+
+	double o = Benchmark::run("sum, out-of-line", x.size(), [&]() { Benchmark::doNotOptimize(Sum(x, OutOfLineAdd)); });
+	double i = Benchmark::run("sum, inline", x.size(), [&]() { Benchmark::doNotOptimize(Sum(x, add)); });
+	Compare("sum", o, i);
+
+	o = Benchmark::run("dot product, out-of-line", x.size(), [&]() { Benchmark::doNotOptimize(Dot(x, y, OutOfLineAdd, OutOfLineMul)); });
+	i = Benchmark::run("dot product, inline", x.size(), [&]() { Benchmark::doNotOptimize(Dot(x, y, add, mul)); });
+	Compare("dot product", o, i);
+
+	o = Benchmark::run("compare, out-of-line", x.size(), [&]() { Benchmark::doNotOptimize(CountLess(x, y, OutOfLineLess)); });
+	i = Benchmark::run("compare, inline", x.size(), [&]() { Benchmark::doNotOptimize(CountLess(x, y, less)); });
+	Compare("compare", o, i);
+
+	// A trivially copyable element type lets std::vector copy the array with memmove.
+	vector<Fraction> z(x.size());
+	Benchmark::run("vector copy", x.size(), [&]() {
+		z = x;
+		Benchmark::doNotOptimize(z[0]);
+	});
+	return;
+}
+// End-of-File: BenchKernels.cpp
@@ -0,0 +1,82 @@
+// File: BenchMain.cpp
+// Contains: int main() of the benchmark executable
+/************ C++ Headers ************************************/
+#include <cstring>
+#include <fstream>
+#include <iostream>
+using namespace std;
+/************ PROJECT Headers ********************************/
+#include "Benchmark.h"
+#include "FractionStats.h"
+
+void BenchOperators();
+void BenchGCD();
+void BenchArithmetic();
+void BenchBigFraction();
+void BenchKernels();
+void BenchCompare();
+void BenchFractionVector();
+void BenchReduce();
+void BenchConversion();
+void BenchText();
+void BenchFractionFile();
+void BenchHash();
+void BenchMatrix();
+void BenchSimplex();
+void BenchPolynomial();
+void BenchArena();
+
+// FractionBench.out [--json file] runs every benchmark and, with --json, also writes the results as JSON to the file.
+// With --json - the JSON document is the only output on stdout and the readable report goes to stderr.
+// A build with -DFRACTION_STATS also prints the Fraction counters of the whole run.
+int main(int argc, char* argv[]) {
+	const char* json = nullptr;
+	for (int i = 1; i < argc; i++) {
+		if (strcmp(argv[i], "--json") == 0 && i + 1 < argc)
+			json = argv[++i];
+		else {
+			cerr << "usage: " << argv[0] << " [--json file]" << endl;
+			return 2;
+		}
+	}
+	// Everything the benchmarks print on cout is sent to stderr while the JSON owns stdout.
+	bool jsonToStdout = json != nullptr && strcmp(json, "-") == 0;
+	streambuf* stdoutBuffer = cout.rdbuf();
+	if (jsonToStdout)
+		cout.rdbuf(cerr.rdbuf());
+	BenchOperators();
+	BenchGCD();
+	BenchArithmetic();
+	BenchBigFraction();
+	BenchKernels();
+	BenchCompare();
+	BenchFractionVector();
+	BenchReduce();
+	BenchConversion();
+	BenchText();
+	BenchFractionFile();
+	BenchHash();
+	BenchMatrix();
+	BenchSimplex();
+	BenchPolynomial();
+	BenchArena();
+	if (FractionStats::sc_bEnabled) {
+		cout << "\nFractionStats counters of the run" << endl;
+		FractionStats::dump(cout, FractionStats::snapshot());
+	}
+	cout.rdbuf(stdoutBuffer);
+	if (json != nullptr) {
+		if (jsonToStdout)
+			Benchmark::writeJson(cout);
+		else {
+			ofstream out(json);
+			Benchmark::writeJson(out);
+			if (!out) {
+				cerr << "cannot write " << json << endl;
+				return 1;
+			}
+		}
+	}
+	return 0;
+}
+// End-of-File: BenchMain.cpp
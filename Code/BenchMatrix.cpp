@@ -0,0 +1,119 @@
+// File: BenchMatrix.cpp
+// Contains: void BenchMatrix()
+/************ C++ Headers ************************************/
+
+#include <cstdint>
+#include <iostream>
+#include <string>
+#include <vector>
+using namespace std;
+
+/************ PROJECT Headers ********************************/
+
+#include "BigFraction.h"
+#include "Benchmark.h"
+#include "Fraction.h"
+#include "FractionMatrix.h"
+
+// An n x n matrix with integer elements in [-range, range], divided by denominators in [1, denominators].
+static FractionMatrix RandomMatrix(size_t n, int range, int denominators, uint64_t seed) {
+	Benchmark::Random rng(seed);
+	FractionMatrix A(n, n);
+	for (size_t i = 0; i < n; i++)
+		for (size_t j = 0; j < n; j++)
+			A(i, j) = Fraction(static_cast<int>(rng.range(-range, range)), static_cast<int>(rng.range(1, denominators)));
+	return A;
+}
+
+// The determinant by Gaussian elimination on BigFractions, the way it is written by hand: every operation normalizes its result.
+static BigFraction GaussDeterminant(const FractionMatrix& A) {
+	size_t n = A.rows();
+	vector<vector<BigFraction> > a(n, vector<BigFraction>(n));
+	for (size_t i = 0; i < n; i++)
+		for (size_t j = 0; j < n; j++)
+			a[i][j] = BigFraction(A(i, j));
+	BigFraction det = BigFraction::sc_fUnity;
+	for (size_t k = 0; k < n; k++) {
+		size_t p = k;
+		while (p < n && a[p][k] == BigFraction::sc_fZero)
+			p++;
+		if (p == n)
+			return BigFraction::sc_fZero;
+		if (p != k) {
+			swap(a[p], a[k]);
+			det = -det;
+		}
+		det = det * a[k][k];
+		for (size_t i = k + 1; i < n; i++) {
+			BigFraction f = a[i][k] / a[k][k];
+			for (size_t j = k + 1; j < n; j++)
+				a[i][j] = a[i][j] - f * a[k][j];
+		}
+	}
+	return det;
+}
+
+// A system whose solution has small terms: b = A * x for a random x.
+static void MeasureSolve(size_t n, int repetitions) {
+	FractionMatrix A = RandomMatrix(n, 9, 1, 90 + n);
+	Benchmark::Random rng(91);
+	FractionMatrix x(n, 1);
+	for (size_t i = 0; i < n; i++)
+		x(i, 0) = Fraction(static_cast<int>(rng.range(-9, 9)), static_cast<int>(rng.range(1, 9)));
+	FractionMatrix B = A * x;
+	vector<Fraction> b(n);
+	for (size_t i = 0; i < n; i++)
+		b[i] = B(i, 0);
+	vector<Fraction> solution;
+	string name = "solve, " + to_string(n) + " x " + to_string(n);
+	Benchmark::run(name, 1, [&]() {
+		solution = A.solve(b);
+		Benchmark::doNotOptimize(solution[0]);
+	}, repetitions);
+	for (size_t i = 0; i < n; i++)
+		if (solution[i] != x(i, 0)) {
+			cerr << "BenchMatrix: wrong solution of the " << n << " x " << n << " system" << endl;
+			return;
+		}
+}
+
+void BenchMatrix() {
+	Benchmark::section("Exact determinant: Gauss on BigFractions and Bareiss, elements p/q with |p| <= 9, q <= 4, ns per matrix");
+	for (size_t n : {20, 50}) {
+		FractionMatrix A = RandomMatrix(n, 9, 4, 80 + n);
+		if (A.determinant() != GaussDeterminant(A)) {
+			cerr << "BenchMatrix: the determinants differ" << endl;
+			return;
+		}
+		string size = to_string(n) + " x " + to_string(n);
+		double g = Benchmark::run("Gauss, " + size, 1, [&]() { Benchmark::doNotOptimize(GaussDeterminant(A)); }, 1);
+		double b = Benchmark::run("Bareiss, " + size, 1, [&]() { Benchmark::doNotOptimize(A.determinant()); }, 3);
+		cout << "  speedup of Bareiss: " << g / b << "x" << endl;
+	}
+
+	Benchmark::section("Exact linear systems: Bareiss elimination, integer elements in [-9, 9], ns per system");
+	MeasureSolve(50, 3);
+	MeasureSolve(100, 3);
+	MeasureSolve(200, 1);
+	MeasureSolve(500, 1);
+
+	Benchmark::section("Exact inverse: 50 x 50 matrices I + u * v^T, ns per matrix");
+	Benchmark::Random rng(92);
+	FractionMatrix U(50, 1), V(1, 50);
+	for (size_t i = 0; i < 50; i++) {
+		U(i, 0) = Fraction(static_cast<int>(rng.range(-3, 3)), static_cast<int>(rng.range(1, 3)));
+		V(0, i) = Fraction(static_cast<int>(rng.range(-3, 3)));
+	}
+	FractionMatrix A = U * V;
+	for (size_t i = 0; i < 50; i++)
+		A(i, i) = A(i, i) + Fraction::sc_fUnity;
+	FractionMatrix inverse;
+	Benchmark::run("inverse, 50 x 50", 1, [&]() {
+		inverse = A.inverse();
+		Benchmark::doNotOptimize(inverse(0, 0));
+	}, 3);
+	if (A * inverse != FractionMatrix::identity(50))
+		cerr << "BenchMatrix: wrong inverse" << endl;
+	return;
+}
+// End-of-File: BenchMatrix.cpp
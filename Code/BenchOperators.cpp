@@ -0,0 +1,136 @@
+// File: BenchOperators.cpp
+// Contains: void BenchOperators()
+/************ C++ Headers ************************************/
+
+#include <cstdint>
+#include <iostream>
+#include <string>
+#include <vector>
+using namespace std;
+
+/************ PROJECT Headers ********************************/
+
+#include "Benchmark.h"
+#include "Fraction.h"
+
+// Number of operand pairs in every dataset
+static const size_t sc_nOperands = 1 << 16;
+
+// A dataset: operand pairs x[i], y[i], and the values x[i] as doubles and as unreduced terms for the constructors.
+struct Dataset {
+	string name;
+	vector<Fraction> x, y;
+	vector<int> p, q;
+	vector<double> d;
+};
+
+// The terms of x[i] are multiplied by 3 where they fit, so the constructor has a common factor to cancel.
+static void Fill(Dataset& s) {
+	for (size_t i = 0; i < s.x.size(); i++) {
+		int64_t p = s.x[i].numerator(), q = s.x[i].denominator();
+		int64_t f = (p >= -(int64_t(1) << 29) && p < (int64_t(1) << 29) && q < (int64_t(1) << 29)) ? 3 : 1;
+		s.p.push_back(static_cast<int>(p * f));
+		s.q.push_back(static_cast<int>(q * f));
+		s.d.push_back(static_cast<double>(p) / static_cast<double>(q));
+	}
+}
+
+// Fractions with numerators of at most pbits bits and denominators below 2^qbits.
+static Dataset RandomDataset(const string& name, int pbits, int qbits, uint64_t seed) {
+	Benchmark::Random rng(seed);
+	Dataset s;
+	s.name = name;
+	for (size_t i = 0; i < sc_nOperands; i++) {
+		int64_t pmax = (int64_t(1) << pbits) - 1, qmax = (int64_t(1) << qbits) - 1;
+		s.x.push_back(Fraction(static_cast<int>(rng.range(-pmax, pmax)), static_cast<int>(rng.range(1, qmax))));
+		Fraction y(static_cast<int>(rng.range(-pmax, pmax)), static_cast<int>(rng.range(1, qmax)));
+		s.y.push_back(y == Fraction::sc_fZero ? Fraction::sc_fUnity : y);
+	}
+	Fill(s);
+	return s;
+}
+
+// The adversarial dataset: ratios F(k-1)/F(k) of consecutive Fibonacci numbers, k <= 23.
+// The gcds of their terms and of the cross products take the most steps of any operands of that size, and every result still fits.
+static Dataset FibonacciDataset() {
+	vector<int> fib(2, 1);
+	while (fib.size() <= 23)
+		fib.push_back(fib.back() + fib[fib.size() - 2]);
+	Benchmark::Random rng(402);
+	Dataset s;
+	s.name = "Fibonacci ratios";
+	for (size_t i = 0; i < sc_nOperands; i++) {
+		int j = static_cast<int>(rng.range(16, 23)), k = static_cast<int>(rng.range(16, 23));
+		s.x.push_back(Fraction(fib[j - 1], fib[j]));
+		s.y.push_back(Fraction(rng.range(0, 1) ? fib[k - 1] : -fib[k - 1], fib[k]));
+	}
+	Fill(s);
+	return s;
+}
+
+template<typename Op>
+static void MeasureBinary(const string& name, const Dataset& s, Op op) {
+	vector<Fraction> z(s.x.size());
+	Benchmark::run(name, s.x.size(), [&]() {
+		for (size_t i = 0; i < s.x.size(); i++)
+			z[i] = op(s.x[i], s.y[i]);
+		Benchmark::doNotOptimize(z[0]);
+	});
+}
+
+template<typename Op>
+static void MeasurePredicate(const string& name, const Dataset& s, Op op) {
+	Benchmark::run(name, s.x.size(), [&]() {
+		size_t count = 0;
+		for (size_t i = 0; i < s.x.size(); i++)
+			count += op(s.x[i], s.y[i]) ? 1 : 0;
+		Benchmark::doNotOptimize(count);
+	});
+}
+
+// Every operator of Fraction on one dataset. The throwing arithmetic operators are measured only when no result overflows.
+static void MeasureDataset(const Dataset& s, bool arithmetic) {
+	Benchmark::section("Fraction operators, " + s.name + ", ns per operation");
+	vector<Fraction> z(s.x.size());
+	Benchmark::run("Fraction(int, int)", s.p.size(), [&]() {
+		for (size_t i = 0; i < s.p.size(); i++)
+			z[i] = Fraction(s.p[i], s.q[i]);
+		Benchmark::doNotOptimize(z[0]);
+	});
+	Benchmark::run("Fraction(double)", s.d.size(), [&]() {
+		for (size_t i = 0; i < s.d.size(); i++)
+			z[i] = Fraction(s.d[i]);
+		Benchmark::doNotOptimize(z[0]);
+	});
+	MeasureBinary("unary -", s, [](const Fraction& a, const Fraction&) { return -a; });
+	MeasureBinary("!, reciprocal", s, [](const Fraction&, const Fraction& b) { return !b; });
+	MeasureBinary("prefix ++", s, [](const Fraction& a, const Fraction&) { Fraction t = a; return ++t; });
+	MeasureBinary("prefix --", s, [](const Fraction& a, const Fraction&) { Fraction t = a; return --t; });
+	if (arithmetic) {
+		MeasureBinary("operator+", s, [](const Fraction& a, const Fraction& b) { return a + b; });
+		MeasureBinary("operator-", s, [](const Fraction& a, const Fraction& b) { return a - b; });
+		MeasureBinary("operator*", s, [](const Fraction& a, const Fraction& b) { return a * b; });
+		MeasureBinary("operator/", s, [](const Fraction& a, const Fraction& b) { return a / b; });
+		MeasureBinary("operator%", s, [](const Fraction& a, const Fraction& b) { return a % b; });
+	}
+	MeasureBinary("checkedAdd", s, [](const Fraction& a, const Fraction& b) { return checkedAdd(a, b).value; });
+	MeasureBinary("checkedSub", s, [](const Fraction& a, const Fraction& b) { return checkedSub(a, b).value; });
+	MeasureBinary("checkedMul", s, [](const Fraction& a, const Fraction& b) { return checkedMul(a, b).value; });
+	MeasureBinary("checkedDiv", s, [](const Fraction& a, const Fraction& b) { return checkedDiv(a, b).value; });
+	MeasureBinary("checkedMod", s, [](const Fraction& a, const Fraction& b) { return checkedMod(a, b).value; });
+	MeasurePredicate("operator==", s, [](const Fraction& a, const Fraction& b) { return a == b; });
+	MeasurePredicate("operator!=", s, [](const Fraction& a, const Fraction& b) { return a != b; });
+	MeasurePredicate("operator<", s, [](const Fraction& a, const Fraction& b) { return a < b; });
+	MeasurePredicate("operator<=", s, [](const Fraction& a, const Fraction& b) { return a <= b; });
+	MeasurePredicate("operator>", s, [](const Fraction& a, const Fraction& b) { return a > b; });
+	MeasurePredicate("operator>=", s, [](const Fraction& a, const Fraction& b) { return a >= b; });
+}
+
+void BenchOperators() {
+	// 15 bit terms keep every result of the arithmetic operators within 32 bits; 30 bit terms overflow most sums and products.
+	MeasureDataset(RandomDataset("random 15 bit terms", 15, 15, 401), true);
+	MeasureDataset(RandomDataset("random 30 bit terms", 30, 30, 403), false);
+	MeasureDataset(FibonacciDataset(), true);
+	return;
+}
+// End-of-File: BenchOperators.cpp
@@ -0,0 +1,100 @@
+// File: BenchPolynomial.cpp
+// Contains: void BenchPolynomial()
+/************ C++ Headers ************************************/
+
+#include <cstddef>
+#include <cstdint>
+#include <iostream>
+#include <string>
+#include <vector>
+using namespace std;
+
+/************ PROJECT Headers ********************************/
+
+#include "BigFraction.h"
+#include "Benchmark.h"
+#include "Fraction.h"
+#include "FractionPolynomial.h"
+
+// The coefficients of a polynomial of degree n, p/q with -99 <= p <= 99 and 1 <= q <= 9.
+static vector<Fraction> RandomCoefficients(size_t n, uint64_t seed) {
+	Benchmark::Random rng(seed);
+	vector<Fraction> c(n + 1);
+	for (Fraction& x : c)
+		x = Fraction(static_cast<int>(rng.range(-99, 99)), static_cast<int>(rng.range(1, 9)));
+	if (c.back() == Fraction::sc_fZero)
+		c.back() = Fraction::sc_fUnity;
+	return c;
+}
+
+static vector<BigFraction> ToBigFractions(const vector<Fraction>& c) {
+	vector<BigFraction> r;
+	for (const Fraction& x : c)
+		r.push_back(BigFraction(x));
+	return r;
+}
+
+// The product of two polynomials kept as arrays of BigFractions, the way it is written by hand: every operation normalizes its result.
+static vector<BigFraction> NaiveProduct(const vector<BigFraction>& x, const vector<BigFraction>& y) {
+	vector<BigFraction> r(x.size() + y.size() - 1, BigFraction(0));
+	for (size_t i = 0; i < x.size(); i++)
+		for (size_t j = 0; j < y.size(); j++)
+			r[i + j] = r[i + j] + x[i] * y[j];
+	return r;
+}
+
+// Horner's rule on BigFractions, normalizing every step.
+static BigFraction NaiveHorner(const vector<BigFraction>& c, const BigFraction& x) {
+	BigFraction s(0);
+	for (size_t i = c.size(); i-- > 0;)
+		s = s * x + c[i];
+	return s;
+}
+
+void BenchPolynomial() {
+	Benchmark::section("Polynomial product, ns per product");
+	for (size_t n : {100, 1000, 10000}) {
+		vector<Fraction> x = RandomCoefficients(n, 201 + n), y = RandomCoefficients(n, 202 + n);
+		FractionPolynomial P(x), Q(y);
+		int repetitions = n <= 1000 ? 3 : 1;
+		if (n <= 1000) {
+			vector<BigFraction> bx = ToBigFractions(x), by = ToBigFractions(y);
+			Benchmark::run("BigFraction schoolbook, degree " + to_string(n), 1, [&]() {
+				Benchmark::doNotOptimize(NaiveProduct(bx, by));
+			}, repetitions);
+		}
+		Benchmark::run("FractionPolynomial, degree " + to_string(n), 1, [&]() {
+			Benchmark::doNotOptimize(P * Q);
+		}, repetitions);
+	}
+
+	Benchmark::section("Polynomial evaluation at 2/3, ns per evaluation");
+	BigFraction point(2, 3);
+	for (size_t n : {100, 1000, 10000}) {
+		vector<Fraction> c = RandomCoefficients(n, 203 + n);
+		FractionPolynomial P(c);
+		vector<BigFraction> bc = ToBigFractions(c);
+		int repetitions = n <= 1000 ? 5 : 1;
+		Benchmark::run("BigFraction Horner, degree " + to_string(n), 1, [&]() {
+			Benchmark::doNotOptimize(NaiveHorner(bc, point));
+		}, repetitions);
+		Benchmark::run("FractionPolynomial, degree " + to_string(n), 1, [&]() {
+			Benchmark::doNotOptimize(P(point));
+		}, repetitions);
+		if (P(point) != NaiveHorner(bc, point))
+			cerr << "BenchPolynomial: the evaluations differ at degree " << n << endl;
+	}
+
+	Benchmark::section("Polynomial gcd of F * G and F * H, deg F = deg G = deg H, ns per gcd");
+	for (size_t n : {10, 30, 100}) {
+		FractionPolynomial F(RandomCoefficients(n, 204 + n)), G(RandomCoefficients(n, 205 + n)), H(RandomCoefficients(n, 206 + n));
+		FractionPolynomial A = F * G, B = F * H, D;
+		Benchmark::run("gcd, degree " + to_string(2 * n), 1, [&]() {
+			D = FractionPolynomial::gcd(A, B);
+		}, n <= 30 ? 3 : 1);
+		if (D.degree() != static_cast<int>(n) || !(A % D).isZero())
+			cerr << "BenchPolynomial: wrong gcd at degree " << 2 * n << endl;
+	}
+	return;
+}
+// End-of-File: BenchPolynomial.cpp
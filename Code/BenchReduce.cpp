@@ -0,0 +1,71 @@
+// File: BenchReduce.cpp
+// Contains: void BenchReduce()
+/************ C++ Headers ************************************/
+
+#include <cstdint>
+#include <iostream>
+#include <thread>
+#include <vector>
+using namespace std;
+
+/************ PROJECT Headers ********************************/
+
+#include "Benchmark.h"
+#include "Fraction.h"
+#include "FractionReduce.h"
+
+// Number of elements reduced
+static const size_t sc_nReduced = 1 << 22;
+
+// Numerators below 10 over power of two denominators up to 8, so that the partial sums of the serial fold stay far from overflowing.
+static vector<Fraction> RandomArray(uint64_t seed) {
+	Benchmark::Random rng(seed);
+	vector<Fraction> v;
+	v.reserve(sc_nReduced);
+	for (size_t i = 0; i < sc_nReduced; i++)
+		v.push_back(Fraction(static_cast<int>(rng.range(-9, 9)), 1 << rng.range(0, 3)));
+	return v;
+}
+
+void BenchReduce() {
+	Benchmark::section("Parallel reductions: 2^22 elements");
+	vector<Fraction> x = RandomArray(51), y = RandomArray(52);
+	Fraction serialSum = Fraction::sc_fZero, serialDot = Fraction::sc_fZero;
+	for (size_t i = 0; i < x.size(); i++) {
+		serialSum = serialSum + x[i];
+		serialDot = serialDot + x[i] * y[i];
+	}
+	if (fraction::reduce_sum(x) != serialSum || fraction::dot(x, y) != serialDot) {
+		cerr << "BenchReduce: the parallel and serial reductions differ" << endl;
+		return;
+	}
+
+	double s = Benchmark::run("serial fold, operator+", x.size(), [&]() {
+		Fraction r = Fraction::sc_fZero;
+		for (size_t i = 0; i < x.size(); i++)
+			r = r + x[i];
+		Benchmark::doNotOptimize(r);
+	}, 3);
+	double d = Benchmark::run("serial fold, dot product", x.size(), [&]() {
+		Fraction r = Fraction::sc_fZero;
+		for (size_t i = 0; i < x.size(); i++)
+			r = r + x[i] * y[i];
+		Benchmark::doNotOptimize(r);
+	}, 3);
+
+	// The thread counts run up to the number of hardware threads, and at least to 4.
+	unsigned cores = thread::hardware_concurrency();
+	cout << "  hardware threads: " << cores << endl;
+	for (unsigned threads = 1; threads <= cores || threads <= 4; threads *= 2) {
+		double t = Benchmark::run("reduce_sum, " + to_string(threads) + " threads", x.size(), [&]() {
+			Benchmark::doNotOptimize(fraction::reduce_sum(x, threads));
+		}, 3);
+		cout << "  speedup over the serial fold: " << s / t << "x" << endl;
+		t = Benchmark::run("dot, " + to_string(threads) + " threads", x.size(), [&]() {
+			Benchmark::doNotOptimize(fraction::dot(x, y, threads));
+		}, 3);
+		cout << "  speedup over the serial fold: " << d / t << "x" << endl;
+	}
+	return;
+}
+// End-of-File: BenchReduce.cpp
@@ -0,0 +1,125 @@
+// File: BenchSimplex.cpp
+// Contains: void BenchSimplex()
+/************ C++ Headers ************************************/
+
+#include <cstdint>
+#include <iostream>
+#include <string>
+#include <vector>
+using namespace std;
+
+/************ PROJECT Headers ********************************/
+
+#include "BigFraction.h"
+#include "Benchmark.h"
+#include "Fraction.h"
+#include "FractionLP.h"
+
+// The rows of a sparse m x n matrix with elements p/q, 1 <= p <= 9, 1 <= q <= 4.
+// Every column has an element in a row i with i % 4 != 1, the rows that bound the variables in the mixed programs.
+static vector<vector<FractionLP::Term> > RandomRows(size_t m, size_t n, int percent, Benchmark::Random& rng) {
+	vector<vector<FractionLP::Term> > rows(m);
+	for (size_t j = 0; j < n; j++) {
+		bool bounded = false;
+		for (size_t i = 0; i < m; i++)
+			if (rng.range(0, 99) < percent) {
+				rows[i].push_back(FractionLP::Term{j, Fraction(static_cast<int>(rng.range(1, 9)), static_cast<int>(rng.range(1, 4)))});
+				bounded = bounded || i % 4 != 1;
+			}
+		if (!bounded) {
+			size_t i = static_cast<size_t>(rng.range(0, static_cast<int64_t>(m / 4) - 1)) * 4 + 2;
+			rows[i].push_back(FractionLP::Term{j, Fraction(static_cast<int>(rng.range(1, 9)))});
+		}
+	}
+	return rows;
+}
+
+// A packing program: maximize c * x subject to A * x <= b, with A >= 0 and b > 0. The origin is feasible, so it needs no first phase.
+static FractionLP Packing(size_t m, size_t n, int percent, uint64_t seed) {
+	Benchmark::Random rng(seed);
+	FractionLP lp(n, FractionLP::eMaximize);
+	vector<vector<FractionLP::Term> > rows = RandomRows(m, n, percent, rng);
+	for (size_t i = 0; i < m; i++)
+		lp.addConstraint(rows[i], FractionLP::eLessEqual, Fraction(static_cast<int>(rng.range(10, 100))));
+	for (size_t j = 0; j < n; j++)
+		lp.setObjective(j, Fraction(static_cast<int>(rng.range(1, 9)), static_cast<int>(rng.range(1, 4))));
+	return lp;
+}
+
+// A program with equality and >= rows around a known feasible point x0, which needs the first phase.
+// A quarter of the rows are equations, a quarter >= rows and the others <= rows, which bound every variable.
+static FractionLP Mixed(size_t m, size_t n, int percent, uint64_t seed) {
+	Benchmark::Random rng(seed);
+	FractionLP lp(n, FractionLP::eMaximize);
+	vector<vector<FractionLP::Term> > rows = RandomRows(m, n, percent, rng);
+	vector<Fraction> x0(n);
+	for (size_t j = 0; j < n; j++)
+		x0[j] = Fraction(static_cast<int>(rng.range(0, 3)));
+	for (size_t i = 0; i < m; i++) {
+		Fraction b = Fraction::sc_fZero;
+		for (const FractionLP::Term& t : rows[i])
+			b = b + t.coefficient * x0[t.variable];
+		Fraction margin(static_cast<int>(rng.range(1, 5)));
+		if (i % 4 == 0)
+			lp.addConstraint(rows[i], FractionLP::eEqual, b);
+		else if (i % 4 == 1)
+			lp.addConstraint(rows[i], FractionLP::eGreaterEqual, b - margin);
+		else
+			lp.addConstraint(rows[i], FractionLP::eLessEqual, b + margin);
+	}
+	for (size_t j = 0; j < n; j++)
+		lp.setObjective(j, Fraction(static_cast<int>(rng.range(1, 9)), static_cast<int>(rng.range(1, 4))));
+	return lp;
+}
+
+// The assignment problem of k workers to k tasks, as a program over the k * k variables x(i, j): every row and every column of x sums to 1.
+// Every basic solution is highly degenerate, and one of the 2k equations is redundant.
+static FractionLP Assignment(size_t k, uint64_t seed) {
+	Benchmark::Random rng(seed);
+	FractionLP lp(k * k, FractionLP::eMinimize);
+	for (size_t i = 0; i < k; i++) {
+		vector<FractionLP::Term> worker, task;
+		for (size_t j = 0; j < k; j++) {
+			worker.push_back(FractionLP::Term{i * k + j, Fraction::sc_fUnity});
+			task.push_back(FractionLP::Term{j * k + i, Fraction::sc_fUnity});
+		}
+		lp.addConstraint(worker, FractionLP::eEqual, Fraction::sc_fUnity);
+		lp.addConstraint(task, FractionLP::eEqual, Fraction::sc_fUnity);
+	}
+	for (size_t v = 0; v < k * k; v++)
+		lp.setObjective(v, Fraction(static_cast<int>(rng.range(1, 100))));
+	return lp;
+}
+
+static void Measure(const string& name, FractionLP& lp, size_t refactorPeriod, int repetitions) {
+	FractionLP::Status status = FractionLP::eNotSolved;
+	Benchmark::run(name, 1, [&]() { status = lp.solve(refactorPeriod); }, repetitions);
+	cout << "  " << (status == FractionLP::eOptimal ? "optimal" : "not optimal") << ", " << lp.iterations() << " pivots, "
+		<< lp.refactorizations() << " factorizations, objective with a " << lp.objective().denominator().bitLength() << " bit denominator" << endl;
+}
+
+void BenchSimplex() {
+	Benchmark::section("Exact simplex on generated programs (variables x constraints, density), ns per program");
+	FractionLP p1 = Packing(50, 100, 10, 101);
+	Measure("packing, 100 x 50, 10%", p1, FractionLP::sc_nRefactorPeriod, 3);
+	FractionLP p2 = Packing(100, 200, 5, 102);
+	Measure("packing, 200 x 100, 5%", p2, FractionLP::sc_nRefactorPeriod, 3);
+	FractionLP p3 = Packing(200, 400, 3, 103);
+	Measure("packing, 400 x 200, 3%", p3, FractionLP::sc_nRefactorPeriod, 1);
+	FractionLP p4 = Packing(300, 600, 2, 104);
+	Measure("packing, 600 x 300, 2%", p4, FractionLP::sc_nRefactorPeriod, 1);
+	FractionLP m1 = Mixed(50, 100, 10, 105);
+	Measure("mixed rows, 100 x 50, 10%", m1, FractionLP::sc_nRefactorPeriod, 3);
+	FractionLP m2 = Mixed(100, 200, 5, 106);
+	Measure("mixed rows, 200 x 100, 5%", m2, FractionLP::sc_nRefactorPeriod, 1);
+	FractionLP a1 = Assignment(20, 107);
+	Measure("assignment, 400 x 40", a1, FractionLP::sc_nRefactorPeriod, 3);
+	if (a1.objective().denominator() != 1)
+		cerr << "BenchSimplex: the assignment has a fractional optimum" << endl;
+
+	Benchmark::section("Refactorization period: packing, 400 x 200, 3%, ns per program");
+	for (size_t period : {1, 4, 16})
+		Measure("every " + to_string(period) + " pivots", p3, period, 1);
+	return;
+}
+// End-of-File: BenchSimplex.cpp
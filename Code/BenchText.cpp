@@ -0,0 +1,79 @@
+// File: BenchText.cpp
+// Contains: void BenchText()
+/************ C++ Headers ************************************/
+
+#include <charconv>
+#include <cstdint>
+#include <iostream>
+#include <sstream>
+#include <string>
+#include <vector>
+using namespace std;
+
+/************ PROJECT Headers ********************************/
+
+#include "Benchmark.h"
+#include "Fraction.h"
+
+// Number of Fractions in the text
+static const size_t sc_nFractions = 1 << 18;
+
+static void Bandwidth(double ns, size_t bytes) {
+	cout << "  " << bytes / (ns * sc_nFractions) * 1000 << " MB/s" << endl;
+}
+
+void BenchText() {
+	Benchmark::section("Text formatting and parsing");
+	Benchmark::Random rng(71);
+	vector<Fraction> x;
+	for (size_t i = 0; i < sc_nFractions; i++)
+		x.push_back(Fraction(static_cast<int>(rng.range(-2000000000, 2000000000)), static_cast<int>(rng.range(1, 2000000000))));
+
+	// The log as the insertion operator writes it, one Fraction per line.
+	ostringstream log;
+	for (size_t i = 0; i < x.size(); i++)
+		log << x[i] << '\n';
+	string text = log.str();
+	vector<char> buffer(text.size() + 1);
+
+	double s = Benchmark::run("operator<< to an ostringstream", x.size(), [&]() {
+		ostringstream out;
+		for (size_t i = 0; i < x.size(); i++)
+			out << x[i] << '\n';
+		Benchmark::doNotOptimize(out.tellp());
+	});
+	Bandwidth(s, text.size());
+	double c = Benchmark::run("to_chars to a buffer", x.size(), [&]() {
+		char* p = buffer.data();
+		char* last = p + buffer.size();
+		for (size_t i = 0; i < x.size(); i++) {
+			p = fraction::to_chars(p, last, x[i]).ptr;
+			*p++ = '\n';
+		}
+		Benchmark::doNotOptimize(p);
+	});
+	Bandwidth(c, text.size());
+	cout << "  speedup of to_chars: " << s / c << "x" << endl;
+
+	s = Benchmark::run("operator>> from an istringstream", x.size(), [&]() {
+		istringstream in(text);
+		Fraction f;
+		while (in >> f)
+			Benchmark::doNotOptimize(f);
+	});
+	Bandwidth(s, text.size());
+	size_t mismatches = 0;
+	c = Benchmark::run("from_chars from the buffer", x.size(), [&]() {
+		const char* p = text.data();
+		const char* last = p + text.size();
+		Fraction f;
+		for (size_t i = 0; p < last; i++) {
+			p = fraction::from_chars(p, last, f).ptr + 1;
+			mismatches += !(f == x[i]);
+		}
+	});
+	Bandwidth(c, text.size());
+	cout << "  speedup of from_chars: " << s / c << "x, " << mismatches << " values differ" << endl;
+	return;
+}
+// End-of-File: BenchText.cpp
@@ -0,0 +1,142 @@
+#ifndef __BENCHMARK_H__
+#define __BENCHMARK_H__
+
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <iomanip>
+#include <iostream>
+#include <string>
+#include <vector>
+
+//Benchmark Harness
+//A minimal header-only harness shared by the Bench*.cpp files.
+//It provides a reproducible random number generator, a barrier against dead code elimination and a timer that reports nanoseconds per operation.
+//Every measurement is also recorded with its section, and writeJson() writes them all as one JSON document to compare runs across releases.
+
+namespace Benchmark
+{
+	//Random is a xorshift64* generator.
+	//It is seeded explicitly so that every run of the benchmark works on exactly the same datasets.
+	class Random
+	{
+	private:
+		std::uint64_t state;
+	public:
+		explicit Random(std::uint64_t seed=0x9E3779B97F4A7C15ULL) : state(seed ? seed : 1) {}
+
+		std::uint64_t next()
+		{
+			state^=state>>12;
+			state^=state<<25;
+			state^=state>>27;
+			return state*0x2545F4914F6CDD1DULL;
+		}
+
+		//Returns a value uniformly distributed in the closed range [lo,hi].
+		std::int64_t range(std::int64_t lo,std::int64_t hi)
+		{
+			return lo+static_cast<std::int64_t>(next()%static_cast<std::uint64_t>(hi-lo+1));
+		}
+	};
+
+	//doNotOptimize() forces the compiler to materialize a value so that the measured work is not removed.
+	template<typename T>
+	inline void doNotOptimize(const T& value)
+	{
+		asm volatile("" : : "m"(value) : "memory");
+	}
+
+	//Result is one recorded measurement.
+	struct Result
+	{
+		std::string section;
+		std::string name;
+		double nsPerOp;
+		std::size_t ops;
+		int repetitions;
+	};
+
+	//results() holds the measurements of the program in order, and currentSection() the title of the last section().
+	inline std::vector<Result>& results()
+	{
+		static std::vector<Result> r;
+		return r;
+	}
+
+	inline std::string& currentSection()
+	{
+		static std::string title;
+		return title;
+	}
+
+	//run() calls body() a number of times and reports the best time per operation in nanoseconds.
+	//body() must perform ops operations per call.
+	//The best of several repetitions is reported because it is the least disturbed by the rest of the system.
+	template<typename Body>
+	inline double run(const std::string& name,std::size_t ops,Body body,int repetitions=5)
+	{
+		double best=0;
+		for(int r=0;r<repetitions;r++)
+		{
+			std::chrono::steady_clock::time_point start=std::chrono::steady_clock::now();
+			body();
+			std::chrono::steady_clock::time_point stop=std::chrono::steady_clock::now();
+			double ns=std::chrono::duration<double,std::nano>(stop-start).count()/static_cast<double>(ops);
+			if(r==0 || ns<best)
+				best=ns;
+		}
+		std::cout << std::left << std::setw(48) << name << std::right << std::setw(12) << std::fixed << std::setprecision(2) << best << " ns/op" << std::endl;
+		results().push_back(Result{currentSection(),name,best,ops,repetitions});
+		return best;
+	}
+
+	//section() prints a heading for a group of related measurements.
+	inline void section(const std::string& title)
+	{
+		currentSection()=title;
+		std::cout << "\n" << title << "\n" << std::string(title.size(),'-') << std::endl;
+	}
+
+	//jsonString() writes a string as a JSON string literal.
+	inline void jsonString(std::ostream& out,const std::string& s)
+	{
+		out << '"';
+		for(char c : s)
+		{
+			if(c=='"' || c=='\\')
+				out << '\\' << c;
+			else if(static_cast<unsigned char>(c)<0x20)
+				out << "\\u" << std::hex << std::setw(4) << std::setfill('0') << static_cast<int>(c) << std::dec << std::setfill(' ');
+			else
+				out << c;
+		}
+		out << '"';
+	}
+
+	//writeJson() writes the recorded measurements as {"compiler":...,"results":[{"section":...,"name":...,"ns_per_op":...,"ops":...,"repetitions":...},...]}.
+	//A regression tracker matches the results of two runs by section and name.
+	inline void writeJson(std::ostream& out)
+	{
+		out << "{\n  \"compiler\": ";
+#ifdef __VERSION__
+		jsonString(out,__VERSION__);
+#else
+		jsonString(out,"unknown");
+#endif
+		out << ",\n  \"results\": [";
+		const std::vector<Result>& r=results();
+		for(std::size_t i=0;i<r.size();i++)
+		{
+			out << (i ? ",\n    {" : "\n    {") << "\"section\": ";
+			jsonString(out,r[i].section);
+			out << ", \"name\": ";
+			jsonString(out,r[i].name);
+			out << ", \"ns_per_op\": " << std::fixed << std::setprecision(3) << r[i].nsPerOp
+				<< ", \"ops\": " << r[i].ops << ", \"repetitions\": " << r[i].repetitions << "}";
+		}
+		out << "\n  ]\n}\n";
+	}
+}
+
+#endif // __BENCHMARK_H__
@@ -0,0 +1,275 @@
+#include "BigFraction.h"
+#include <cmath>
+#include <stdexcept>
+#include <string>
+
+//Unity Constant
+BigFraction BigFraction::sc_fUnity=BigFraction();
+
+//Zero Constant
+BigFraction BigFraction::sc_fZero=BigFraction(0);
+
+
+//Normalizes the fraction to its proper form.
+void BigFraction::normalize()
+{
+	if(this->p.isZero())
+	{
+		this->q=1;
+		return;
+	}
+	BigInteger GCD=BigInteger::gcd(this->p,this->q);
+	if(GCD!=1)
+	{
+		this->p=this->p/GCD;
+		this->q=this->q/GCD;
+	}
+}
+
+//Constructor with a pair of built-in integers
+BigFraction::BigFraction(long long m,long long n)
+: p(m),q(n)
+{
+	if(n==0)
+	{
+		throw std::runtime_error("Math error: Attempted to divide by Zero\n");
+	}
+	if(n<0)
+	{
+		this->p=-this->p;
+		this->q=-this->q;
+	}
+	this->normalize();
+}
+
+//Constructor with a pair of BigIntegers
+BigFraction::BigFraction(const BigInteger& m,const BigInteger& n)
+: p(m),q(n)
+{
+	if(n.isZero())
+	{
+		throw std::runtime_error("Math error: Attempted to divide by Zero\n");
+	}
+	if(n.isNegative())
+	{
+		this->p=-this->p;
+		this->q=-this->q;
+	}
+	this->normalize();
+}
+
+//Constructor for a pair already in lowest terms
+BigFraction::BigFraction(const BigInteger& m,const BigInteger& n,Reduced)
+: p(m),q(n)
+{
+}
+
+//Conversion to double
+//Both parts are split into a mantissa and an exponent first, so huge values do not overflow to infinity or NaN.
+double BigFraction::toDouble() const
+{
+	int pe,qe;
+	double pm=this->p.frexp(pe);
+	double qm=this->q.frexp(qe);
+	return std::ldexp(pm/qm,pe-qe);
+}
+
+//Unary Minus Operator
+BigFraction BigFraction::operator-() const
+{
+	return(BigFraction(-this->p,this->q,Reduced()));
+}
+
+//Unary Plus Operator
+BigFraction BigFraction::operator+() const
+{
+	return(*this);
+}
+
+//Unary Pre-Decrement Operator
+//p/q-1=(p-q)/q is already in lowest terms.
+BigFraction BigFraction::operator--()
+{
+	this->p=this->p-this->q;
+	return(*this);
+}
+
+//Unary Post-Decrement Operator
+BigFraction BigFraction::operator--(int)
+{
+	BigFraction copy(*this);
+	--(*this);
+	return(copy);
+}
+
+//Unary Pre-Increment Operator
+//p/q+1=(p+q)/q is already in lowest terms.
+BigFraction BigFraction::operator++()
+{
+	this->p=this->p+this->q;
+	return(*this);
+}
+
+//Unary Post-Increment Operator
+BigFraction BigFraction::operator++(int)
+{
+	BigFraction copy(*this);
+	++(*this);
+	return(copy);
+}
+
+//Binary Plus Operator
+//With g=gcd(b,d), a/b+c/d=t/(b/g*d) where t=a*(d/g)+c*(b/g), and only gcd(t,g) can remain to be cancelled.
+BigFraction operator+(const BigFraction& lhs,const BigFraction& rhs)
+{
+	BigInteger g=BigInteger::gcd(lhs.q,rhs.q);
+	if(g==1)
+	{
+		return(BigFraction(lhs.p*rhs.q+lhs.q*rhs.p,lhs.q*rhs.q,BigFraction::Reduced()));
+	}
+	BigInteger b=lhs.q/g,d=rhs.q/g;
+	BigInteger t=lhs.p*d+rhs.p*b;
+	if(t.isZero())
+	{
+		return(BigFraction::sc_fZero);
+	}
+	BigInteger g2=BigInteger::gcd(t,g);
+	if(g2==1)
+	{
+		return(BigFraction(t,b*rhs.q,BigFraction::Reduced()));
+	}
+	return(BigFraction(t/g2,b*(rhs.q/g2),BigFraction::Reduced()));
+}
+
+//Binary Minus Operator
+BigFraction operator-(const BigFraction& lhs,const BigFraction& rhs)
+{
+	return(lhs+(-rhs));
+}
+
+//Binary Multiply Operator
+//a/b*c/d=(a/g1*c/g2)/(b/g2*d/g1) with g1=gcd(a,d) and g2=gcd(c,b).
+BigFraction operator*(const BigFraction& lhs,const BigFraction& rhs)
+{
+	if(lhs.p.isZero() || rhs.p.isZero())
+	{
+		return(BigFraction::sc_fZero);
+	}
+	BigInteger g1=BigInteger::gcd(lhs.p,rhs.q);
+	BigInteger g2=BigInteger::gcd(rhs.p,lhs.q);
+	return(BigFraction((lhs.p/g1)*(rhs.p/g2),(lhs.q/g2)*(rhs.q/g1),BigFraction::Reduced()));
+}
+
+//Binary Divide Operator
+BigFraction operator/(const BigFraction& lhs,const BigFraction& rhs)
+{
+	return(lhs*(!rhs));
+}
+
+//Binary Modulo Operator
+//With a/b and c/d brought to the common denominator b*d, the remainder is the one of the integers a*d and c*b.
+BigFraction operator%(const BigFraction& lhs,const BigFraction& rhs)
+{
+	if(rhs.p.isZero())
+	{
+		throw std::runtime_error("Math error: Attempted to divide by Zero\n");
+	}
+	return(BigFraction((lhs.p*rhs.q)%(rhs.p*lhs.q),lhs.q*rhs.q));
+}
+
+//Comparison
+int compare(const BigFraction& lhs,const BigFraction& rhs)
+{
+	int ls=lhs.p.sign(),rs=rhs.p.sign();
+	if(ls!=rs)
+	{
+		return(ls<rs ? -1 : 1);
+	}
+	if(ls==0)
+	{
+		return(0);
+	}
+	return(compare(lhs.p*rhs.q,rhs.p*lhs.q));
+}
+
+//Not Operator
+BigFraction BigFraction::operator!() const
+{
+	if(this->p.isZero())
+	{
+		throw std::runtime_error("Fraction is zero!");
+	}
+	if(this->p.isNegative())
+	{
+		return(BigFraction(-this->q,-this->p,Reduced()));
+	}
+	return(BigFraction(this->q,this->p,Reduced()));
+}
+
+//Insertion Operator
+std::ostream& operator<<(std::ostream& OUT,const BigFraction& rhs)
+{
+	OUT << rhs.p;
+	if(rhs.q!=1)
+	{
+		OUT << " / " << rhs.q;
+	}
+	return OUT;
+}
+
+//readTerm() reads an optionally signed decimal integer and stops at the first character that is not a digit, like readInteger() of Fraction,
+//so "1/2" is read as 1 followed by "/2". It sets the failbit if there are no digits.
+static void readTerm(std::istream& IN,BigInteger& x)
+{
+	if(!(IN >> std::ws))
+	{
+		return;
+	}
+	std::string digits;
+	if(IN.peek()=='-' || IN.peek()=='+')
+	{
+		digits+=static_cast<char>(IN.get());
+	}
+	for(int c=IN.peek();c>='0' && c<='9';c=IN.peek())
+	{
+		digits+=static_cast<char>(IN.get());
+	}
+	if(digits.empty() || digits=="-" || digits=="+")
+	{
+		IN.setstate(std::ios::failbit);
+		return;
+	}
+	x=BigInteger::fromString(digits);
+}
+
+//Extraction Operator
+//The grammar is the one of the Fraction extractor: "p / q", "p/q" or "p".
+std::istream& operator>>(std::istream& IN,BigFraction& rhs)
+{
+	BigInteger m,n(1);
+	readTerm(IN,m);
+	if(!IN)
+	{
+		return IN;
+	}
+	//An integer that ends the stream is complete: skipping the trailing spaces must not fail the extraction.
+	IN >> std::ws;
+	if(IN.eof())
+	{
+		IN.clear(std::ios::eofbit);
+	}
+	else if(IN.peek()=='/')
+	{
+		IN.get();
+		readTerm(IN,n);
+	}
+	if(IN && n.isZero())
+	{
+		IN.setstate(std::ios::failbit);
+	}
+	if(IN)
+	{
+		rhs=BigFraction(m,n);
+	}
+	return IN;
+}
@@ -0,0 +1,204 @@
+#ifndef __BIG_FRACTION_H__
+#define __BIG_FRACTION_H__
+
+#include <iostream>
+#include <stdexcept>
+#include <type_traits>
+#include "BasicFraction.h"
+#include "BigInteger.h"
+
+//BigFraction is the arbitrary precision Fraction data type.
+//Its numerator and denominator are BigIntegers, so no arithmetic operation can overflow.
+//Every object is normalized like a Fraction: the denominator is positive, the two are coprime and zero is stored as 0/1.
+//Values whose numerator and denominator are below 2^64 never allocate.
+class BigFraction
+{
+private:
+	//The data members have been made private for information hiding.
+	//The user feels like he is actually dealing with a Fraction data type and not with two integers.
+
+	BigInteger p;	//Numerator
+	BigInteger q;	//Denominator
+
+public:
+	//The static constants declared here are made public in order to be used by the user whenever he needs them.
+
+	static BigFraction sc_fUnity;	//BigFraction Unity 1/1
+	static BigFraction sc_fZero;	//BigFraction Zero 0/1
+
+private:
+	//Utility Functions
+
+	//normalize() function divides p and q by their gcd.
+	//The sign has already been moved to the numerator by the constructor, so only the gcd remains to be cancelled.
+	void normalize();
+
+	//Reduced is a tag type selecting the private constructor that stores an already normalized pair without calling normalize().
+	struct Reduced {};
+
+	//This private Constructor is used by the arithmetic operators which produce their results in lowest terms by cross-cancellation.
+	BigFraction(const BigInteger&,const BigInteger&,Reduced);
+
+	//toBigInteger(T) converts a numerator or denominator of a BasicFraction to a BigInteger whatever its width and signedness.
+	template<typename T>
+	static BigInteger toBigInteger(T x)
+	{
+		if constexpr(sizeof(T)<=sizeof(long long))
+		{
+			if constexpr(std::is_signed<T>::value)
+				return BigInteger(static_cast<long long>(x));
+			else
+				return BigInteger::fromMagnitude(static_cast<unsigned long long>(x),false);
+		}
+		else
+		{
+			//128 bit integers are split into two 64 bit halves.
+			bool negative=(x<0);
+			unsigned __int128 m=negative ? 0-static_cast<unsigned __int128>(x) : static_cast<unsigned __int128>(x);
+			BigInteger r=BigInteger::fromInt128(static_cast<__int128>(m>>64))*BigInteger::fromInt128(static_cast<__int128>(1)<<64)
+				+BigInteger::fromMagnitude(static_cast<unsigned long long>(m),false);
+			return negative ? -r : r;
+		}
+	}
+
+	//toUnsigned<U>(B) returns the magnitude of a BigInteger that fits in the unsigned type U.
+	template<typename U>
+	static U toUnsigned(const BigInteger& x)
+	{
+		U m=static_cast<U>(x.limb(0));
+		if constexpr(sizeof(U)>sizeof(BigInteger::Limb))
+			m|=static_cast<U>(x.limb(1))<<64;
+		return m;
+	}
+
+public:
+
+	//Constructors
+
+	//This is a Constructor of the BigFraction class from built-in integers and has three ways of being called, like the Fraction Constructor.
+	//1)As a default no args Constructor BigFraction().
+	//2)As a one arg Constructor BigFraction(int).
+	//3)As a two args Constructor BigFraction(int,int).
+	//A negative denominator moves its sign to the numerator.
+	//It throws std::runtime_error if n=0.
+	BigFraction(long long m=1,long long n=1);
+
+	//This is a Constructor of the BigFraction class from BigIntegers.
+	//It throws std::runtime_error if n=0.
+	BigFraction(const BigInteger& m,const BigInteger& n=BigInteger(1));
+
+	//This Constructor converts a Fraction of any width exactly. The Fraction is already normalized, so no gcd is needed.
+	template<typename IntT>
+	BigFraction(const BasicFraction<IntT>& f)
+	: p(toBigInteger(f.numerator())),q(toBigInteger(f.denominator()))
+	{
+	}
+
+	//Accessors
+
+	//numerator() returns the numerator of the normalized BigFraction. It carries the sign of the BigFraction.
+	const BigInteger& numerator() const {return p;}
+
+	//denominator() returns the denominator of the normalized BigFraction. It is always positive.
+	const BigInteger& denominator() const {return q;}
+
+	//toDouble() returns an approximation of the BigFraction as a double.
+	double toDouble() const;
+
+	//toFraction<IntT>() converts the BigFraction back to BasicFraction<IntT>, e.g. B.toFraction<std::int32_t>().
+	//It throws std::overflow_error if the value does not fit in that Fraction type.
+	template<typename IntT>
+	BasicFraction<IntT> toFraction() const
+	{
+		typedef typename BasicFraction<IntT>::Unsigned Unsigned;
+		if(p.bitLength()>8*sizeof(Unsigned) || q.bitLength()>8*sizeof(Unsigned))
+		{
+			throw std::overflow_error("Math error: Fraction overflow\n");
+		}
+		Unsigned m=toUnsigned<Unsigned>(p),n=toUnsigned<Unsigned>(q);
+		if(m>(static_cast<Unsigned>(~static_cast<Unsigned>(0))>>1)+p.isNegative())
+		{
+			throw std::overflow_error("Math error: Fraction overflow\n");
+		}
+		return BasicFraction<IntT>(static_cast<IntT>(p.isNegative() ? 0-m : m),n,typename BasicFraction<IntT>::Reduced());
+	}
+
+
+	//Unary Arithmetic Operators
+
+	//-F1 <-------> F1.operator-()
+	BigFraction operator-() const;
+
+	//+F1 <-------> F1.operator+()
+	BigFraction operator+() const;
+
+	//--F1 <-------> F1.operator--()
+	BigFraction operator--();
+
+	//F1-- <-------> F1.operator--(int)
+	BigFraction operator--(int);
+
+	//++F1 <-------> F1.operator++()
+	BigFraction operator++();
+
+	//F1++ <-------> F1.operator++(int)
+	BigFraction operator++(int);
+
+
+	//Binary Arithmetic Operators
+	//The results are exact. Common factors are cancelled across the operands before multiplying (Knuth, TAOCP 4.5.1), so the intermediate products stay as small as possible.
+	//Division by a zero BigFraction throws std::runtime_error.
+
+	//F1+F2 <------> operator+(F1,F2)
+	friend BigFraction operator+(const BigFraction&,const BigFraction&);
+
+	//F1-F2 <------> operator-(F1,F2)
+	friend BigFraction operator-(const BigFraction&,const BigFraction&);
+
+	//F1*F2 <------> operator*(F1,F2)
+	friend BigFraction operator*(const BigFraction&,const BigFraction&);
+
+	//F1/F2 <------> operator/(F1,F2)
+	friend BigFraction operator/(const BigFraction&,const BigFraction&);
+
+	//F1%F2 <------> operator%(F1,F2)
+	//The remainder is F1-k*F2 for the integer k=F1/F2 truncated towards zero, so it has the sign of F1 like the Fraction operator.
+	friend BigFraction operator%(const BigFraction&,const BigFraction&);
+
+
+	//Binary Relational Operators
+	//The operands are compared by cross-multiplying after comparing their signs.
+
+	//compare(F1,F2) returns a negative value, zero or a positive value if F1 is less than, equal to or greater than F2.
+	friend int compare(const BigFraction&,const BigFraction&);
+
+	friend bool operator==(const BigFraction& lhs,const BigFraction& rhs) {return lhs.p==rhs.p && lhs.q==rhs.q;}
+	friend bool operator!=(const BigFraction& lhs,const BigFraction& rhs) {return !(lhs==rhs);}
+	friend bool operator<(const BigFraction& lhs,const BigFraction& rhs) {return compare(lhs,rhs)<0;}
+	friend bool operator<=(const BigFraction& lhs,const BigFraction& rhs) {return compare(lhs,rhs)<=0;}
+	friend bool operator>(const BigFraction& lhs,const BigFraction& rhs) {return compare(lhs,rhs)>0;}
+	friend bool operator>=(const BigFraction& lhs,const BigFraction& rhs) {return compare(lhs,rhs)>=0;}
+
+
+	//Special Operators
+
+	//!F1 <-------> F1.operator!()
+	//It returns the reciprocal and throws std::runtime_error if F1 is zero.
+	BigFraction operator!() const;
+
+
+	//Input/Output Operators
+	//The format is the one of Fraction: "p / q", or "p" alone when q=1.
+
+	//std::cout << F1 <------> operator<<(cout,F1)
+	friend std::ostream& operator<<(std::ostream&,const BigFraction&);
+
+	//std::cin >> F1 <------> operator>>(cin,F1)
+	//It reads the form written by the insertion operator, "p / q" or "p" for an integer, with or without the spaces around the slash.
+	//A zero denominator sets the failbit of the stream.
+	friend std::istream& operator>>(std::istream&,BigFraction&);
+};
+
+int compare(const BigFraction&,const BigFraction&);
+
+#endif // __BIG_FRACTION_H__
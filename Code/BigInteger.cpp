@@ -0,0 +1,1001 @@
+#include "BigInteger.h"
+#include "FractionGCD.h"
+#include <algorithm>
+#include <cmath>
+#include <stdexcept>
+
+//Products of two operands with at least this many limbs use Karatsuba multiplication.
+#ifndef BIGINTEGER_KARATSUBA_THRESHOLD
+#define BIGINTEGER_KARATSUBA_THRESHOLD 32
+#endif
+
+//gcd() switches from Lehmer's algorithm to the recursive half-GCD for operands with at least this many limbs.
+#ifndef BIGINTEGER_HALF_GCD_THRESHOLD
+#define BIGINTEGER_HALF_GCD_THRESHOLD 256
+#endif
+
+namespace
+{
+	typedef BigInteger::Limb Limb;
+	typedef BigInteger::Limbs Limbs;
+	typedef unsigned __int128 DLimb;
+
+	//The half-GCD finishes a reduction of at most this many bits with Lehmer steps.
+	const std::size_t sc_nHalfGcdLeafBits=32*64;
+
+	//Extra bits kept above the size at which the quotients of a truncated pair stop being reliable.
+	const std::size_t sc_nHalfGcdMargin=64;
+
+	//Largest power of ten that fits in a limb, used for the decimal conversions.
+	const Limb sc_nDecimalChunk=10000000000000000000ULL;
+	const int sc_nDecimalChunkDigits=19;
+
+	//Magnitude Utilities
+	//These functions work on magnitudes stored least significant limb first.
+	//Results are always trimmed so that they have no leading zero limbs.
+
+	void trim(Limbs& a)
+	{
+		while(!a.empty() && a.back()==0)
+			a.pop_back();
+	}
+
+	std::size_t trimmedSize(const Limb* a,std::size_t n)
+	{
+		while(n>0 && a[n-1]==0)
+			n--;
+		return n;
+	}
+
+	int compareSpan(const Limb* a,std::size_t na,const Limb* b,std::size_t nb)
+	{
+		na=trimmedSize(a,na);
+		nb=trimmedSize(b,nb);
+		if(na!=nb)
+			return na<nb ? -1 : 1;
+		for(std::size_t i=na;i-->0;)
+		{
+			if(a[i]!=b[i])
+				return a[i]<b[i] ? -1 : 1;
+		}
+		return 0;
+	}
+
+	int compareLimbs(const Limbs& a,const Limbs& b)
+	{
+		return compareSpan(a.data(),a.size(),b.data(),b.size());
+	}
+
+	std::size_t bitLengthSpan(const Limb* a,std::size_t n)
+	{
+		n=trimmedSize(a,n);
+		return n==0 ? 0 : 64*n-static_cast<std::size_t>(__builtin_clzll(a[n-1]));
+	}
+
+	std::size_t bitLengthLimbs(const Limbs& a)
+	{
+		return bitLengthSpan(a.data(),a.size());
+	}
+
+	Limbs addSpan(const Limb* a,std::size_t na,const Limb* b,std::size_t nb)
+	{
+		if(na<nb)
+		{
+			std::swap(a,b);
+			std::swap(na,nb);
+		}
+		Limbs r(na+1);
+		Limb carry=0;
+		for(std::size_t i=0;i<na;i++)
+		{
+			DLimb t=static_cast<DLimb>(a[i])+(i<nb ? b[i] : 0)+carry;
+			r[i]=static_cast<Limb>(t);
+			carry=static_cast<Limb>(t>>64);
+		}
+		r[na]=carry;
+		trim(r);
+		return r;
+	}
+
+	//subInPlace() subtracts b from r. It requires r>=b.
+	void subInPlace(Limbs& r,const Limb* b,std::size_t nb)
+	{
+		nb=trimmedSize(b,nb);
+		Limb borrow=0;
+		for(std::size_t i=0;i<nb;i++)
+		{
+			Limb ri=r[i];
+			Limb t=ri-b[i];
+			Limb borrowOut=(ri<b[i]) || (t<borrow);
+			r[i]=t-borrow;
+			borrow=borrowOut;
+		}
+		for(std::size_t i=nb;borrow && i<r.size();i++)
+		{
+			borrow=(r[i]==0);
+			r[i]--;
+		}
+		trim(r);
+	}
+
+	//subSpan() returns a-b. It requires a>=b.
+	Limbs subSpan(const Limb* a,std::size_t na,const Limb* b,std::size_t nb)
+	{
+		Limbs r(a,a+na);
+		subInPlace(r,b,nb);
+		return r;
+	}
+
+	//addAt() adds b shifted left by offset limbs to r, growing r as needed.
+	void addAt(Limbs& r,const Limb* b,std::size_t nb,std::size_t offset)
+	{
+		if(r.size()<offset+nb)
+			r.resize(offset+nb,0);
+		Limb carry=0;
+		for(std::size_t i=0;i<nb;i++)
+		{
+			DLimb t=static_cast<DLimb>(r[offset+i])+b[i]+carry;
+			r[offset+i]=static_cast<Limb>(t);
+			carry=static_cast<Limb>(t>>64);
+		}
+		for(std::size_t k=offset+nb;carry;k++)
+		{
+			if(k==r.size())
+				r.push_back(0);
+			DLimb t=static_cast<DLimb>(r[k])+carry;
+			r[k]=static_cast<Limb>(t);
+			carry=static_cast<Limb>(t>>64);
+		}
+	}
+
+	Limbs mulLimb(const Limb* a,std::size_t na,Limb m)
+	{
+		Limbs r(na+1);
+		Limb carry=0;
+		for(std::size_t i=0;i<na;i++)
+		{
+			DLimb t=static_cast<DLimb>(a[i])*m+carry;
+			r[i]=static_cast<Limb>(t);
+			carry=static_cast<Limb>(t>>64);
+		}
+		r[na]=carry;
+		trim(r);
+		return r;
+	}
+
+	Limbs mulSchool(const Limb* a,std::size_t na,const Limb* b,std::size_t nb)
+	{
+		Limbs r(na+nb,0);
+		for(std::size_t i=0;i<na;i++)
+		{
+			DLimb ai=a[i];
+			Limb carry=0;
+			for(std::size_t j=0;j<nb;j++)
+			{
+				DLimb t=ai*b[j]+r[i+j]+carry;
+				r[i+j]=static_cast<Limb>(t);
+				carry=static_cast<Limb>(t>>64);
+			}
+			r[i+nb]=carry;
+		}
+		trim(r);
+		return r;
+	}
+
+	//mulSpan() multiplies two magnitudes.
+	//Below the threshold it uses the schoolbook method.
+	//Above it splits both operands at half the longer length and forms three half size products (Karatsuba), so the cost is O(n^1.585).
+	//Unbalanced operands are cut into pieces of the length of the shorter one first.
+	Limbs mulSpan(const Limb* a,std::size_t na,const Limb* b,std::size_t nb)
+	{
+		na=trimmedSize(a,na);
+		nb=trimmedSize(b,nb);
+		if(na<nb)
+		{
+			std::swap(a,b);
+			std::swap(na,nb);
+		}
+		if(nb==0)
+			return Limbs();
+		if(nb==1)
+			return mulLimb(a,na,b[0]);
+		if(nb<BIGINTEGER_KARATSUBA_THRESHOLD)
+			return mulSchool(a,na,b,nb);
+		if(2*nb<=na)
+		{
+			Limbs r(na+nb,0);
+			for(std::size_t offset=0;offset<na;offset+=nb)
+			{
+				Limbs part=mulSpan(a+offset,std::min(nb,na-offset),b,nb);
+				addAt(r,part.data(),part.size(),offset);
+			}
+			trim(r);
+			return r;
+		}
+		std::size_t h=(na+1)/2;
+		std::size_t nb0=std::min(h,nb);
+		Limbs z0=mulSpan(a,h,b,nb0);
+		Limbs z2=mulSpan(a+h,na-h,b+nb0,nb-nb0);
+		Limbs sa=addSpan(a,h,a+h,na-h);
+		Limbs sb=addSpan(b,nb0,b+nb0,nb-nb0);
+		Limbs z1=mulSpan(sa.data(),sa.size(),sb.data(),sb.size());
+		subInPlace(z1,z0.data(),z0.size());
+		subInPlace(z1,z2.data(),z2.size());
+		Limbs r(na+nb,0);
+		addAt(r,z0.data(),z0.size(),0);
+		addAt(r,z1.data(),z1.size(),h);
+		addAt(r,z2.data(),z2.size(),2*h);
+		trim(r);
+		return r;
+	}
+
+	Limbs mulLimbs(const Limbs& a,const Limbs& b)
+	{
+		return mulSpan(a.data(),a.size(),b.data(),b.size());
+	}
+
+	Limbs addLimbs(const Limbs& a,const Limbs& b)
+	{
+		return addSpan(a.data(),a.size(),b.data(),b.size());
+	}
+
+	Limbs shiftRight(const Limbs& a,std::size_t bits)
+	{
+		std::size_t words=bits/64;
+		int shift=static_cast<int>(bits%64);
+		if(words>=a.size())
+			return Limbs();
+		Limbs r(a.size()-words);
+		for(std::size_t i=0;i<r.size();i++)
+		{
+			Limb lo=a[i+words]>>shift;
+			Limb hi=(shift!=0 && i+words+1<a.size()) ? a[i+words+1]<<(64-shift) : 0;
+			r[i]=lo|hi;
+		}
+		trim(r);
+		return r;
+	}
+
+	//topBits() returns the 64 bits of a starting at bit position shift.
+	Limb topBits(const Limbs& a,std::size_t shift)
+	{
+		std::size_t word=shift/64;
+		int bit=static_cast<int>(shift%64);
+		if(word>=a.size())
+			return 0;
+		Limb lo=a[word]>>bit;
+		Limb hi=(bit!=0 && word+1<a.size()) ? a[word+1]<<(64-bit) : 0;
+		return lo|hi;
+	}
+
+	//divLimb() divides a by a single limb d, stores the quotient in q and returns the remainder.
+	Limb divLimb(const Limb* a,std::size_t na,Limb d,Limbs& q)
+	{
+		q.assign(na,0);
+		Limb rem=0;
+		for(std::size_t i=na;i-->0;)
+		{
+			DLimb cur=(static_cast<DLimb>(rem)<<64)|a[i];
+			q[i]=static_cast<Limb>(cur/d);
+			rem=static_cast<Limb>(cur%d);
+		}
+		trim(q);
+		return rem;
+	}
+
+	//divModSpan() computes q=a/b and r=a%b with Knuth's Algorithm D (TAOCP 4.3.1).
+	//The divisor is normalized so that its top bit is set, which makes every estimated quotient digit at most two too large.
+	void divModSpan(const Limb* a,std::size_t na,const Limb* b,std::size_t nb,Limbs& q,Limbs& r)
+	{
+		na=trimmedSize(a,na);
+		nb=trimmedSize(b,nb);
+		if(compareSpan(a,na,b,nb)<0)
+		{
+			q.clear();
+			r.assign(a,a+na);
+			return;
+		}
+		if(nb==1)
+		{
+			Limb rem=divLimb(a,na,b[0],q);
+			r.assign(1,rem);
+			trim(r);
+			return;
+		}
+		int s=__builtin_clzll(b[nb-1]);
+		Limbs v(nb),u(na+1);
+		for(std::size_t i=nb;i-->0;)
+			v[i]=(b[i]<<s) | ((s!=0 && i>0) ? b[i-1]>>(64-s) : 0);
+		u[na]=(s!=0) ? a[na-1]>>(64-s) : 0;
+		for(std::size_t i=na;i-->0;)
+			u[i]=(a[i]<<s) | ((s!=0 && i>0) ? a[i-1]>>(64-s) : 0);
+		q.assign(na-nb+1,0);
+		for(std::size_t j=na-nb+1;j-->0;)
+		{
+			DLimb num=(static_cast<DLimb>(u[j+nb])<<64)|u[j+nb-1];
+			DLimb qhat=num/v[nb-1];
+			DLimb rhat=num%v[nb-1];
+			while((qhat>>64)!=0 || qhat*v[nb-2]>((rhat<<64)|u[j+nb-2]))
+			{
+				qhat--;
+				rhat+=v[nb-1];
+				if((rhat>>64)!=0)
+					break;
+			}
+			Limb borrow=0,carry=0;
+			for(std::size_t i=0;i<nb;i++)
+			{
+				DLimb product=qhat*v[i]+carry;
+				carry=static_cast<Limb>(product>>64);
+				Limb low=static_cast<Limb>(product);
+				Limb ui=u[i+j];
+				Limb t=ui-low;
+				Limb borrowOut=(ui<low) || (t<borrow);
+				u[i+j]=t-borrow;
+				borrow=borrowOut;
+			}
+			Limb top=u[j+nb];
+			Limb t=top-carry;
+			bool negative=(top<carry) || (t<borrow);
+			u[j+nb]=t-borrow;
+			if(negative)
+			{
+				qhat--;
+				Limb c=0;
+				for(std::size_t i=0;i<nb;i++)
+				{
+					DLimb sum=static_cast<DLimb>(u[i+j])+v[i]+c;
+					u[i+j]=static_cast<Limb>(sum);
+					c=static_cast<Limb>(sum>>64);
+				}
+				u[j+nb]+=c;
+			}
+			q[j]=static_cast<Limb>(qhat);
+		}
+		r.assign(nb,0);
+		for(std::size_t i=0;i<nb;i++)
+			r[i]=(u[i]>>s) | (s!=0 ? u[i+1]<<(64-s) : 0);
+		trim(q);
+		trim(r);
+	}
+
+	void divModLimbs(const Limbs& a,const Limbs& b,Limbs& q,Limbs& r)
+	{
+		divModSpan(a.data(),a.size(),b.data(),b.size(),q,r);
+	}
+
+	//divExactSpan() computes q=a/b for a divisible by b with Jebelean's exact division, from the least significant limb up.
+	//Once the common trailing zero bits are shifted out b is odd, and every quotient limb is the low limb of the remainder times the inverse of b[0] modulo 2^64.
+	//Only the limbs below the length of the quotient are ever updated, so the cost is about half that of a product of the quotient and b,
+	//and no quotient digit has to be estimated with a 128 bit division as in Algorithm D.
+	void divExactSpan(const Limb* a,std::size_t na,const Limb* b,std::size_t nb,Limbs& q)
+	{
+		na=trimmedSize(a,na);
+		nb=trimmedSize(b,nb);
+		std::size_t zeros=0;
+		while(b[zeros]==0)
+			zeros++;
+		if(na<=zeros)
+		{
+			q.clear();
+			return;
+		}
+		int s=__builtin_ctzll(b[zeros]);
+		a+=zeros;
+		na-=zeros;
+		b+=zeros;
+		nb-=zeros;
+		std::size_t nq=(na>=nb) ? na-nb+1 : 0;
+		if(nq==0)
+		{
+			q.clear();
+			return;
+		}
+		//r holds the nq low limbs of a>>s and v the shifted divisor, which keeps one more limb to feed its top limb.
+		Limbs r(nq),v(std::min(nb,nq));
+		for(std::size_t i=0;i<nq;i++)
+			r[i]=(a[i]>>s) | ((s!=0 && i+1<na) ? a[i+1]<<(64-s) : 0);
+		for(std::size_t i=0;i<v.size();i++)
+			v[i]=(b[i]>>s) | ((s!=0 && i+1<nb) ? b[i+1]<<(64-s) : 0);
+		//Newton's iteration doubles the number of correct low bits of the inverse: 3 bits for x=v0, then 6, 12, 24, 48 and 96.
+		Limb inverse=v[0];
+		for(int k=0;k<5;k++)
+			inverse*=2-v[0]*inverse;
+		q.assign(nq,0);
+		for(std::size_t i=0;i<nq;i++)
+		{
+			Limb qi=r[i]*inverse;
+			q[i]=qi;
+			Limb carry=0;
+			std::size_t end=std::min(v.size(),nq-i);
+			for(std::size_t j=0;j<end;j++)
+			{
+				DLimb product=static_cast<DLimb>(qi)*v[j]+carry;
+				Limb low=static_cast<Limb>(product);
+				carry=static_cast<Limb>(product>>64)+(r[i+j]<low);
+				r[i+j]-=low;
+			}
+			for(std::size_t j=i+end;j<nq && carry!=0;j++)
+			{
+				Limb t=r[j];
+				r[j]=t-carry;
+				carry=(t<carry);
+			}
+		}
+		trim(q);
+	}
+
+
+	//Half-GCD
+	//A run of Euclid steps (A,B) -> (B,A-qB) is recorded as the matrix M=E(q1)E(q2)...E(qk) with E(q)=[[q,1],[1,0]], so that (A,B)=M(A',B').
+	//M has non negative entries and determinant (-1)^k.
+	//The quotients of a pair are determined by its leading bits: the top L bits of A and B give the correct quotients until the remainders fall to about L/2 bits.
+	//halfReduce() uses that twice recursively on the top halves, so a reduction by n bits costs O(M(n) log n) instead of O(n^2).
+	//Every matrix computed from truncated operands is verified on the full operands before it is used, so a wrong quotient can only cost time, never correctness.
+
+	struct Matrix
+	{
+		Limbs m11,m12,m21,m22;
+		bool odd;	//The determinant is -1 when odd is true
+
+		Matrix() : m11(1,1),m12(),m21(),m22(1,1),odd(false) {}
+
+		bool isIdentity() const
+		{
+			return !odd && m12.empty() && m21.empty() && m11.size()==1 && m11[0]==1 && m22.size()==1 && m22[0]==1;
+		}
+	};
+
+	//multiply() returns the product M*N.
+	Matrix multiply(const Matrix& M,const Matrix& N)
+	{
+		Matrix R;
+		R.m11=addLimbs(mulLimbs(M.m11,N.m11),mulLimbs(M.m12,N.m21));
+		R.m12=addLimbs(mulLimbs(M.m11,N.m12),mulLimbs(M.m12,N.m22));
+		R.m21=addLimbs(mulLimbs(M.m21,N.m11),mulLimbs(M.m22,N.m21));
+		R.m22=addLimbs(mulLimbs(M.m21,N.m12),mulLimbs(M.m22,N.m22));
+		R.odd=(M.odd!=N.odd);
+		return R;
+	}
+
+	//multiplyStep() replaces M by M*E(q) for one exact Euclid step.
+	void multiplyStep(Matrix& M,const Limbs& q)
+	{
+		Limbs m11=addLimbs(mulLimbs(M.m11,q),M.m12);
+		Limbs m21=addLimbs(mulLimbs(M.m21,q),M.m22);
+		M.m12.swap(M.m11);
+		M.m11.swap(m11);
+		M.m22.swap(M.m21);
+		M.m21.swap(m21);
+		M.odd=!M.odd;
+	}
+
+	//combine() returns x*X+y*Y for single limb cofactors of opposite signs whose combination is known to be non negative.
+	Limbs combine(std::int64_t x,const Limbs& X,std::int64_t y,const Limbs& Y)
+	{
+		Limb mx=x<0 ? 0-static_cast<Limb>(x) : static_cast<Limb>(x);
+		Limb my=y<0 ? 0-static_cast<Limb>(y) : static_cast<Limb>(y);
+		Limbs px=mulLimb(X.data(),X.size(),mx);
+		Limbs py=mulLimb(Y.data(),Y.size(),my);
+		if(x>=0 && y>=0)
+			return addLimbs(px,py);
+		if(x>=0)
+		{
+			subInPlace(px,py.data(),py.size());
+			return px;
+		}
+		subInPlace(py,px.data(),px.size());
+		return py;
+	}
+
+	//applyInverse() computes (A',B')=M^-1(A,B) on the full operands.
+	//It returns false, leaving A2 and B2 unspecified, unless A'>B'>=0, i.e. unless the quotients recorded in M are the true Euclid quotients of (A,B).
+	bool applyInverse(const Matrix& M,const Limbs& A,const Limbs& B,Limbs& A2,Limbs& B2)
+	{
+		Limbs p22=mulLimbs(M.m22,A),p12=mulLimbs(M.m12,B);
+		Limbs p11=mulLimbs(M.m11,B),p21=mulLimbs(M.m21,A);
+		//Even determinant: A'=m22*A-m12*B, B'=m11*B-m21*A. Odd determinant: both signs are reversed.
+		Limbs& a1=M.odd ? p12 : p22;
+		Limbs& a2=M.odd ? p22 : p12;
+		Limbs& b1=M.odd ? p21 : p11;
+		Limbs& b2=M.odd ? p11 : p21;
+		if(compareLimbs(a1,a2)<0 || compareLimbs(b1,b2)<0)
+			return false;
+		subInPlace(a1,a2.data(),a2.size());
+		subInPlace(b1,b2.data(),b2.size());
+		if(compareLimbs(a1,b1)<=0)
+			return false;
+		A2.swap(a1);
+		B2.swap(b1);
+		return true;
+	}
+
+	enum LehmerResult
+	{
+		eLehmerStepped,	//At least one Euclid step was applied
+		eLehmerReachedTarget	//The next step would take B below 2^target
+	};
+
+	//lehmerStep() applies one batch of Euclid steps to A>B>0 (Knuth, Algorithm 4.5.2L).
+	//The quotients are computed on the leading 62 bits in 64 bit registers and the batch is applied with single limb multiplications.
+	//If no quotient can be certified from the leading bits, one exact division step is made instead.
+	//Steps that would take B below 2^target are not taken. If M is not null, the steps are accumulated into it.
+	LehmerResult lehmerStep(Limbs& A,Limbs& B,std::size_t target,Matrix* M)
+	{
+		std::size_t n=bitLengthLimbs(A);
+		std::size_t shift=n>62 ? n-62 : 0;
+		std::int64_t x=static_cast<std::int64_t>(topBits(A,shift));
+		std::int64_t y=static_cast<std::int64_t>(topBits(B,shift));
+		std::int64_t limit=(target>shift) ? (static_cast<std::int64_t>(1)<<(target-shift)) : 0;
+		std::int64_t a=1,b=0,c=0,d=1;
+		bool odd=false,limited=false;
+		while(y+c>0 && y+d>0)
+		{
+			std::int64_t q=FractionGCD::lehmerQuotient(x+a,y+c);
+			if(q!=FractionGCD::lehmerQuotient(x+b,y+d))
+				break;
+			std::int64_t t=x-q*y;
+			if(t<limit)
+			{
+				limited=true;
+				break;
+			}
+			std::int64_t T=a-q*c; a=c; c=T;
+			T=b-q*d; b=d; d=T;
+			x=y; y=t;
+			odd=!odd;
+		}
+		if(b==0)
+		{
+			if(limited)
+				return eLehmerReachedTarget;
+			Limbs q,r;
+			divModLimbs(A,B,q,r);
+			if(M)
+				multiplyStep(*M,q);
+			A.swap(B);
+			B.swap(r);
+			return eLehmerStepped;
+		}
+		Limbs A2=combine(a,A,b,B);
+		Limbs B2=combine(c,A,d,B);
+		A.swap(A2);
+		B.swap(B2);
+		if(M)
+		{
+			//The batch maps (A,B) to [[a,b],[c,d]](A,B); its inverse [[|d|,|b|],[|c|,|a|]] is the product of the E(q) of the batch.
+			Matrix S;
+			S.m11.assign(1,d<0 ? 0-static_cast<Limb>(d) : static_cast<Limb>(d));
+			S.m12.assign(1,b<0 ? 0-static_cast<Limb>(b) : static_cast<Limb>(b));
+			S.m21.assign(1,c<0 ? 0-static_cast<Limb>(c) : static_cast<Limb>(c));
+			S.m22.assign(1,a<0 ? 0-static_cast<Limb>(a) : static_cast<Limb>(a));
+			trim(S.m11); trim(S.m12); trim(S.m21); trim(S.m22);
+			S.odd=odd;
+			*M=multiply(*M,S);
+		}
+		return eLehmerStepped;
+	}
+
+	void halfReduce(Limbs& A,Limbs& B,std::size_t target,Matrix* M);
+
+	//reduceTop() reduces the pair (A>>shift,B>>shift) until its B falls to subTarget bits, and applies the recorded steps to (A,B) if they verify.
+	void reduceTop(Limbs& A,Limbs& B,std::size_t shift,std::size_t subTarget,Matrix* M)
+	{
+		Limbs A1=shiftRight(A,shift),B1=shiftRight(B,shift);
+		if(compareLimbs(A1,B1)<=0 || bitLengthLimbs(B1)<=subTarget)
+			return;
+		Matrix M1;
+		halfReduce(A1,B1,subTarget,&M1);
+		if(M1.isIdentity())
+			return;
+		Limbs A2,B2;
+		if(!applyInverse(M1,A,B,A2,B2))
+			return;
+		A.swap(A2);
+		B.swap(B2);
+		if(M)
+			*M=multiply(*M,M1);
+	}
+
+	//halfReduce() applies Euclid steps to A>B until B has at most target bits, recording them in M if it is not null.
+	//With gap the number of bits to remove, the first half of the gap is removed using only the top gap bits,
+	//the second half using the top 2*(remaining gap) bits, and the few bits left by the safety margins with Lehmer steps.
+	void halfReduce(Limbs& A,Limbs& B,std::size_t target,Matrix* M)
+	{
+		if(bitLengthLimbs(B)<=target)
+			return;
+		std::size_t gap=bitLengthLimbs(A)-target;
+		if(gap>sc_nHalfGcdLeafBits)
+		{
+			reduceTop(A,B,target,gap/2+sc_nHalfGcdMargin,M);
+			if(bitLengthLimbs(B)<=target)
+				return;
+			std::size_t gap2=bitLengthLimbs(A)-target;
+			if(gap2>sc_nHalfGcdLeafBits && target>gap2)
+				reduceTop(A,B,target-gap2,gap2+sc_nHalfGcdMargin,M);
+		}
+		while(!B.empty() && bitLengthLimbs(B)>target)
+		{
+			if(lehmerStep(A,B,target,M)==eLehmerReachedTarget)
+				break;
+		}
+	}
+
+	//gcdLimbs() returns the GCD of two magnitudes.
+	Limbs gcdLimbs(Limbs A,Limbs B)
+	{
+		if(compareLimbs(A,B)<0)
+			A.swap(B);
+		while(!B.empty())
+		{
+			if(A.size()<=2)
+			{
+				unsigned __int128 a=A[0],b=B[0];
+				if(A.size()==2)
+					a|=static_cast<unsigned __int128>(A[1])<<64;
+				if(B.size()==2)
+					b|=static_cast<unsigned __int128>(B[1])<<64;
+				unsigned __int128 g=FractionGCD::gcd(a,b);
+				Limbs r(2);
+				r[0]=static_cast<Limb>(g);
+				r[1]=static_cast<Limb>(g>>64);
+				trim(r);
+				return r;
+			}
+			if(A.size()>=BIGINTEGER_HALF_GCD_THRESHOLD && B.size()+1>=A.size())
+			{
+				halfReduce(A,B,bitLengthLimbs(A)/2,0);
+				if(B.empty())
+					break;
+				Limbs q,r;
+				divModLimbs(A,B,q,r);
+				A.swap(B);
+				B.swap(r);
+			}
+			else
+			{
+				lehmerStep(A,B,0,0);
+			}
+		}
+		return A;
+	}
+}
+
+//Constructors
+
+BigInteger::BigInteger(long long x)
+: negative(x<0),small(x<0 ? 0-static_cast<Limb>(x) : static_cast<Limb>(x)),limbs()
+{
+}
+
+BigInteger BigInteger::fromMagnitude(unsigned long long magnitude,bool negative)
+{
+	BigInteger r;
+	r.small=magnitude;
+	r.negative=negative && magnitude!=0;
+	return r;
+}
+
+#ifdef __SIZEOF_INT128__
+BigInteger BigInteger::fromInt128(__int128 x)
+{
+	unsigned __int128 m=x<0 ? 0-static_cast<unsigned __int128>(x) : static_cast<unsigned __int128>(x);
+	Limbs l(2);
+	l[0]=static_cast<Limb>(m);
+	l[1]=static_cast<Limb>(m>>64);
+	return fromLimbs(l,x<0);
+}
+#endif
+
+BigInteger BigInteger::fromLimbs(Limbs& magnitude,bool negative)
+{
+	trim(magnitude);
+	BigInteger r;
+	if(magnitude.size()<=1)
+	{
+		r.small=magnitude.empty() ? 0 : magnitude[0];
+		r.negative=negative && r.small!=0;
+		return r;
+	}
+	r.limbs.swap(magnitude);
+	r.negative=negative;
+	return r;
+}
+
+BigInteger BigInteger::fromString(const std::string& text)
+{
+	std::size_t i=0;
+	bool negative=false;
+	if(i<text.size() && (text[i]=='-' || text[i]=='+'))
+	{
+		negative=(text[i]=='-');
+		i++;
+	}
+	if(i==text.size())
+	{
+		throw std::invalid_argument("BigInteger: not a decimal integer: "+text);
+	}
+	Limbs magnitude;
+	while(i<text.size())
+	{
+		std::size_t end=std::min(text.size(),i+sc_nDecimalChunkDigits);
+		Limb chunk=0,scale=1;
+		for(;i<end;i++)
+		{
+			if(text[i]<'0' || text[i]>'9')
+			{
+				throw std::invalid_argument("BigInteger: not a decimal integer: "+text);
+			}
+			chunk=chunk*10+static_cast<Limb>(text[i]-'0');
+			scale*=10;
+		}
+		magnitude=mulLimb(magnitude.data(),magnitude.size(),scale);
+		Limbs c(1,chunk);
+		magnitude=addLimbs(magnitude,c);
+	}
+	return fromLimbs(magnitude,negative);
+}
+
+std::string BigInteger::toString() const
+{
+	if(isSmall())
+	{
+		return (negative ? "-" : "")+std::to_string(small);
+	}
+	std::string digits;
+	Limbs rest(limbs),quotient;
+	while(!rest.empty())
+	{
+		Limb chunk=divLimb(rest.data(),rest.size(),sc_nDecimalChunk,quotient);
+		rest.swap(quotient);
+		for(int k=0;k<sc_nDecimalChunkDigits;k++)
+		{
+			if(rest.empty() && chunk==0)
+				break;
+			digits.push_back(static_cast<char>('0'+chunk%10));
+			chunk/=10;
+		}
+	}
+	if(negative)
+		digits.push_back('-');
+	std::reverse(digits.begin(),digits.end());
+	return digits;
+}
+
+//Queries
+
+std::size_t BigInteger::bitLength() const
+{
+	return bitLengthSpan(data(),size());
+}
+
+bool BigInteger::fitsInt64() const
+{
+	if(!isSmall())
+		return false;
+	return negative ? small<=(static_cast<Limb>(1)<<63) : small<(static_cast<Limb>(1)<<63);
+}
+
+long long BigInteger::toInt64() const
+{
+	return static_cast<long long>(negative ? 0-small : small);
+}
+
+double BigInteger::toDouble() const
+{
+	double m;
+	std::size_t bits=bitLength();
+	if(bits<=64)
+	{
+		m=static_cast<double>(small);
+	}
+	else
+	{
+		m=std::ldexp(static_cast<double>(topBits(limbs,bits-64)),static_cast<int>(bits-64));
+	}
+	return negative ? -m : m;
+}
+
+double BigInteger::frexp(int& exponent) const
+{
+	std::size_t bits=bitLength();
+	exponent=static_cast<int>(bits);
+	if(bits==0)
+		return 0;
+	Limb top=(bits<=64) ? small<<(64-bits) : topBits(limbs,bits-64);
+	double m=std::ldexp(static_cast<double>(top),-64);
+	//Rounding the top 64 bits to a double may carry into the next power of two.
+	if(m==1)
+	{
+		m=0.5;
+		exponent++;
+	}
+	return negative ? -m : m;
+}
+
+//Unary Operators
+
+BigInteger BigInteger::operator-() const
+{
+	BigInteger r(*this);
+	r.negative=!negative && !isZero();
+	return r;
+}
+
+BigInteger BigInteger::abs() const
+{
+	BigInteger r(*this);
+	r.negative=false;
+	return r;
+}
+
+//Binary Arithmetic Operators
+
+BigInteger BigInteger::addSigned(const BigInteger& lhs,const BigInteger& rhs,bool subtract)
+{
+	bool rneg=(rhs.negative!=subtract) && !rhs.isZero();
+	if(lhs.isSmall() && rhs.isSmall())
+	{
+		if(lhs.negative==rneg)
+		{
+			DLimb sum=static_cast<DLimb>(lhs.small)+rhs.small;
+			if((sum>>64)==0)
+				return fromMagnitude(static_cast<Limb>(sum),lhs.negative);
+			Limbs l(2);
+			l[0]=static_cast<Limb>(sum);
+			l[1]=1;
+			return fromLimbs(l,lhs.negative);
+		}
+		if(lhs.small>=rhs.small)
+			return fromMagnitude(lhs.small-rhs.small,lhs.negative);
+		return fromMagnitude(rhs.small-lhs.small,rneg);
+	}
+	if(lhs.negative==rneg)
+	{
+		Limbs sum=addSpan(lhs.data(),lhs.size(),rhs.data(),rhs.size());
+		return fromLimbs(sum,lhs.negative);
+	}
+	int c=compareSpan(lhs.data(),lhs.size(),rhs.data(),rhs.size());
+	if(c==0)
+		return BigInteger();
+	Limbs difference=(c>0) ? subSpan(lhs.data(),lhs.size(),rhs.data(),rhs.size()) : subSpan(rhs.data(),rhs.size(),lhs.data(),lhs.size());
+	return fromLimbs(difference,c>0 ? lhs.negative : rneg);
+}
+
+BigInteger operator+(const BigInteger& lhs,const BigInteger& rhs)
+{
+	return BigInteger::addSigned(lhs,rhs,false);
+}
+
+BigInteger operator-(const BigInteger& lhs,const BigInteger& rhs)
+{
+	return BigInteger::addSigned(lhs,rhs,true);
+}
+
+BigInteger operator*(const BigInteger& lhs,const BigInteger& rhs)
+{
+	bool negative=(lhs.negative!=rhs.negative);
+	if(lhs.isSmall() && rhs.isSmall())
+	{
+		DLimb product=static_cast<DLimb>(lhs.small)*rhs.small;
+		if((product>>64)==0)
+			return BigInteger::fromMagnitude(static_cast<BigInteger::Limb>(product),negative);
+		BigInteger::Limbs l(2);
+		l[0]=static_cast<BigInteger::Limb>(product);
+		l[1]=static_cast<BigInteger::Limb>(product>>64);
+		return BigInteger::fromLimbs(l,negative);
+	}
+	BigInteger::Limbs product=mulSpan(lhs.data(),lhs.size(),rhs.data(),rhs.size());
+	return BigInteger::fromLimbs(product,negative);
+}
+
+void divMod(const BigInteger& lhs,const BigInteger& rhs,BigInteger& quotient,BigInteger& remainder)
+{
+	if(rhs.isZero())
+	{
+		throw std::runtime_error("Math error: Attempted to divide by Zero\n");
+	}
+	bool negative=(lhs.negative!=rhs.negative);
+	if(lhs.isSmall() && rhs.isSmall())
+	{
+		BigInteger::Limb q=lhs.small/rhs.small,r=lhs.small%rhs.small;
+		quotient=BigInteger::fromMagnitude(q,negative);
+		remainder=BigInteger::fromMagnitude(r,lhs.negative);
+		return;
+	}
+	BigInteger::Limbs q,r;
+	divModSpan(lhs.data(),lhs.size(),rhs.data(),rhs.size(),q,r);
+	bool lneg=lhs.negative;
+	quotient=BigInteger::fromLimbs(q,negative);
+	remainder=BigInteger::fromLimbs(r,lneg);
+}
+
+BigInteger divExact(const BigInteger& lhs,const BigInteger& rhs)
+{
+	if(rhs.isZero())
+	{
+		throw std::runtime_error("Math error: Attempted to divide by Zero\n");
+	}
+	bool negative=(lhs.negative!=rhs.negative);
+	if(lhs.isSmall() && rhs.isSmall())
+		return BigInteger::fromMagnitude(lhs.small/rhs.small,negative);
+	BigInteger::Limbs q;
+	divExactSpan(lhs.data(),lhs.size(),rhs.data(),rhs.size(),q);
+	return BigInteger::fromLimbs(q,negative);
+}
+
+BigInteger operator/(const BigInteger& lhs,const BigInteger& rhs)
+{
+	BigInteger q,r;
+	divMod(lhs,rhs,q,r);
+	return q;
+}
+
+BigInteger operator%(const BigInteger& lhs,const BigInteger& rhs)
+{
+	BigInteger q,r;
+	divMod(lhs,rhs,q,r);
+	return r;
+}
+
+BigInteger BigInteger::gcd(const BigInteger& lhs,const BigInteger& rhs)
+{
+	if(lhs.isSmall() && rhs.isSmall())
+	{
+		return fromMagnitude(FractionGCD::gcd<std::uint64_t>(lhs.small,rhs.small),false);
+	}
+	if(lhs.isZero())
+		return rhs.abs();
+	if(rhs.isZero())
+		return lhs.abs();
+	//One single limb operand reduces the other to a single limb with one short division.
+	if(lhs.isSmall() || rhs.isSmall())
+	{
+		const BigInteger& big=lhs.isSmall() ? rhs : lhs;
+		Limb d=lhs.isSmall() ? lhs.small : rhs.small;
+		Limbs q;
+		Limb r=divLimb(big.limbs.data(),big.limbs.size(),d,q);
+		return fromMagnitude(FractionGCD::gcd<std::uint64_t>(d,r),false);
+	}
+	Limbs g=gcdLimbs(lhs.limbs,rhs.limbs);
+	return fromLimbs(g,false);
+}
+
+//Binary Relational Operators
+
+int compare(const BigInteger& lhs,const BigInteger& rhs)
+{
+	if(lhs.negative!=rhs.negative)
+		return lhs.negative ? -1 : 1;
+	int c;
+	if(lhs.isSmall() && rhs.isSmall())
+		c=(lhs.small<rhs.small) ? -1 : (lhs.small>rhs.small ? 1 : 0);
+	else
+		c=compareSpan(lhs.data(),lhs.size(),rhs.data(),rhs.size());
+	return lhs.negative ? -c : c;
+}
+
+//Input/Output Operators
+
+std::ostream& operator<<(std::ostream& OUT,const BigInteger& rhs)
+{
+	OUT << rhs.toString();
+	return OUT;
+}
+
+std::istream& operator>>(std::istream& IN,BigInteger& rhs)
+{
+	std::string token;
+	if(IN >> token)
+	{
+		try
+		{
+			rhs=BigInteger::fromString(token);
+		}
+		catch(const std::invalid_argument&)
+		{
+			IN.setstate(std::ios::failbit);
+		}
+	}
+	return IN;
+}
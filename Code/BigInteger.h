@@ -0,0 +1,160 @@
+#ifndef __BIG_INTEGER_H__
+#define __BIG_INTEGER_H__
+
+#include <cstddef>
+#include <cstdint>
+#include <iostream>
+#include <string>
+#include <vector>
+
+#include "FractionArena.h"
+
+class BigInteger
+{
+public:
+	//Limb is the digit of the magnitude. The magnitude is stored in base 2^64.
+	//The limbs of a large magnitude are allocated through ArenaAllocator, so they come from the FractionArena of the thread when one is installed.
+	typedef std::uint64_t Limb;
+	typedef std::vector<Limb,ArenaAllocator<Limb> > Limbs;
+
+private:
+	//The data members have been made private for information hiding.
+	//A magnitude below 2^64 is stored inline in small and limbs stays empty, so such values never allocate.
+	//A larger magnitude is stored in limbs, least significant limb first, with at least two limbs and a non zero top limb.
+	//Zero is never negative.
+
+	bool negative;	//Sign
+	Limb small;	//Magnitude when limbs is empty
+	Limbs limbs;	//Magnitude when it does not fit in one limb
+
+	//data() and size() view the magnitude as a span of limbs whatever its representation.
+	//A zero magnitude has no limbs.
+	const Limb* data() const {return limbs.empty() ? &small : limbs.data();}
+	std::size_t size() const {return limbs.empty() ? (small!=0 ? 1 : 0) : limbs.size();}
+
+	//fromLimbs(Limbs&,bool) builds a BigInteger from a magnitude that may have leading zero limbs.
+	//A magnitude that fits in one limb is moved to the inline representation.
+	static BigInteger fromLimbs(Limbs&,bool);
+
+	//addSigned(const BigInteger&,const BigInteger&,bool) adds or subtracts rhs to lhs without copying rhs.
+	//It is the common implementation of the binary plus and minus operators.
+	static BigInteger addSigned(const BigInteger&,const BigInteger&,bool);
+
+public:
+
+	//Constructors
+
+	//This is a Constructor of the BigInteger class from a built-in signed integer.
+	//It never allocates.
+	BigInteger(long long x=0);
+
+	//fromMagnitude(unsigned long long,bool) returns the BigInteger with the given magnitude and sign.
+	static BigInteger fromMagnitude(unsigned long long,bool);
+
+#ifdef __SIZEOF_INT128__
+	//fromInt128(__int128) returns the BigInteger equal to a 128 bit integer.
+	static BigInteger fromInt128(__int128);
+#endif
+
+	//fromString(const std::string&) parses an optionally signed decimal integer.
+	//It throws std::invalid_argument if the string is not a decimal integer.
+	static BigInteger fromString(const std::string&);
+
+	//toString() returns the decimal representation of the BigInteger.
+	std::string toString() const;
+
+
+	//Queries
+
+	//isSmall() returns true if the magnitude is stored inline, i.e. it is below 2^64.
+	bool isSmall() const {return limbs.empty();}
+
+	//isZero() returns true if the BigInteger is zero.
+	bool isZero() const {return limbs.empty() && small==0;}
+
+	//isNegative() returns true if the BigInteger is below zero.
+	bool isNegative() const {return negative;}
+
+	//sign() returns -1, 0 or 1.
+	int sign() const {return isZero() ? 0 : (negative ? -1 : 1);}
+
+	//bitLength() returns the number of significant bits of the magnitude. It is 0 for zero.
+	std::size_t bitLength() const;
+
+	//limb(i) returns the limb i of the magnitude, least significant first, and 0 above the top limb.
+	Limb limb(std::size_t i) const {return i<size() ? data()[i] : 0;}
+
+	//fitsInt64() returns true if the value can be converted to long long without loss.
+	bool fitsInt64() const;
+
+	//toInt64() returns the value as long long. It is only meaningful when fitsInt64() is true.
+	long long toInt64() const;
+
+	//toDouble() returns the nearest double (truncated to 64 significant bits first).
+	double toDouble() const;
+
+	//frexp(int&) splits the value like std::frexp: it returns m with 0.5<=|m|<1 and sets e so that the value is about m*2^e.
+	//Unlike toDouble() it does not overflow for magnitudes of 2^1024 and above. Zero returns 0 and sets e to 0.
+	double frexp(int&) const;
+
+
+	//Unary Operators
+
+	//-B1 <-------> B1.operator-()
+	BigInteger operator-() const;
+
+	//abs() returns the magnitude as a non negative BigInteger.
+	BigInteger abs() const;
+
+
+	//Binary Arithmetic Operators
+	//Products of operands above a threshold size use Karatsuba multiplication.
+	//Division truncates towards zero and the remainder has the sign of the dividend, as for the built-in types.
+	//Division by zero throws std::runtime_error.
+
+	friend BigInteger operator+(const BigInteger&,const BigInteger&);
+	friend BigInteger operator-(const BigInteger&,const BigInteger&);
+	friend BigInteger operator*(const BigInteger&,const BigInteger&);
+	friend BigInteger operator/(const BigInteger&,const BigInteger&);
+	friend BigInteger operator%(const BigInteger&,const BigInteger&);
+
+	//divMod(B1,B2,Q,R) computes the quotient and the remainder of one division at once.
+	friend void divMod(const BigInteger&,const BigInteger&,BigInteger&,BigInteger&);
+
+	//divExact(B1,B2) returns B1/B2 when B2 is known to divide B1, e.g. to cancel a gcd or in fraction-free elimination.
+	//It is faster than operator/ because it needs no quotient estimation. The result is unspecified if the division is not exact.
+	friend BigInteger divExact(const BigInteger&,const BigInteger&);
+
+	//gcd(B1,B2) returns the non negative Greatest Common Divisor of two BigIntegers.
+	//Small operands use the binary GCD engine of FractionGCD.h.
+	//Large operands use Lehmer's algorithm and, above a threshold size, a recursive half-GCD whose matrix products use Karatsuba multiplication.
+	static BigInteger gcd(const BigInteger&,const BigInteger&);
+
+
+	//Binary Relational Operators
+
+	//compare(B1,B2) returns a negative value, zero or a positive value if B1 is less than, equal to or greater than B2.
+	friend int compare(const BigInteger&,const BigInteger&);
+
+	friend bool operator==(const BigInteger& lhs,const BigInteger& rhs) {return compare(lhs,rhs)==0;}
+	friend bool operator!=(const BigInteger& lhs,const BigInteger& rhs) {return compare(lhs,rhs)!=0;}
+	friend bool operator<(const BigInteger& lhs,const BigInteger& rhs) {return compare(lhs,rhs)<0;}
+	friend bool operator<=(const BigInteger& lhs,const BigInteger& rhs) {return compare(lhs,rhs)<=0;}
+	friend bool operator>(const BigInteger& lhs,const BigInteger& rhs) {return compare(lhs,rhs)>0;}
+	friend bool operator>=(const BigInteger& lhs,const BigInteger& rhs) {return compare(lhs,rhs)>=0;}
+
+
+	//Input/Output Operators
+
+	//std::cout << B1 <------> operator<<(cout,B1)
+	friend std::ostream& operator<<(std::ostream&,const BigInteger&);
+
+	//std::cin >> B1 <------> operator>>(cin,B1)
+	friend std::istream& operator>>(std::istream&,BigInteger&);
+};
+
+int compare(const BigInteger&,const BigInteger&);
+void divMod(const BigInteger&,const BigInteger&,BigInteger&,BigInteger&);
+BigInteger divExact(const BigInteger&,const BigInteger&);
+
+#endif // __BIG_INTEGER_H__
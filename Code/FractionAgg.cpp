@@ -0,0 +1,374 @@
+// File: FractionAgg.cpp
+// Contains: int main() of the fraction-agg command line tool
+//
+// fraction-agg reads Fractions from files, or from stdin when no file is given, and prints their exact
+// count, sum, mean, minimum, maximum and, on request, quantiles and the sorted values.
+//
+//     fraction-agg [-t threads] [-q 0.5,0.9,0.99] [--sorted] [--max-distinct n] [file ...]
+//
+// The input is any text of whitespace separated values in a form read by fraction::from_chars: "p/q", "p / q",
+// integers or decimals such as 0.125 or 6.02e3. Values are read as Fraction64. Tokens that are not values, or do
+// not fit, are counted, reported on stderr and skipped.
+//
+// The main thread reads blocks of sc_nBlockBytes cut at line ends into a queue of at most two blocks per worker.
+// The workers parse and reduce whole blocks and merge their results into the totals, so memory stays bounded
+// whatever the length of the input. The sum is exact: every group of 16 values is summed as a pairwise tree of LazyFractions,
+// or of BigFractions if that overflows, and the group and block sums are added as BigFractions.
+// Quantiles and the sorted output need the distinct values and their counts, which are kept up to --max-distinct
+// values (default 2^22); beyond that they are reported as unavailable.
+// Quantiles are nearest-rank: the q quantile of n values is the value of rank ceil(q*n), computed exactly.
+/************ C++ Headers ************************************/
+
+#include <algorithm>
+#include <charconv>
+#include <condition_variable>
+#include <cstdint>
+#include <cstdio>
+#include <cstring>
+#include <deque>
+#include <iostream>
+#include <map>
+#include <mutex>
+#include <stdexcept>
+#include <string>
+#include <thread>
+#include <utility>
+#include <vector>
+using namespace std;
+
+/************ PROJECT Headers ********************************/
+
+#include "BigFraction.h"
+#include "Fraction.h"
+#include "FractionReduce.h"
+#include "LazyFraction.h"
+
+// Size of the blocks handed to the workers
+static const size_t sc_nBlockBytes = 1 << 20;
+
+// BlockQueue passes blocks of text from the reader to the workers.
+// push() waits while the queue is full, which bounds the memory held by blocks that are read but not yet parsed.
+class BlockQueue {
+public:
+	explicit BlockQueue(size_t capacity) : capacity(capacity), closed(false) {}
+
+	void push(string&& block) {
+		unique_lock<mutex> lock(m);
+		notFull.wait(lock, [&]() { return blocks.size() < capacity; });
+		blocks.push_back(std::move(block));
+		notEmpty.notify_one();
+	}
+
+	// pop() returns false once the queue is closed and empty.
+	bool pop(string& block) {
+		unique_lock<mutex> lock(m);
+		notEmpty.wait(lock, [&]() { return !blocks.empty() || closed; });
+		if (blocks.empty())
+			return false;
+		block = std::move(blocks.front());
+		blocks.pop_front();
+		notFull.notify_one();
+		return true;
+	}
+
+	void close() {
+		lock_guard<mutex> lock(m);
+		closed = true;
+		notEmpty.notify_all();
+	}
+
+private:
+	size_t capacity;
+	bool closed;
+	deque<string> blocks;
+	mutex m;
+	condition_variable notFull, notEmpty;
+};
+
+// Totals accumulates the results of all blocks.
+struct Totals {
+	uint64_t count = 0;
+	uint64_t malformed = 0;
+	uint64_t outOfRange = 0;
+	BigFraction sum = BigFraction(0);
+	Fraction64 min, max;
+	map<Fraction64, uint64_t> distinct;	// Value counts, while tracked
+	bool tracking = false;	// Quantiles or the sorted output are requested and distinct holds every value
+	size_t maxDistinct = size_t(1) << 22;
+	mutex m;
+};
+
+static bool IsSpace(char c) {
+	return c == ' ' || c == '\t' || c == '\n' || c == '\r' || c == '\f' || c == '\v';
+}
+
+// Number of values summed as one tree of LazyFractions in BlockSum()
+static const size_t sc_nLazyGroup = 16;
+
+// GroupSum() returns the exact sum of v[first,last) as a pairwise tree of LazyFractions, or of BigFractions if that overflows.
+static BigFraction GroupSum(const vector<Fraction64>& v, size_t first, size_t last) {
+	auto add = [](const auto& a, const auto& b) { return a + b; };
+	try {
+		auto lazy = [&](size_t i) { return LazyFraction64(v[i]); };
+		LazyFraction64 s = fraction::detail::pairwise<LazyFraction64>(first, last, lazy, add);
+		return BigFraction(BigInteger::fromInt128(s.numerator()), BigInteger::fromInt128(s.denominator()));
+	}
+	catch (const overflow_error&) {
+		auto big = [&](size_t i) { return BigFraction(v[i]); };
+		return fraction::detail::pairwise<BigFraction>(first, last, big, add);
+	}
+}
+
+// BlockSum() returns the exact sum of the values of one block.
+// Small groups keep most additions in the lazy 128 bit terms even when the sum of the whole block needs a BigFraction,
+// and the group sums are added as a pairwise tree so that the BigFraction operands stay of similar size.
+static BigFraction BlockSum(const vector<Fraction64>& v) {
+	size_t groups = (v.size() + sc_nLazyGroup - 1) / sc_nLazyGroup;
+	auto group = [&](size_t k) { return GroupSum(v, k * sc_nLazyGroup, min(v.size(), (k + 1) * sc_nLazyGroup)); };
+	auto add = [](const BigFraction& a, const BigFraction& b) { return a + b; };
+	return fraction::detail::pairwise<BigFraction>(0, groups, group, add);
+}
+
+// ProcessBlock() parses one block and merges its count, sum, extremes and value counts into the totals.
+static void ProcessBlock(const string& text, vector<Fraction64>& values, Totals& totals) {
+	values.clear();
+	uint64_t malformed = 0, outOfRange = 0;
+	const char* p = text.data();
+	const char* end = p + text.size();
+	for (;;) {
+		while (p < end && IsSpace(*p))
+			p++;
+		if (p == end)
+			break;
+		Fraction64 f;
+		from_chars_result r = fraction::from_chars(p, end, f);
+		if (r.ec == errc() && (r.ptr == end || IsSpace(*r.ptr))) {
+			values.push_back(f);
+			p = r.ptr;
+			continue;
+		}
+		if (r.ec == errc::result_out_of_range && (r.ptr == end || IsSpace(*r.ptr)))
+			outOfRange++;
+		else
+			malformed++;
+		while (p < end && !IsSpace(*p))
+			p++;
+	}
+	if (values.empty() && malformed == 0 && outOfRange == 0)
+		return;
+
+	BigFraction sum = values.empty() ? BigFraction(0) : BlockSum(values);
+	Fraction64 lo, hi;
+	vector<pair<Fraction64, uint64_t> > runs;
+	bool tracking;
+	{
+		lock_guard<mutex> lock(totals.m);
+		tracking = totals.tracking;
+	}
+	if (tracking) {
+		sort(values.begin(), values.end());
+		for (size_t i = 0; i < values.size(); i++) {
+			if (runs.empty() || runs.back().first != values[i])
+				runs.push_back(make_pair(values[i], uint64_t(0)));
+			runs.back().second++;
+		}
+	}
+	if (!values.empty()) {
+		lo = *min_element(values.begin(), values.end());
+		hi = *max_element(values.begin(), values.end());
+	}
+
+	lock_guard<mutex> lock(totals.m);
+	if (!values.empty()) {
+		if (totals.count == 0 || lo < totals.min)
+			totals.min = lo;
+		if (totals.count == 0 || hi > totals.max)
+			totals.max = hi;
+	}
+	totals.count += values.size();
+	totals.malformed += malformed;
+	totals.outOfRange += outOfRange;
+	totals.sum = totals.sum + sum;
+	if (totals.tracking) {
+		auto hint = totals.distinct.begin();
+		for (size_t i = 0; i < runs.size(); i++) {
+			hint = totals.distinct.emplace_hint(hint, runs[i].first, 0);
+			hint->second += runs[i].second;
+		}
+		if (totals.distinct.size() > totals.maxDistinct) {
+			totals.tracking = false;
+			map<Fraction64, uint64_t>().swap(totals.distinct);
+		}
+	}
+}
+
+// ReadInput() cuts a stream into blocks at line ends and queues them.
+// A line longer than a block is cut at its last whitespace instead.
+static void ReadInput(FILE* in, string& carry, BlockQueue& queue) {
+	vector<char> buffer(sc_nBlockBytes);
+	for (;;) {
+		size_t n = fread(buffer.data(), 1, buffer.size(), in);
+		if (n == 0)
+			break;
+		carry.append(buffer.data(), n);
+		size_t cut = carry.find_last_of('\n');
+		if (cut == string::npos && carry.size() >= sc_nBlockBytes) {
+			cut = carry.size();
+			while (cut > 0 && !IsSpace(carry[cut - 1]))
+				cut--;
+			cut = (cut == 0) ? string::npos : cut - 1;
+		}
+		if (cut == string::npos)
+			continue;
+		string rest = carry.substr(cut + 1);
+		carry.resize(cut + 1);
+		queue.push(std::move(carry));
+		carry = std::move(rest);
+	}
+	// The last line of a file ends at the end of the file.
+	carry.push_back('\n');
+}
+
+static void Print(const char* name, const BigFraction& value) {
+	cout << name << '\t' << value << '\t' << value.toDouble() << '\n';
+}
+
+static void Usage() {
+	cerr << "usage: fraction-agg [-t threads] [-q 0.5,0.9,0.99] [--sorted] [--max-distinct n] [file ...]" << endl;
+}
+
+int main(int argc, char** argv) {
+	unsigned threads = thread::hardware_concurrency();
+	vector<pair<string, Fraction64> > quantiles;
+	bool sorted = false;
+	vector<string> files;
+	Totals totals;
+
+	for (int i = 1; i < argc; i++) {
+		string arg = argv[i];
+		if ((arg == "-t" || arg == "-q" || arg == "--max-distinct") && i + 1 == argc) {
+			Usage();
+			return 2;
+		}
+		if (arg == "-t") {
+			threads = static_cast<unsigned>(atoi(argv[++i]));
+		}
+		else if (arg == "--max-distinct") {
+			totals.maxDistinct = static_cast<size_t>(atoll(argv[++i]));
+		}
+		else if (arg == "-q") {
+			// The quantiles are parsed as exact Fractions, so 0.99 is 99/100 and not the nearest double.
+			const char* p = argv[++i];
+			const char* end = p + strlen(p);
+			while (p < end) {
+				Fraction64 q;
+				from_chars_result r = fraction::from_chars(p, end, q);
+				if (r.ec != errc() || (r.ptr != end && *r.ptr != ',') || q < Fraction64(0) || q > Fraction64(1)) {
+					cerr << "fraction-agg: quantiles are values between 0 and 1: " << argv[i] << endl;
+					return 2;
+				}
+				quantiles.push_back(make_pair(string(p, r.ptr), q));
+				p = (r.ptr == end) ? end : r.ptr + 1;
+			}
+		}
+		else if (arg == "--sorted") {
+			sorted = true;
+		}
+		else if (arg == "-h" || arg == "--help") {
+			Usage();
+			return 0;
+		}
+		else {
+			files.push_back(arg);
+		}
+	}
+	if (threads == 0)
+		threads = 1;
+	totals.tracking = sorted || !quantiles.empty();
+
+	BlockQueue queue(2 * threads);
+	vector<thread> workers;
+	for (unsigned t = 0; t < threads; t++) {
+		workers.emplace_back([&]() {
+			string block;
+			vector<Fraction64> values;
+			while (queue.pop(block))
+				ProcessBlock(block, values, totals);
+		});
+	}
+
+	bool readError = false;
+	string carry;
+	if (files.empty())
+		files.push_back("-");
+	for (size_t i = 0; i < files.size(); i++) {
+		FILE* in = (files[i] == "-") ? stdin : fopen(files[i].c_str(), "rb");
+		if (in == nullptr) {
+			cerr << "fraction-agg: cannot open " << files[i] << endl;
+			readError = true;
+			continue;
+		}
+		ReadInput(in, carry, queue);
+		if (ferror(in)) {
+			cerr << "fraction-agg: cannot read " << files[i] << endl;
+			readError = true;
+		}
+		if (in != stdin)
+			fclose(in);
+	}
+	if (!carry.empty())
+		queue.push(std::move(carry));
+	queue.close();
+	for (size_t t = 0; t < workers.size(); t++)
+		workers[t].join();
+
+	cout << "count\t" << totals.count << '\n';
+	Print("sum", totals.sum);
+	if (totals.count > 0) {
+		Print("mean", totals.sum / BigFraction(static_cast<long long>(totals.count)));
+		Print("min", BigFraction(totals.min));
+		Print("max", BigFraction(totals.max));
+	}
+
+	bool incomplete = totals.count > 0 && (sorted || !quantiles.empty()) && !totals.tracking;
+	if (incomplete) {
+		cerr << "fraction-agg: more than " << totals.maxDistinct
+			<< " distinct values, quantiles and sorted output are unavailable (see --max-distinct)" << endl;
+	}
+	else if (totals.count > 0 && !quantiles.empty()) {
+		// The rank ceil(q*n) of q=a/b is (a*n+b-1)/b, at least 1.
+		for (size_t k = 0; k < quantiles.size(); k++) {
+			const Fraction64& q = quantiles[k].second;
+			unsigned __int128 a = static_cast<unsigned __int128>(q.numerator()), b = q.denominator();
+			unsigned __int128 rank = (a * totals.count + b - 1) / b;
+			if (rank == 0)
+				rank = 1;
+			unsigned __int128 seen = 0;
+			for (auto it = totals.distinct.begin(); it != totals.distinct.end(); ++it) {
+				seen += it->second;
+				if (seen >= rank) {
+					cout << 'q' << quantiles[k].first;
+					Print("", BigFraction(it->first));
+					break;
+				}
+			}
+		}
+	}
+	if (totals.count > 0 && sorted && !incomplete) {
+		char text[48];
+		for (auto it = totals.distinct.begin(); it != totals.distinct.end(); ++it) {
+			to_chars_result w = fraction::to_chars(text, text + sizeof(text), it->first);
+			*w.ptr = '\n';
+			for (uint64_t c = 0; c < it->second; c++)
+				cout.write(text, w.ptr + 1 - text);
+		}
+	}
+	cout.flush();
+
+	if (totals.malformed > 0 || totals.outOfRange > 0) {
+		cerr << "fraction-agg: skipped " << totals.malformed << " malformed and "
+			<< totals.outOfRange << " out of range values" << endl;
+	}
+	return (readError || incomplete || totals.malformed > 0 || totals.outOfRange > 0) ? 1 : 0;
+}
+// End-of-File: FractionAgg.cpp
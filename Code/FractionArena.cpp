@@ -0,0 +1,139 @@
+#include "FractionArena.h"
+
+#include <new>
+#include <stdexcept>
+
+namespace
+{
+	//Arena installed on the thread by the innermost Scope
+	thread_local FractionArena* active=nullptr;
+
+	//Blocks and chunks taken from the heap by the thread
+	thread_local std::size_t heapCount=0;
+}
+
+//Constructor
+FractionArena::FractionArena()
+: chunk(0),next(nullptr),end(nullptr),freeList(),live(0),served(0)
+{
+}
+
+//Destructor
+FractionArena::~FractionArena()
+{
+	for(char* c : chunks)
+		::operator delete(c);
+}
+
+//Reset
+//The chunks are kept, so the next requests carve the same memory again.
+void FractionArena::reset()
+{
+	if(live!=0)
+	{
+		throw std::logic_error("FractionArena: reset() while blocks are in use");
+	}
+	for(void*& f : freeList)
+		f=nullptr;
+	chunk=0;
+	next=chunks.empty() ? nullptr : chunks[0];
+	end=chunks.empty() ? nullptr : chunks[0]+sc_nChunkSize;
+}
+
+//Moving to the next chunk
+//The free space left at the end of the current chunk is smaller than the block and is not used.
+void FractionArena::grow()
+{
+	if(next!=nullptr)
+		chunk++;
+	if(chunk==chunks.size())
+	{
+		chunks.push_back(static_cast<char*>(::operator new(sc_nChunkSize)));
+		heapCount++;
+	}
+	next=chunks[chunk];
+	end=next+sc_nChunkSize;
+}
+
+//Taking a block
+FractionArena::Header* FractionArena::take(std::size_t sizeClass)
+{
+	Header* h;
+	if(freeList[sizeClass]!=nullptr)
+	{
+		h=static_cast<Header*>(freeList[sizeClass]);
+		freeList[sizeClass]=*reinterpret_cast<void**>(h+1);
+	}
+	else
+	{
+		std::size_t bytes=static_cast<std::size_t>(32)<<sizeClass;
+		if(static_cast<std::size_t>(end-next)<bytes)
+			grow();
+		h=reinterpret_cast<Header*>(next);
+		next+=bytes;
+	}
+	h->owner=this;
+	h->sizeClass=sizeClass;
+	live++;
+	served++;
+	return h;
+}
+
+//Giving a block back
+void FractionArena::give(Header* h)
+{
+	*reinterpret_cast<void**>(h+1)=freeList[h->sizeClass];
+	freeList[h->sizeClass]=h;
+	live--;
+}
+
+//Scope
+FractionArena::Scope::Scope(FractionArena& a)
+: arena(a),previous(active)
+{
+	active=&a;
+}
+
+FractionArena::Scope::~Scope()
+{
+	active=previous;
+	if(arena.live==0)
+		arena.reset();
+}
+
+FractionArena* FractionArena::current()
+{
+	return active;
+}
+
+std::size_t FractionArena::heapAllocations()
+{
+	return heapCount;
+}
+
+//Allocation
+//The size class is the smallest power of two from 32 bytes that holds the block and its header.
+void* FractionArena::allocate(std::size_t bytes)
+{
+	std::size_t total=bytes+sizeof(Header);
+	FractionArena* a=active;
+	if(a!=nullptr && total<=sc_nLargestBlock)
+	{
+		std::size_t sizeClass=(total<=32) ? 0 : static_cast<std::size_t>(64-__builtin_clzll(static_cast<unsigned long long>(total-1))-5);
+		return a->take(sizeClass)+1;
+	}
+	Header* h=static_cast<Header*>(::operator new(total));
+	h->owner=nullptr;
+	h->sizeClass=0;
+	heapCount++;
+	return h+1;
+}
+
+void FractionArena::deallocate(void* p) noexcept
+{
+	Header* h=static_cast<Header*>(p)-1;
+	if(h->owner!=nullptr)
+		h->owner->give(h);
+	else
+		::operator delete(h);
+}
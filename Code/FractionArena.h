@@ -0,0 +1,154 @@
+#ifndef __FRACTION_ARENA_H__
+#define __FRACTION_ARENA_H__
+
+#include <cstddef>
+#include <vector>
+
+//FractionArena is a pool of memory blocks for the heap-backed number types, given to a thread for the lifetime of a request.
+//
+//Every operator of BigInteger, BigFraction and the types built on them returns a new value, and every intermediate value
+//with more than one limb allocates its magnitude and frees it a few operations later. Their storage uses ArenaAllocator,
+//which takes the blocks from the arena installed on the current thread by a FractionArena::Scope and from the heap when there is none.
+//
+//The arena carves its blocks from chunks of sc_nChunkSize bytes, in size classes of 32 to sc_nLargestBlock bytes,
+//and a freed block goes to the free list of its class, from which the next block of that size is taken without any lock or search.
+//Larger blocks always come from the heap. Each block starts with a small header naming the arena it belongs to,
+//so a block can be freed after its Scope has ended, or while another arena is installed, and still returns to its own arena.
+//
+//An arena and its values belong to one thread, and every value allocated in an arena must be destroyed before the arena itself.
+//reset() makes the whole arena available again at once; the Scope calls it when it ends and none of its blocks are still in use,
+//so a loop of requests, each in its own Scope, runs on the same few chunks.
+//
+//heapAllocations() counts the blocks and chunks taken from the heap by the current thread, for measurements.
+class FractionArena
+{
+public:
+	//Size of the chunks taken from the heap
+	static const std::size_t sc_nChunkSize=64*1024;
+
+	//Largest block served by the arena, header included
+	static const std::size_t sc_nLargestBlock=4096;
+
+private:
+	//The data members have been made private for information hiding.
+
+	//Header precedes every block of ArenaAllocator. owner is 0 for a block of the heap.
+	//It is 16 bytes so that the blocks keep the alignment of operator new.
+	struct Header
+	{
+		FractionArena* owner;
+		std::size_t sizeClass;
+	};
+
+	//The size class c holds blocks of 32<<c bytes.
+	static const std::size_t sc_nClasses=8;
+
+	std::vector<char*> chunks;	//Chunks taken from the heap, in order
+	std::size_t chunk;	//Index of the chunk being carved
+	char* next;	//Free space of the current chunk
+	char* end;
+	void* freeList[sc_nClasses];	//Freed blocks of each class, linked through their first word
+	std::size_t live;	//Blocks in use
+	std::size_t served;	//Blocks given out since the construction
+
+	//take(c) returns a block of the size class c, from its free list or carved from a chunk.
+	Header* take(std::size_t sizeClass);
+
+	//give(h) puts a block back on the free list of its class.
+	void give(Header* h);
+
+	//grow() moves next to the following chunk, reusing the chunks kept by reset().
+	void grow();
+
+public:
+
+	//Constructors
+
+	//This Constructor creates an empty arena. It takes no memory until its first block.
+	FractionArena();
+
+	//The arena cannot be copied, since its blocks point back to it.
+	FractionArena(const FractionArena&)=delete;
+	FractionArena& operator=(const FractionArena&)=delete;
+
+
+	//Destructor
+
+	//The destructor returns every chunk to the heap.
+	~FractionArena();
+
+
+	//Lifetime
+
+	//reset() makes every block of the arena free again and keeps the chunks for the next blocks.
+	//It throws std::logic_error if some blocks are still in use.
+	void reset();
+
+	//Scope installs an arena on the current thread for its lifetime and restores the previous one at its end.
+	//When the Scope ends with no block of the arena in use, it resets the arena.
+	class Scope
+	{
+	private:
+		FractionArena& arena;
+		FractionArena* previous;
+	public:
+		explicit Scope(FractionArena&);
+		~Scope();
+		Scope(const Scope&)=delete;
+		Scope& operator=(const Scope&)=delete;
+	};
+
+
+	//Statistics
+
+	//liveBlocks() is the number of blocks in use, blocks() the number of blocks given out since the construction
+	//and reserved() the number of bytes of the chunks.
+	std::size_t liveBlocks() const {return live;}
+	std::size_t blocks() const {return served;}
+	std::size_t reserved() const {return chunks.size()*sc_nChunkSize;}
+
+	//current() returns the arena installed on the current thread, or 0.
+	static FractionArena* current();
+
+	//heapAllocations() returns the number of blocks and chunks the current thread has taken from the heap through ArenaAllocator.
+	static std::size_t heapAllocations();
+
+
+	//Allocation
+
+	//allocate(bytes) returns a block of at least bytes bytes from the arena of the current thread, or from the heap.
+	//deallocate(p) returns it to the arena it came from, or to the heap.
+	static void* allocate(std::size_t bytes);
+	static void deallocate(void* p) noexcept;
+};
+
+//ArenaAllocator is a std::allocator replacement that allocates through FractionArena.
+//It has no state, so the containers that use it keep their size, and their values can be moved and swapped freely.
+template<typename T>
+struct ArenaAllocator
+{
+	typedef T value_type;
+
+	ArenaAllocator() {}
+
+	template<typename U>
+	ArenaAllocator(const ArenaAllocator<U>&) {}
+
+	T* allocate(std::size_t n)
+	{
+		return static_cast<T*>(FractionArena::allocate(n*sizeof(T)));
+	}
+
+	void deallocate(T* p,std::size_t)
+	{
+		FractionArena::deallocate(p);
+	}
+
+	template<typename U>
+	bool operator==(const ArenaAllocator<U>&) const {return true;}
+
+	template<typename U>
+	bool operator!=(const ArenaAllocator<U>&) const {return false;}
+};
+
+#endif // __FRACTION_ARENA_H__
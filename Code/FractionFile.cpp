@@ -0,0 +1,338 @@
+#include "FractionFile.h"
+
+#include <cstring>
+#include <fstream>
+#include <new>
+#include <stdexcept>
+
+#if defined(__unix__) || defined(__APPLE__)
+#define FRACTION_FILE_MMAP
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+//The fixed encoding is the in-memory layout of the columns, so the format can only be mapped on little endian hosts.
+static_assert(__BYTE_ORDER__==__ORDER_LITTLE_ENDIAN__,"FractionFile needs a little endian host");
+
+namespace
+{
+	//Header is the layout of the first 64 bytes of a file.
+	struct Header
+	{
+		char magic[8];
+		std::uint32_t version;
+		std::uint32_t encoding;
+		std::uint64_t count;
+		std::uint64_t numeratorBytes;
+		std::uint64_t denominatorBytes;
+		std::uint64_t numeratorChecksum;
+		std::uint64_t denominatorChecksum;
+		std::uint64_t headerChecksum;	//Checksum of the 56 bytes before it
+	};
+
+	static_assert(sizeof(Header)==64,"The header takes 64 bytes");
+
+	const char sc_szMagic[8]={'F','R','A','C','T','C','O','L'};
+
+	//Columns start on a 64 byte boundary so that the mapped arrays allow aligned vector loads, like the arrays of a FractionVector.
+	const std::size_t sc_nAlignment=64;
+
+	std::uint64_t padded(std::uint64_t n) {return (n+sc_nAlignment-1)&~static_cast<std::uint64_t>(sc_nAlignment-1);}
+
+	//zigzag() maps small negative numerators to small unsigned values: 0,-1,1,-2,... become 0,1,2,3,...
+	std::uint32_t zigzag(std::int32_t x) {return (static_cast<std::uint32_t>(x)<<1)^static_cast<std::uint32_t>(x>>31);}
+	std::int32_t unzigzag(std::uint32_t u) {return static_cast<std::int32_t>((u>>1)^(0u-(u&1)));}
+
+	//putVarint() appends the LEB128 encoding of x: seven bits per byte, the high bit set on every byte but the last.
+	void putVarint(std::vector<unsigned char>& out,std::uint32_t x)
+	{
+		while(x>=0x80)
+		{
+			out.push_back(static_cast<unsigned char>(x|0x80));
+			x>>=7;
+		}
+		out.push_back(static_cast<unsigned char>(x));
+	}
+
+	//getVarint() decodes one LEB128 value at s and advances s.
+	//It returns false if the encoding runs past end or does not fit in 32 bits.
+	bool getVarint(const unsigned char*& s,const unsigned char* end,std::uint32_t& x)
+	{
+		//Most terms take one or two bytes, which are decoded without the general loop.
+		if(end-s>=2)
+		{
+			if(s[0]<0x80)
+			{
+				x=s[0];
+				s+=1;
+				return true;
+			}
+			if(s[1]<0x80)
+			{
+				x=static_cast<std::uint32_t>(s[0]&0x7F)|(static_cast<std::uint32_t>(s[1])<<7);
+				s+=2;
+				return true;
+			}
+		}
+		x=0;
+		for(int shift=0;shift<35;shift+=7)
+		{
+			if(s==end)
+				return false;
+			unsigned char b=*s++;
+			if(shift==28 && b>0x0F)
+				return false;
+			x|=static_cast<std::uint32_t>(b&0x7F)<<shift;
+			if(b<0x80)
+				return true;
+		}
+		return false;
+	}
+
+	void fail(const std::string& path,const char* what)
+	{
+		throw std::runtime_error("FractionFile: "+path+": "+what);
+	}
+}
+
+std::uint64_t FractionFile::checksum(const unsigned char* s,std::size_t n)
+{
+	std::uint64_t a=n,b=0;
+	std::size_t i=0;
+	for(;i+8<=n;i+=8)
+	{
+		std::uint64_t w;
+		std::memcpy(&w,s+i,8);
+		a+=w;
+		b+=a;
+	}
+	if(i<n)
+	{
+		std::uint64_t w=0;
+		std::memcpy(&w,s+i,n-i);
+		a+=w;
+		b+=a;
+	}
+	return a^((b<<32)|(b>>32));
+}
+
+FractionFile::FractionFile(const std::string& path)
+: data(nullptr),bytes(0),mapped(false),coding(eEncodingFixed),count(0),p(nullptr),q(nullptr)
+{
+	open(path);
+	try
+	{
+		validate(path);
+	}
+	catch(...)
+	{
+		close();
+		throw;
+	}
+}
+
+FractionFile::~FractionFile()
+{
+	close();
+}
+
+void FractionFile::open(const std::string& path)
+{
+#ifdef FRACTION_FILE_MMAP
+	int fd=::open(path.c_str(),O_RDONLY);
+	if(fd<0)
+	{
+		fail(path,"cannot open the file");
+	}
+	struct stat st;
+	if(::fstat(fd,&st)!=0)
+	{
+		::close(fd);
+		fail(path,"cannot read the file size");
+	}
+	bytes=static_cast<std::size_t>(st.st_size);
+	if(bytes==0)
+	{
+		::close(fd);
+		return;
+	}
+	void* m=::mmap(nullptr,bytes,PROT_READ,MAP_PRIVATE,fd,0);
+	::close(fd);
+	if(m==MAP_FAILED)
+	{
+		fail(path,"cannot map the file");
+	}
+	data=static_cast<const unsigned char*>(m);
+	mapped=true;
+#else
+	std::ifstream in(path.c_str(),std::ios::binary|std::ios::ate);
+	if(!in)
+	{
+		fail(path,"cannot open the file");
+	}
+	bytes=static_cast<std::size_t>(in.tellg());
+	in.seekg(0);
+	unsigned char* buffer=static_cast<unsigned char*>(::operator new(bytes+1,std::align_val_t(sc_nAlignment)));
+	data=buffer;
+	if(!in.read(reinterpret_cast<char*>(buffer),static_cast<std::streamsize>(bytes)))
+	{
+		close();
+		fail(path,"cannot read the file");
+	}
+#endif
+}
+
+void FractionFile::close()
+{
+	if(data==nullptr)
+		return;
+#ifdef FRACTION_FILE_MMAP
+	if(mapped)
+		::munmap(const_cast<unsigned char*>(data),bytes);
+#else
+	::operator delete(const_cast<unsigned char*>(data),std::align_val_t(sc_nAlignment));
+#endif
+	data=nullptr;
+}
+
+//The sizes are checked against the file length before any column is touched, so a truncated or forged header cannot read past the mapping.
+void FractionFile::validate(const std::string& path)
+{
+	if(bytes<sizeof(Header))
+	{
+		fail(path,"the file is too short");
+	}
+	Header h;
+	std::memcpy(&h,data,sizeof(Header));
+	if(std::memcmp(h.magic,sc_szMagic,sizeof(sc_szMagic))!=0)
+	{
+		fail(path,"not a FractionFile");
+	}
+	if(checksum(data,sizeof(Header)-sizeof(h.headerChecksum))!=h.headerChecksum)
+	{
+		fail(path,"the header is corrupt");
+	}
+	if(h.version!=sc_nVersion)
+	{
+		fail(path,"unsupported version");
+	}
+	if(h.encoding!=eEncodingFixed && h.encoding!=eEncodingVarint)
+	{
+		fail(path,"unknown encoding");
+	}
+	if(h.numeratorBytes>bytes || h.denominatorBytes>bytes || h.count>bytes)
+	{
+		fail(path,"the file is truncated");
+	}
+	std::uint64_t numeratorOffset=sizeof(Header);
+	std::uint64_t denominatorOffset=numeratorOffset+padded(h.numeratorBytes);
+	if(denominatorOffset+h.denominatorBytes>bytes)
+	{
+		fail(path,"the file is truncated");
+	}
+	const unsigned char* numerators=data+numeratorOffset;
+	const unsigned char* denominators=data+denominatorOffset;
+	if(checksum(numerators,h.numeratorBytes)!=h.numeratorChecksum || checksum(denominators,h.denominatorBytes)!=h.denominatorChecksum)
+	{
+		fail(path,"the columns are corrupt");
+	}
+
+	coding=static_cast<Encoding>(h.encoding);
+	count=static_cast<std::size_t>(h.count);
+	if(coding==eEncodingFixed)
+	{
+		if(h.numeratorBytes!=count*sizeof(Numerator) || h.denominatorBytes!=count*sizeof(Denominator))
+		{
+			fail(path,"the column sizes do not match the count");
+		}
+		p=reinterpret_cast<const Numerator*>(numerators);
+		q=reinterpret_cast<const Denominator*>(denominators);
+		//The checksum only proves that the column is the one written, so a zero denominator is rejected here like in the varint column.
+		for(std::size_t i=0;i<count;i++)
+		{
+			if(q[i]==0)
+			{
+				fail(path,"zero denominator in the fixed column");
+			}
+		}
+		return;
+	}
+
+	decodedNumerators.resize(count);
+	decodedDenominators.resize(count);
+	const unsigned char* s=numerators;
+	const unsigned char* t=denominators;
+	for(std::size_t i=0;i<count;i++)
+	{
+		std::uint32_t m=0,n=0;
+		if(!getVarint(s,numerators+h.numeratorBytes,m) || !getVarint(t,denominators+h.denominatorBytes,n) || n==0)
+		{
+			fail(path,"invalid varint column");
+		}
+		decodedNumerators[i]=unzigzag(m);
+		decodedDenominators[i]=n;
+	}
+	if(s!=numerators+h.numeratorBytes || t!=denominators+h.denominatorBytes)
+	{
+		fail(path,"the column sizes do not match the count");
+	}
+	p=decodedNumerators.data();
+	q=decodedDenominators.data();
+}
+
+void FractionFile::write(const std::string& path,const FractionVector& v,Encoding encoding)
+{
+	std::size_t n=v.size();
+	std::vector<unsigned char> encodedNumerators,encodedDenominators;
+	const unsigned char* numerators=reinterpret_cast<const unsigned char*>(v.numerators());
+	const unsigned char* denominators=reinterpret_cast<const unsigned char*>(v.denominators());
+	std::size_t numeratorBytes=n*sizeof(Numerator),denominatorBytes=n*sizeof(Denominator);
+	if(encoding==eEncodingVarint)
+	{
+		encodedNumerators.reserve(n*2);
+		encodedDenominators.reserve(n*2);
+		for(std::size_t i=0;i<n;i++)
+		{
+			putVarint(encodedNumerators,zigzag(v.numerators()[i]));
+			putVarint(encodedDenominators,v.denominators()[i]);
+		}
+		numerators=encodedNumerators.data();
+		denominators=encodedDenominators.data();
+		numeratorBytes=encodedNumerators.size();
+		denominatorBytes=encodedDenominators.size();
+	}
+
+	Header h;
+	std::memset(&h,0,sizeof(Header));
+	std::memcpy(h.magic,sc_szMagic,sizeof(sc_szMagic));
+	h.version=sc_nVersion;
+	h.encoding=static_cast<std::uint32_t>(encoding);
+	h.count=n;
+	h.numeratorBytes=numeratorBytes;
+	h.denominatorBytes=denominatorBytes;
+	h.numeratorChecksum=checksum(numerators,numeratorBytes);
+	h.denominatorChecksum=checksum(denominators,denominatorBytes);
+	h.headerChecksum=checksum(reinterpret_cast<const unsigned char*>(&h),sizeof(Header)-sizeof(h.headerChecksum));
+
+	static const char zeros[sc_nAlignment]={};
+	std::ofstream out(path.c_str(),std::ios::binary|std::ios::trunc);
+	out.write(reinterpret_cast<const char*>(&h),sizeof(Header));
+	out.write(reinterpret_cast<const char*>(numerators),static_cast<std::streamsize>(numeratorBytes));
+	out.write(zeros,static_cast<std::streamsize>(padded(numeratorBytes)-numeratorBytes));
+	out.write(reinterpret_cast<const char*>(denominators),static_cast<std::streamsize>(denominatorBytes));
+	out.close();
+	if(!out)
+	{
+		fail(path,"cannot write the file");
+	}
+}
+
+FractionVector FractionFile::toVector() const
+{
+	FractionVector v;
+	v.p.assign(p,p+count);
+	v.q.assign(q,q+count);
+	return v;
+}
@@ -0,0 +1,101 @@
+#ifndef __FRACTION_FILE_H__
+#define __FRACTION_FILE_H__
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+#include "Fraction.h"
+#include "FractionVector.h"
+
+//FractionFile is a versioned binary file format for arrays of Fractions, and a read-only view of such a file mapped in memory.
+//
+//The file is a 64 byte header followed by two columns, the numerators and the denominators, each starting on a 64 byte boundary.
+//With the fixed encoding the columns hold little endian int32 numerators and uint32 denominators, exactly the arrays of a FractionVector,
+//so the view exposes the mapped pages directly and opening a file of any size takes no copy.
+//With the varint encoding the numerators are zigzag LEB128 and the denominators LEB128 varints, which take 2 to 4 bytes for most small terms.
+//They are decoded once when the file is opened.
+//
+//The header holds the magic "FRACTCOL", the format version, the encoding, the element count, the byte length and a checksum of each column,
+//and a checksum of the header itself. Opening a file verifies all of them and throws std::runtime_error on any mismatch.
+//Both encodings reject a zero denominator; the fixed column is scanned once for it when the file is opened.
+//Otherwise the elements are trusted to be normalized as written by write(), so no gcd is computed on load.
+//The format is little endian. Files are mapped with mmap() on POSIX systems and read into memory elsewhere.
+class FractionFile
+{
+public:
+	typedef FractionVector::Numerator Numerator;
+	typedef FractionVector::Denominator Denominator;
+
+	enum Encoding
+	{
+		eEncodingFixed=0,	//int32 numerators and uint32 denominators
+		eEncodingVarint=1	//zigzag LEB128 numerators and LEB128 denominators
+	};
+
+	//Version of the format written by write()
+	static const std::uint32_t sc_nVersion=1;
+
+private:
+	//The data members have been made private for information hiding.
+
+	const unsigned char* data;	//Start of the mapped or loaded file
+	std::size_t bytes;	//Length of the file
+	bool mapped;	//data is a mapping to be released with munmap() rather than an allocation
+	Encoding coding;	//Encoding of the columns
+	std::size_t count;	//Number of elements
+	const Numerator* p;	//Numerators, in the file or in decodedNumerators
+	const Denominator* q;	//Denominators, in the file or in decodedDenominators
+	FractionVector::Numerators decodedNumerators;	//Columns decoded from the varint encoding
+	FractionVector::Denominators decodedDenominators;
+
+	//checksum() is a Fletcher style checksum of 64 bit words modulo 2^64. It runs at memory speed.
+	static std::uint64_t checksum(const unsigned char*,std::size_t);
+
+	//open() and close() acquire and release the file contents.
+	void open(const std::string& path);
+	void close();
+
+	//validate() checks the header and the checksums and locates or decodes the columns.
+	void validate(const std::string& path);
+
+public:
+
+	//This Constructor opens the file, verifies it and maps its columns.
+	//It throws std::runtime_error if the file cannot be read or is not a valid FractionFile.
+	explicit FractionFile(const std::string& path);
+
+	//The Destructor unmaps the file.
+	~FractionFile();
+
+	//A FractionFile owns its mapping, so it cannot be copied.
+	FractionFile(const FractionFile&) = delete;
+	FractionFile& operator=(const FractionFile&) = delete;
+
+	//write(path,V,encoding) writes the elements of V to a new file, replacing any existing one.
+	//It throws std::runtime_error if the file cannot be written.
+	static void write(const std::string& path,const FractionVector&,Encoding encoding=eEncodingFixed);
+
+
+	//Accessors
+
+	std::size_t size() const {return count;}
+	bool empty() const {return count==0;}
+	Encoding encoding() const {return coding;}
+
+	//numerators() and denominators() give direct read access to the two columns, which stay valid as long as the FractionFile.
+	const Numerator* numerators() const {return p;}
+	const Denominator* denominators() const {return q;}
+
+	//get(i) returns the element i as a Fraction.
+	Fraction get(std::size_t i) const {return FractionVector::element(p[i],q[i]);}
+
+	//F=File[i] <------> File.get(i)
+	Fraction operator[](std::size_t i) const {return get(i);}
+
+	//toVector() copies the elements to a FractionVector, e.g. to run its batch kernels.
+	FractionVector toVector() const;
+};
+
+#endif // __FRACTION_FILE_H__
@@ -0,0 +1,204 @@
+#ifndef __FRACTION_GCD_H__
+#define __FRACTION_GCD_H__
+
+#include <cstdint>
+
+#include "FractionStats.h"
+
+//GCD Engine
+//This header collects the Greatest Common Divisor algorithms used by the Fraction class to normalize its data members.
+//Every Fraction constructor calls normalize() which calls gcd(), so this is the hottest code path of the library.
+//Every function is constexpr, so Fractions can be normalized in constant expressions.
+//The algorithm is selected at build time by defining FRACTION_GCD_ALGORITHM to one of the values below, e.g. -DFRACTION_GCD_ALGORITHM=FRACTION_GCD_EUCLID.
+
+#define FRACTION_GCD_EUCLID 0	//The original recursive modulo based Euclid algorithm
+#define FRACTION_GCD_BINARY 1	//Count-trailing-zeros binary GCD (Stein's algorithm) for every width
+#define FRACTION_GCD_LEHMER 2	//Binary GCD up to 64 bits, Lehmer steps with 64 bit single digits above that
+
+#ifndef FRACTION_GCD_ALGORITHM
+#define FRACTION_GCD_ALGORITHM FRACTION_GCD_BINARY
+#endif
+
+namespace FractionGCD
+{
+	//countTrailingZeros() returns the number of trailing zero bits of a non zero unsigned integer.
+	//It is overloaded for every unsigned width so that the binary GCD compiles down to a single tzcnt/bsf instruction.
+	constexpr int countTrailingZeros(unsigned int x) {return __builtin_ctz(x);}
+	constexpr int countTrailingZeros(unsigned long x) {return __builtin_ctzl(x);}
+	constexpr int countTrailingZeros(unsigned long long x) {return __builtin_ctzll(x);}
+#ifdef __SIZEOF_INT128__
+	constexpr int countTrailingZeros(unsigned __int128 x)
+	{
+		std::uint64_t lo=static_cast<std::uint64_t>(x);
+		return lo ? __builtin_ctzll(lo) : 64+__builtin_ctzll(static_cast<std::uint64_t>(x>>64));
+	}
+#endif
+
+	//countLeadingZeros() returns the number of leading zero bits of a non zero unsigned integer.
+	//It is only needed by the Lehmer algorithm to extract the leading digits of a wide integer.
+	constexpr int countLeadingZeros(unsigned long long x) {return __builtin_clzll(x);}
+#ifdef __SIZEOF_INT128__
+	constexpr int countLeadingZeros(unsigned __int128 x)
+	{
+		std::uint64_t hi=static_cast<std::uint64_t>(x>>64);
+		return hi ? __builtin_clzll(hi) : 64+__builtin_clzll(static_cast<std::uint64_t>(x));
+	}
+#endif
+
+	//euclid() is the original recursive algorithm of Fraction::gcd().
+	//It is kept as the reference implementation and as the baseline of the benchmark.
+	//Each step costs one hardware division.
+	template<typename U>
+	constexpr U euclid(U a,U b)
+	{
+		if(b==0)
+			return a;
+		FRACTION_STATS_RECORD(gcdSteps(1));
+		return euclid(b,a%b);
+	}
+
+	//binary() computes the GCD without any division.
+	//Common factors of two are removed with a single count-trailing-zeros, then the odd parts are reduced by subtraction.
+	//The trailing zeros of the difference are counted on the wrapped difference a-b, which has the same trailing zeros as |a-b|.
+	//That keeps the count off the critical path of the min/abs selects, which compile to conditional moves.
+	template<typename U>
+	constexpr U binary(U u,U v)
+	{
+		if(u==0)
+			return v;
+		if(v==0)
+			return u;
+		int shift=countTrailingZeros(static_cast<U>(u|v));
+		u>>=countTrailingZeros(u);
+		v>>=countTrailingZeros(v);
+		FRACTION_STATS_STEPS(steps);
+		while(u!=v)
+		{
+			FRACTION_STATS_STEP(steps);
+			U diff=static_cast<U>(u-v);
+			int zeros=countTrailingZeros(diff);
+			U low=u<v ? u : v;
+			U high=u<v ? v : u;
+			u=low;
+			v=static_cast<U>(high-low)>>zeros;
+		}
+		FRACTION_STATS_RECORD(gcdSteps(steps));
+		return u<<shift;
+	}
+
+	//lehmerQuotient() returns n/d for the single digit quotients of the Lehmer algorithm.
+	//Two in five Euclid quotients are one (Gauss-Kuzmin), so those are found by a comparison before falling back to a division.
+	constexpr std::int64_t lehmerQuotient(std::int64_t n,std::int64_t d)
+	{
+		if(n-d<d)
+			return n<d ? 0 : 1;
+		return n/d;
+	}
+
+#ifdef __SIZEOF_INT128__
+	//lehmer() computes the GCD of two 128 bit integers.
+	//Division of 128 bit integers is a library call, so consecutive Euclid quotients are computed on the leading 62 bits of the operands in 64 bit registers (Knuth, Algorithm 4.5.2L).
+	//The collected cofactors are then applied to the full width operands with multiplications only.
+	//Once both operands fit in 64 bits the binary algorithm finishes the job.
+	constexpr unsigned __int128 lehmer(unsigned __int128 u,unsigned __int128 v)
+	{
+		typedef unsigned __int128 Wide;
+		if(u<v)
+		{
+			Wide t=u;
+			u=v;
+			v=t;
+		}
+		while(static_cast<std::uint64_t>(v>>64)!=0)
+		{
+			FRACTION_STATS_RECORD(gcdSteps(1));
+			int shift=(128-countLeadingZeros(u))-62;	//Keeps the 62 leading bits of u
+			std::int64_t x=static_cast<std::int64_t>(u>>shift);
+			std::int64_t y=static_cast<std::int64_t>(v>>shift);
+			std::int64_t A=1,B=0,C=0,D=1;
+			while(y+C>0 && y+D>0)
+			{
+				std::int64_t q=lehmerQuotient(x+A,y+C);
+				if(q!=lehmerQuotient(x+B,y+D))
+					break;
+				std::int64_t T=A-q*C; A=C; C=T;
+				T=B-q*D; B=D; D=T;
+				T=x-q*y; x=y; y=T;
+			}
+			if(B==0)
+			{
+				Wide T=u%v;
+				u=v;
+				v=T;
+			}
+			else
+			{
+				//The true values of both combinations lie in [0,u], so wrapping unsigned arithmetic gives the exact result.
+				Wide T=static_cast<Wide>(A)*u+static_cast<Wide>(B)*v;
+				Wide W=static_cast<Wide>(C)*u+static_cast<Wide>(D)*v;
+				u=T;
+				v=W;
+			}
+		}
+		if(v==0)
+			return u;
+		std::uint64_t r=static_cast<std::uint64_t>(u%v);
+		return binary<std::uint64_t>(static_cast<std::uint64_t>(v),r);
+	}
+#endif
+
+	//select() dispatches on FRACTION_GCD_ALGORITHM and on the width of the operands.
+	template<typename U>
+	constexpr U select(U a,U b)
+	{
+#if FRACTION_GCD_ALGORITHM==FRACTION_GCD_EUCLID
+		return euclid(a,b);
+#else
+		return binary(a,b);
+#endif
+	}
+
+#if defined(__SIZEOF_INT128__) && FRACTION_GCD_ALGORITHM==FRACTION_GCD_LEHMER
+	template<>
+	constexpr unsigned __int128 select<unsigned __int128>(unsigned __int128 a,unsigned __int128 b)
+	{
+		return lehmer(a,b);
+	}
+#endif
+
+	//gcd() is the entry point used by the library.
+	//With FRACTION_STATS it also records the call and the steps it took in the counters of FractionStats.
+	template<typename U>
+	constexpr U gcd(U a,U b)
+	{
+		FRACTION_STATS_STEPS(before);
+		FRACTION_STATS_RECORD(mark(before));
+		U g=select(a,b);
+		FRACTION_STATS_RECORD(gcd(before));
+		return g;
+	}
+
+	//compareRatios(a,b,c,d) returns the sign of a/b-c/d for non-negative a,c and positive b,d.
+	//The integer parts decide unless they are equal; then the remainders are compared through their reciprocals, as in the continued fraction expansion.
+	//It needs no products, so it cannot overflow, and it takes O(log) steps like Euclid's algorithm.
+	template<typename U>
+	constexpr int compareRatios(U a,U b,U c,U d)
+	{
+		for(;;)
+		{
+			U x=a/b,y=c/d;
+			if(x!=y)
+				return x<y ? -1 : 1;
+			U r=a%b,s=c%d;
+			if(r==0 || s==0)
+				return (r!=0)-(s!=0);
+			//r/b<s/d exactly when d/s<b/r.
+			a=d;
+			c=b;
+			b=s;
+			d=r;
+		}
+	}
+}
+
+#endif // __FRACTION_GCD_H__
@@ -0,0 +1,260 @@
+#ifndef __FRACTION_HASH_H__
+#define __FRACTION_HASH_H__
+
+#include <cstddef>
+#include <cstdint>
+#include <utility>
+#include <vector>
+
+#include "Fraction.h"
+
+//FractionHashSet and FractionHashMap are open addressing hash containers keyed by Fractions.
+//
+//A Fraction is always normalized, so two Fractions are equal exactly when their numerators and denominators are equal.
+//The keys are therefore stored inline as their two terms, compared as two integers and hashed with BasicFraction::hash() without any gcd.
+//A denominator is never 0, which marks the empty slots, so a slot of a FractionHashSet takes 8 bytes and needs no separate control bytes.
+//
+//Collisions are resolved by linear probing in a power of two table kept at most 3/4 full, and erase() shifts the following slots back
+//instead of leaving tombstones, so lookups never slow down after many erasures.
+//Inserting may move every element, so pointers returned by find() are only valid until the next insertion.
+//
+//FractionHashMap<int> counts;
+//counts[Fraction(1,2)]++;
+//if(const int* n=counts.find(Fraction(2,4))) ...
+
+//FractionHashSetSlot and FractionHashMapSlot are the slots of the two containers: the terms of the key, and the mapped value for a map.
+template<typename IntT>
+struct FractionHashSetSlot
+{
+	IntT p;	//Numerator of the key
+	typename BasicFraction<IntT>::Unsigned q;	//Denominator of the key, 0 for an empty slot
+};
+
+template<typename IntT,typename Mapped>
+struct FractionHashMapSlot
+{
+	IntT p;
+	typename BasicFraction<IntT>::Unsigned q;
+	Mapped value;
+};
+
+//BasicFractionHashTable is the table shared by BasicFractionHashSet and BasicFractionHashMap.
+template<typename IntT,typename Slot>
+class BasicFractionHashTable
+{
+public:
+	typedef BasicFraction<IntT> Key;
+	typedef typename Key::Unsigned Unsigned;
+
+protected:
+	//The data members have been made private for information hiding.
+
+	std::vector<Slot> slots;	//A power of two number of slots, or none before the first insertion
+	std::size_t used;	//Number of occupied slots
+
+	static const std::size_t npos=static_cast<std::size_t>(-1);
+
+	//Utility Functions
+
+	std::size_t mask() const {return this->slots.size()-1;}
+
+	static bool matches(const Slot& s,const Key& k) {return s.q==k.q && s.p==k.p;}
+
+	//key(Slot) rebuilds the Fraction stored in a slot. The terms were normalized when it was inserted.
+	static Key key(const Slot& s) {return Key(s.p,s.q,typename Key::Reduced());}
+
+	//locate(K) returns the index of the slot holding K, or npos.
+	std::size_t locate(const Key& k) const
+	{
+		if(this->used==0)
+			return npos;
+		std::size_t m=mask();
+		for(std::size_t i=static_cast<std::size_t>(k.hash())&m;;i=(i+1)&m)
+		{
+			const Slot& s=this->slots[i];
+			if(matches(s,k))
+				return i;
+			if(s.q==0)
+				return npos;
+		}
+	}
+
+	//place(K) returns the index of the slot holding K, claiming an empty slot for it if needed, and whether it was inserted.
+	//The mapped value of a new slot is value initialized.
+	std::pair<std::size_t,bool> place(const Key& k)
+	{
+		if((this->used+1)*4>this->slots.size()*3)
+			rehash(this->slots.empty() ? 16 : 2*this->slots.size());
+		std::size_t m=mask();
+		for(std::size_t i=static_cast<std::size_t>(k.hash())&m;;i=(i+1)&m)
+		{
+			Slot& s=this->slots[i];
+			if(matches(s,k))
+				return std::make_pair(i,false);
+			if(s.q==0)
+			{
+				s=Slot();
+				s.p=k.p;
+				s.q=k.q;
+				this->used++;
+				return std::make_pair(i,true);
+			}
+		}
+	}
+
+	//rehash(n) moves the elements to a table of n slots, a power of two large enough to hold them.
+	void rehash(std::size_t n)
+	{
+		std::vector<Slot> old(n);
+		old.swap(this->slots);
+		std::size_t m=mask();
+		for(Slot& s : old)
+		{
+			if(s.q==0)
+				continue;
+			std::size_t i=static_cast<std::size_t>(key(s).hash())&m;
+			while(this->slots[i].q!=0)
+				i=(i+1)&m;
+			this->slots[i]=std::move(s);
+		}
+	}
+
+public:
+
+	//Default Constructor
+	//An empty table allocates nothing until the first insertion.
+	BasicFractionHashTable() : used(0) {}
+
+	//Accessors
+
+	std::size_t size() const {return this->used;}
+	bool empty() const {return this->used==0;}
+
+	//capacity() returns the number of slots, of which at most 3/4 are used.
+	std::size_t capacity() const {return this->slots.size();}
+
+	//contains(K) returns true if K is in the table. count(K) returns 1 or 0 as for the standard containers.
+	bool contains(const Key& k) const {return locate(k)!=npos;}
+	std::size_t count(const Key& k) const {return contains(k) ? 1 : 0;}
+
+	//reserve(n) makes room for n elements so that inserting them does not rehash.
+	void reserve(std::size_t n)
+	{
+		std::size_t c=16;
+		while(c*3<n*4)
+			c*=2;
+		if(c>this->slots.size())
+			rehash(c);
+	}
+
+	//clear() removes every element and keeps the slots allocated.
+	void clear()
+	{
+		for(Slot& s : this->slots)
+			s=Slot();
+		this->used=0;
+	}
+
+	//erase(K) removes K and returns true if it was in the table.
+	//The slots of the probe sequence after it are shifted back into the hole so that no tombstone is left.
+	bool erase(const Key& k)
+	{
+		std::size_t hole=locate(k);
+		if(hole==npos)
+			return false;
+		std::size_t m=mask();
+		for(std::size_t i=(hole+1)&m;this->slots[i].q!=0;i=(i+1)&m)
+		{
+			//The element at i may fill the hole if its home slot does not lie cyclically in (hole,i].
+			std::size_t home=static_cast<std::size_t>(key(this->slots[i]).hash())&m;
+			if(((i-home)&m)>=((i-hole)&m))
+			{
+				this->slots[hole]=std::move(this->slots[i]);
+				hole=i;
+			}
+		}
+		this->slots[hole]=Slot();
+		this->used--;
+		return true;
+	}
+};
+
+//BasicFractionHashSet is a set of BasicFraction<IntT> values.
+template<typename IntT>
+class BasicFractionHashSet : public BasicFractionHashTable<IntT,FractionHashSetSlot<IntT> >
+{
+	typedef BasicFractionHashTable<IntT,FractionHashSetSlot<IntT> > Table;
+
+public:
+	typedef typename Table::Key Key;
+
+	//insert(K) adds K and returns true if it was not already in the set.
+	bool insert(const Key& k) {return this->place(k).second;}
+
+	//forEach(f) calls f(K) for every element, in an unspecified order.
+	template<typename Function>
+	void forEach(Function f) const
+	{
+		for(const FractionHashSetSlot<IntT>& s : this->slots)
+			if(s.q!=0)
+				f(Table::key(s));
+	}
+};
+
+//BasicFractionHashMap maps BasicFraction<IntT> keys to values of type Mapped, which must be default constructible.
+template<typename IntT,typename Mapped>
+class BasicFractionHashMap : public BasicFractionHashTable<IntT,FractionHashMapSlot<IntT,Mapped> >
+{
+	typedef BasicFractionHashTable<IntT,FractionHashMapSlot<IntT,Mapped> > Table;
+
+public:
+	typedef typename Table::Key Key;
+
+	//M[K] returns the value mapped to K, inserting a value initialized one if K is not in the map.
+	Mapped& operator[](const Key& k) {return this->slots[this->place(k).first].value;}
+
+	//insert(K,V) maps K to V and returns true if K was not in the map. An existing value is left unchanged, as with std::unordered_map.
+	bool insert(const Key& k,const Mapped& v)
+	{
+		std::pair<std::size_t,bool> r=this->place(k);
+		if(r.second)
+			this->slots[r.first].value=v;
+		return r.second;
+	}
+
+	//find(K) returns a pointer to the value mapped to K, or nullptr if K is not in the map.
+	Mapped* find(const Key& k)
+	{
+		std::size_t i=this->locate(k);
+		return i==Table::npos ? nullptr : &this->slots[i].value;
+	}
+	const Mapped* find(const Key& k) const
+	{
+		std::size_t i=this->locate(k);
+		return i==Table::npos ? nullptr : &this->slots[i].value;
+	}
+
+	//forEach(f) calls f(K,V) for every element, in an unspecified order. V is a reference to the mapped value and may be modified.
+	template<typename Function>
+	void forEach(Function f)
+	{
+		for(FractionHashMapSlot<IntT,Mapped>& s : this->slots)
+			if(s.q!=0)
+				f(Table::key(s),s.value);
+	}
+	template<typename Function>
+	void forEach(Function f) const
+	{
+		for(const FractionHashMapSlot<IntT,Mapped>& s : this->slots)
+			if(s.q!=0)
+				f(Table::key(s),s.value);
+	}
+};
+
+//FractionHashSet and FractionHashMap are keyed by the classic Fraction type.
+typedef BasicFractionHashSet<std::int32_t> FractionHashSet;
+
+template<typename Mapped>
+using FractionHashMap=BasicFractionHashMap<std::int32_t,Mapped>;
+
+#endif // __FRACTION_HASH_H__
@@ -0,0 +1,547 @@
+#include "FractionLP.h"
+
+#include <algorithm>
+#include <stdexcept>
+
+namespace
+{
+	inline bool isZero(const BigFraction& f) {return f.numerator().isZero();}
+	inline int sign(const BigFraction& f) {return f.numerator().sign();}
+
+	//Size of the terms of a pivot candidate, to pick the one that gives the smallest elements
+	inline std::size_t bits(const BigFraction& f) {return f.numerator().bitLength()+f.denominator().bitLength();}
+
+	//Number of consecutive degenerate pivots after which Bland's rule chooses the entering variable
+	const std::size_t sc_nDegenerate=8;
+
+	//lcm(l,q) returns the lcm of l and the positive q.
+	BigInteger lcm(const BigInteger& l,const BigInteger& q)
+	{
+		return (q==1) ? l : divExact(l,BigInteger::gcd(l,q))*q;
+	}
+
+	//commonDenominator(y,Y) returns the lcm L of the denominators of y and sets Y=L*y, a vector of integers.
+	BigInteger commonDenominator(const std::vector<BigFraction>& y,std::vector<BigInteger>& Y)
+	{
+		BigInteger L(1);
+		for(const BigFraction& f : y)
+			if(!isZero(f))
+				L=lcm(L,f.denominator());
+		for(std::size_t i=0;i<y.size();i++)
+			Y[i]=isZero(y[i]) ? BigInteger(0) : y[i].numerator()*divExact(L,y[i].denominator());
+		return L;
+	}
+
+	//Entry is a non zero element of a sparse column.
+	struct Entry
+	{
+		std::size_t row;
+		BigFraction value;
+	};
+
+	//Eta is the elementary matrix of a pivot on the element d[row] of a column d: the identity with the column row replaced by
+	//-d[i]/d[row] in the rows i and 1/d[row] in the row itself. Only the non zero d[i] of the other rows are stored.
+	//The etas of L have a unit pivot, which saves the divisions.
+	struct Eta
+	{
+		std::size_t row;
+		BigFraction pivot;
+		bool unit;	//pivot is 1
+		std::vector<Entry> entries;
+	};
+
+	//Simplex holds the standard form of a program, A*x=b with x>=0 and b>=0, and the state of the revised simplex method on it.
+	class Simplex
+	{
+	public:
+		std::size_t m;	//Rows
+		std::size_t structurals;	//Variables of the program, the first columns
+		std::size_t firstArtificial;	//Columns from firstArtificial on are artificial
+		std::vector<std::size_t> columnStart;	//The entries of the column j are those from columnStart[j] to columnStart[j+1]
+		std::vector<Entry> entries;
+		std::vector<BigFraction> b;
+		std::vector<BigInteger> c;	//Costs of the current phase, made integers
+		std::vector<BigInteger> scale;	//Multiplier of the row of a slack, surplus or artificial variable, 1 for the variables of the program
+
+		std::vector<std::size_t> basis;	//Column of the basic variable of each row
+		std::vector<bool> basic;
+		std::vector<BigFraction> xB;	//Values of the basic variables
+		std::vector<Eta> etas;	//Inverse of the basis, the first eta applied first
+		std::size_t refactorPeriod;
+		std::size_t sinceFactorization;
+		std::size_t pivots;
+		std::size_t factorizations;
+
+		//ftran(v) replaces v by B^-1*v.
+		void ftran(std::vector<BigFraction>& v) const
+		{
+			for(const Eta& e : etas)
+			{
+				if(isZero(v[e.row]))
+					continue;
+				if(!e.unit)
+					v[e.row]=v[e.row]/e.pivot;
+				const BigFraction& t=v[e.row];
+				for(const Entry& d : e.entries)
+					v[d.row]=v[d.row]-d.value*t;
+			}
+		}
+
+		//btran(y) replaces the row vector y by y*B^-1.
+		void btran(std::vector<BigFraction>& y) const
+		{
+			for(std::size_t k=etas.size();k-->0;)
+			{
+				const Eta& e=etas[k];
+				BigFraction s=y[e.row];
+				for(const Entry& d : e.entries)
+					if(!isZero(y[d.row]))
+						s=s-d.value*y[d.row];
+				y[e.row]=(e.unit || isZero(s)) ? s : s/e.pivot;
+			}
+		}
+
+		//column(j) returns the column j of A as a dense vector.
+		std::vector<BigFraction> column(std::size_t j) const
+		{
+			std::vector<BigFraction> v(m,BigFraction(0));
+			for(std::size_t k=columnStart[j];k<columnStart[j+1];k++)
+				v[entries[k].row]=entries[k].value;
+			return v;
+		}
+
+		//dot(y,j) returns y*A[j] for a vector of integers y.
+		BigInteger dot(const std::vector<BigInteger>& y,std::size_t j) const
+		{
+			BigInteger s(0);
+			for(std::size_t k=columnStart[j];k<columnStart[j+1];k++)
+				if(!y[entries[k].row].isZero())
+					s=s+y[entries[k].row]*entries[k].value.numerator();
+			return s;
+		}
+
+		//addEta(r,d) appends the pivot on d[r] to the inverse.
+		void addEta(std::size_t r,const std::vector<BigFraction>& d)
+		{
+			Eta e;
+			e.row=r;
+			e.pivot=d[r];
+			e.unit=(d[r]==BigFraction::sc_fUnity);
+			for(std::size_t i=0;i<m;i++)
+				if(i!=r && !isZero(d[i]))
+					e.entries.push_back(Entry{i,d[i]});
+			etas.push_back(e);
+		}
+
+		//factorize() rebuilds the inverse from the basic columns alone, as B=L*U by sparse Gaussian elimination, and recomputes the basic values.
+		//Each step pivots on the column with the fewest non zeros left and, within it, on the row with the fewest (Markowitz),
+		//which keeps the fill small: the unit columns of slack variables are taken first and cost no arithmetic.
+		//The inverse is stored as the etas of L, one per step with a unit pivot, followed by those of U in the reverse order of the steps.
+		//The basis is non singular, so every step finds a non zero pivot.
+		void factorize()
+		{
+			std::vector<std::size_t> columns(basis);
+			std::size_t k=columns.size();
+			std::vector<std::vector<Entry> > u(k);	//Elements of the basic columns, the active rows and then those of U
+			std::vector<std::vector<std::size_t> > rowColumns(m);	//Columns that may have a non zero in each row
+			std::vector<std::size_t> rowCount(m,0),columnCount(k);
+			for(std::size_t t=0;t<k;t++)
+			{
+				for(std::size_t e=columnStart[columns[t]];e<columnStart[columns[t]+1];e++)
+				{
+					u[t].push_back(entries[e]);
+					rowColumns[entries[e].row].push_back(t);
+					rowCount[entries[e].row]++;
+				}
+				columnCount[t]=u[t].size();
+			}
+			std::vector<bool> rowDone(m,false),columnDone(k,false);
+			std::vector<std::size_t> order,pivotRows;	//Columns and rows of the steps
+			std::vector<std::size_t> where(m,m);	//Position of a row in the column being updated
+			std::vector<std::size_t> visited(k,k);	//Last step that updated each column
+			etas.clear();
+			for(std::size_t step=0;step<k;step++)
+			{
+				std::size_t c=k;
+				for(std::size_t t=0;t<k;t++)
+					if(!columnDone[t] && (c==k || columnCount[t]<columnCount[c]))
+						c=t;
+				std::size_t p=u[c].size();
+				for(std::size_t e=0;e<u[c].size();e++)
+				{
+					std::size_t i=u[c][e].row;
+					if(rowDone[i])
+						continue;
+					if(p==u[c].size() || rowCount[i]<rowCount[u[c][p].row]
+						|| (rowCount[i]==rowCount[u[c][p].row] && bits(u[c][e].value)<bits(u[c][p].value)))
+						p=e;
+				}
+				if(p==u[c].size())
+				{
+					throw std::logic_error("FractionLP: singular basis");
+				}
+				std::size_t r=u[c][p].row;
+				BigFraction pivotValue=u[c][p].value;
+
+				//The multipliers of the other active rows form the eta of L, and leave the column with its elements of U.
+				Eta l;
+				l.row=r;
+				l.pivot=BigFraction::sc_fUnity;
+				l.unit=true;
+				std::vector<Entry> kept;
+				for(const Entry& e : u[c])
+				{
+					if(!rowDone[e.row] && e.row!=r)
+					{
+						l.entries.push_back(Entry{e.row,e.value/pivotValue});
+						rowCount[e.row]--;
+					}
+					else
+						kept.push_back(e);
+				}
+				u[c].swap(kept);
+				rowCount[r]--;
+				columnDone[c]=true;
+				rowDone[r]=true;
+				order.push_back(c);
+				pivotRows.push_back(r);
+				basis[r]=columns[c];
+
+				//Every other column with a non zero in the pivot row is updated on the rows of the multipliers.
+				//A column is listed again in a row where an element cancelled and then filled in, so each is visited once.
+				for(std::size_t t : rowColumns[r])
+				{
+					if(columnDone[t] || visited[t]==step)
+						continue;
+					visited[t]=step;
+					std::size_t e=0;
+					while(e<u[t].size() && u[t][e].row!=r)
+						e++;
+					if(e==u[t].size())
+						continue;
+					columnCount[t]--;
+					if(l.entries.empty())
+						continue;
+					BigFraction a=u[t][e].value;
+					for(std::size_t f=0;f<u[t].size();f++)
+						where[u[t][f].row]=f;
+					for(const Entry& d : l.entries)
+					{
+						if(where[d.row]<u[t].size() && u[t][where[d.row]].row==d.row)
+						{
+							BigFraction& x=u[t][where[d.row]].value;
+							x=x-d.value*a;
+							if(isZero(x))
+								columnCount[t]--;
+						}
+						else
+						{
+							u[t].push_back(Entry{d.row,-(d.value*a)});
+							rowColumns[d.row].push_back(t);
+							rowCount[d.row]++;
+							columnCount[t]++;
+						}
+					}
+					//Cancelled elements are removed.
+					std::size_t kept=0;
+					for(std::size_t f=0;f<u[t].size();f++)
+					{
+						if(isZero(u[t][f].value))
+						{
+							rowCount[u[t][f].row]--;
+							continue;
+						}
+						u[t][kept++]=u[t][f];
+					}
+					u[t].resize(kept);
+					for(std::size_t f=0;f<u[t].size();f++)
+						where[u[t][f].row]=m;
+				}
+				if(!l.entries.empty())
+					etas.push_back(l);
+			}
+			for(std::size_t s=k;s-->0;)
+			{
+				Eta e;
+				e.row=pivotRows[s];
+				for(const Entry& x : u[order[s]])
+				{
+					if(x.row==e.row)
+						e.pivot=x.value;
+					else
+						e.entries.push_back(x);
+				}
+				e.unit=(e.pivot==BigFraction::sc_fUnity);
+				if(!e.entries.empty() || !e.unit)
+					etas.push_back(e);
+			}
+			xB=b;
+			ftran(xB);
+			sinceFactorization=0;
+			factorizations++;
+		}
+
+		//pivot(r,j,d) replaces the basic variable of the row r by the column j, whose transformed column is d.
+		void pivot(std::size_t r,std::size_t j,const std::vector<BigFraction>& d)
+		{
+			BigFraction theta=xB[r]/d[r];
+			if(!isZero(theta))
+				for(std::size_t i=0;i<m;i++)
+					if(i!=r && !isZero(d[i]))
+						xB[i]=xB[i]-d[i]*theta;
+			xB[r]=theta;
+			basic[basis[r]]=false;
+			basic[j]=true;
+			basis[r]=j;
+			addEta(r,d);
+			pivots++;
+			sinceFactorization++;
+		}
+
+		//run(limit) runs the simplex method with the columns below limit as candidates. It returns false if the objective is unbounded.
+		bool run(std::size_t limit)
+		{
+			std::vector<BigFraction> y(m);
+			std::vector<BigInteger> Y(m);
+			bool bland=false;
+			std::size_t degenerate=0;
+			for(;;)
+			{
+				for(std::size_t i=0;i<m;i++)
+					y[i]=BigFraction(c[basis[i]]);
+				btran(y);
+				//The reduced costs c[j]-y*A[j] are compared multiplied by the common denominator L of y, in integers.
+				BigInteger L=commonDenominator(y,Y);
+				//Dantzig's rule: the most negative reduced cost enters, or Bland's rule, the first negative one, during a run of degenerate pivots.
+				//The reduced cost of a slack variable is weighted by the multiplier of its row, which gives the choices of the unscaled program.
+				std::size_t q=limit;
+				BigInteger most(0);
+				for(std::size_t j=0;j<limit && !(bland && q<limit);j++)
+				{
+					if(basic[j])
+						continue;
+					BigInteger reduced=c[j]*L-dot(Y,j);
+					if(j>=structurals && !reduced.isZero())
+						reduced=reduced*scale[j];
+					if(reduced.isNegative() && (bland || reduced<most))
+					{
+						q=j;
+						most=reduced;
+					}
+				}
+				if(q==limit)
+					return true;
+				std::vector<BigFraction> d=column(q);
+				ftran(d);
+				//The ratio test, where ties go to the basic variable of the smallest index.
+				std::size_t r=m;
+				BigFraction best;
+				for(std::size_t i=0;i<m;i++)
+				{
+					if(sign(d[i])<=0)
+						continue;
+					BigFraction ratio=xB[i]/d[i];
+					int order=(r==m) ? -1 : compare(ratio,best);
+					if(order<0 || (order==0 && basis[i]<basis[r]))
+					{
+						r=i;
+						best=ratio;
+					}
+				}
+				if(r==m)
+					return false;
+				degenerate=isZero(xB[r]) ? degenerate+1 : 0;
+				bland=(degenerate>=sc_nDegenerate);
+				pivot(r,q,d);
+				if(sinceFactorization>=refactorPeriod)
+					factorize();
+			}
+		}
+
+		//removeArtificials() pivots the artificial variables left in the basis at zero out of it after the first phase.
+		//A row whose every other column is zero in the tableau is redundant: its artificial variable stays, but can never change.
+		//The basis is not factorized here, so the rows keep their basic variables during the loop.
+		void removeArtificials()
+		{
+			for(std::size_t r=0;r<m;r++)
+			{
+				if(basis[r]<firstArtificial)
+					continue;
+				std::vector<BigFraction> rho(m,BigFraction(0));
+				rho[r]=BigFraction::sc_fUnity;
+				btran(rho);
+				std::vector<BigInteger> R(m);
+				commonDenominator(rho,R);
+				for(std::size_t j=0;j<firstArtificial;j++)
+				{
+					if(basic[j] || dot(R,j).isZero())
+						continue;
+					std::vector<BigFraction> d=column(j);
+					ftran(d);
+					pivot(r,j,d);
+					break;
+				}
+			}
+		}
+	};
+}
+
+//Constructor
+FractionLP::FractionLP(std::size_t variables,Goal g)
+: n(variables),goal(g),cost(variables,Fraction::sc_fZero),rowStart(1,0),status(eNotSolved),optimum(0),x(variables,BigFraction(0)),pivots(0),factorizations(0)
+{
+}
+
+//Objective
+void FractionLP::setObjective(std::size_t variable,const Fraction& coefficient)
+{
+	if(variable>=n)
+	{
+		throw std::invalid_argument("FractionLP: no such variable");
+	}
+	cost[variable]=coefficient;
+	status=eNotSolved;
+}
+
+//Constraint
+std::size_t FractionLP::addConstraint(const std::vector<Term>& row,Sense sense,const Fraction& b)
+{
+	for(const Term& t : row)
+		if(t.variable>=n)
+		{
+			throw std::invalid_argument("FractionLP: no such variable");
+		}
+	terms.insert(terms.end(),row.begin(),row.end());
+	rowStart.push_back(terms.size());
+	senses.push_back(sense);
+	rhs.push_back(b);
+	status=eNotSolved;
+	return senses.size()-1;
+}
+
+//Solution
+//Each row is multiplied by the lcm of its denominators, and the objective by that of its own, so that the standard form has integer coefficients.
+//The rows are then negated where needed so that b>=0. A row a*x<=b gets a slack variable, which starts in the basis,
+//a row a*x>=b a surplus variable and a row a*x=b nothing; these last two get an artificial variable that starts in the basis.
+FractionLP::Status FractionLP::solve(std::size_t refactorPeriod)
+{
+	Simplex S;
+	std::size_t m=senses.size();
+	S.m=m;
+	S.structurals=n;
+	S.refactorPeriod=std::max<std::size_t>(refactorPeriod,1);
+	S.pivots=0;
+	S.factorizations=0;
+
+	//Columns of the program, the coefficients of repeated variables added.
+	std::vector<std::vector<Entry> > columns(n);
+	std::vector<bool> negated(m);
+	std::vector<BigInteger> rowScale(m);
+	for(std::size_t i=0;i<m;i++)
+	{
+		negated[i]=(rhs[i]<Fraction::sc_fZero);
+		BigInteger l=BigInteger::fromMagnitude(rhs[i].denominator(),false);
+		for(std::size_t k=rowStart[i];k<rowStart[i+1];k++)
+			l=lcm(l,BigInteger::fromMagnitude(terms[k].coefficient.denominator(),false));
+		BigFraction scale(negated[i] ? -l : l);
+		rowScale[i]=l;
+		for(std::size_t k=rowStart[i];k<rowStart[i+1];k++)
+		{
+			std::vector<Entry>& column=columns[terms[k].variable];
+			BigFraction a=BigFraction(terms[k].coefficient)*scale;
+			if(!column.empty() && column.back().row==i)
+				column.back().value=column.back().value+a;
+			else
+				column.push_back(Entry{i,a});
+		}
+		S.b.push_back(BigFraction(rhs[i])*scale);
+	}
+	for(std::vector<Entry>& column : columns)
+		column.erase(std::remove_if(column.begin(),column.end(),[](const Entry& e) {return isZero(e.value);}),column.end());
+
+	S.basis.assign(m,0);
+	std::vector<std::size_t> artificialRows;
+	for(std::size_t i=0;i<m;i++)
+	{
+		Sense sense=senses[i];
+		if(negated[i] && sense!=eEqual)
+			sense=(sense==eLessEqual) ? eGreaterEqual : eLessEqual;
+		if(sense==eEqual)
+		{
+			artificialRows.push_back(i);
+			continue;
+		}
+		S.basis[i]=columns.size();
+		columns.push_back(std::vector<Entry>(1,Entry{i,BigFraction(sense==eLessEqual ? 1 : -1)}));
+		if(sense==eGreaterEqual)
+			artificialRows.push_back(i);
+	}
+	S.firstArtificial=columns.size();
+	for(std::size_t i : artificialRows)
+	{
+		S.basis[i]=columns.size();
+		columns.push_back(std::vector<Entry>(1,Entry{i,BigFraction(1)}));
+	}
+	S.scale.assign(columns.size(),BigInteger(1));
+	for(std::size_t j=n;j<columns.size();j++)
+		S.scale[j]=rowScale[columns[j][0].row];
+	S.columnStart.push_back(0);
+	for(const std::vector<Entry>& column : columns)
+	{
+		S.entries.insert(S.entries.end(),column.begin(),column.end());
+		S.columnStart.push_back(S.entries.size());
+	}
+	S.basic.assign(columns.size(),false);
+	for(std::size_t j : S.basis)
+		S.basic[j]=true;
+	S.factorize();
+
+	//Phase 1 minimizes the sum of the artificial variables.
+	S.c.assign(columns.size(),BigInteger(0));
+	std::fill(x.begin(),x.end(),BigFraction(0));
+	optimum=BigFraction(0);
+	if(S.firstArtificial<columns.size())
+	{
+		for(std::size_t j=S.firstArtificial;j<columns.size();j++)
+			S.c[j]=1;
+		S.run(columns.size());
+		BigFraction infeasibility(0);
+		for(std::size_t i=0;i<m;i++)
+			if(S.basis[i]>=S.firstArtificial)
+				infeasibility=infeasibility+S.xB[i];
+		if(!isZero(infeasibility))
+		{
+			status=eInfeasible;
+			pivots=S.pivots;
+			factorizations=S.factorizations;
+			return status;
+		}
+		S.removeArtificials();
+	}
+
+	//Phase 2 optimizes the objective over the columns of the program and the slack variables.
+	BigInteger l(1);
+	for(std::size_t j=0;j<n;j++)
+		l=lcm(l,BigInteger::fromMagnitude(cost[j].denominator(),false));
+	for(std::size_t j=0;j<n;j++)
+	{
+		BigFraction c=BigFraction(cost[j])*BigFraction(goal==eMaximize ? -l : l);
+		S.c[j]=c.numerator();
+	}
+	bool bounded=S.run(S.firstArtificial);
+	pivots=S.pivots;
+	factorizations=S.factorizations;
+	if(!bounded)
+	{
+		status=eUnbounded;
+		return status;
+	}
+	for(std::size_t i=0;i<m;i++)
+		if(S.basis[i]<n)
+			x[S.basis[i]]=S.xB[i];
+	for(std::size_t j=0;j<n;j++)
+		if(!isZero(x[j]))
+			optimum=optimum+BigFraction(cost[j])*x[j];
+	status=eOptimal;
+	return status;
+}
@@ -0,0 +1,118 @@
+#ifndef __FRACTION_LP_H__
+#define __FRACTION_LP_H__
+
+#include <cstddef>
+#include <vector>
+
+#include "BigFraction.h"
+#include "Fraction.h"
+
+//FractionLP is a linear program with Fraction coefficients, solved exactly by the simplex method.
+//
+//The program minimizes or maximizes c*x over the x>=0 that satisfy the constraints, each of the form a*x<=b, a*x=b or a*x>=b.
+//The constraints are stored as sparse rows and the solver works on the sparse columns of the standard form,
+//with a slack or surplus variable for every inequality and an artificial variable for every row that needs one.
+//A first phase minimizes the sum of the artificial variables to find a feasible basis, and the second phase optimizes the objective.
+//
+//The solver is the revised simplex method in BigFraction arithmetic, so every verdict and every value is exact.
+//The constraints are first multiplied by the lcm of their denominators, so the reduced costs are computed in integers.
+//The entering variable is the one with the most negative reduced cost (Dantzig's rule); after a run of degenerate pivots
+//it is the first one with a negative reduced cost and the leaving variable is the first one of the tied ratios, in the order of their indices
+//(Bland's rule), until the objective moves again. Bland's rule never cycles, so the method always terminates.
+//
+//The inverse of the basis is the product of the elementary matrices (etas) of an LU factorization and of one per pivot since then.
+//The elements of the pivot etas are ratios of ever larger minors, so their terms grow with every pivot and make each solve slower.
+//Every refactorPeriod pivots the basis is therefore factorized again from its own columns by sparse Gaussian elimination,
+//with the Markowitz choice of pivots: the unit columns of slack variables cost nothing and the other columns fill in little,
+//which keeps the denominators those of the current basis.
+class FractionLP
+{
+public:
+	enum Goal
+	{
+		eMinimize,
+		eMaximize
+	};
+
+	//Relation of a constraint a*x to its right-hand side b
+	enum Sense
+	{
+		eLessEqual,
+		eEqual,
+		eGreaterEqual
+	};
+
+	enum Status
+	{
+		eNotSolved,	//solve() has not been called since the last change
+		eOptimal,	//The optimal solution has been found
+		eInfeasible,	//No x satisfies the constraints
+		eUnbounded	//The objective has no finite optimum
+	};
+
+	//Term is one coefficient of a constraint.
+	struct Term
+	{
+		std::size_t variable;
+		Fraction coefficient;
+	};
+
+	//Number of pivots between two factorizations of the basis
+	static const std::size_t sc_nRefactorPeriod=4;
+
+private:
+	//The data members have been made private for information hiding.
+
+	std::size_t n;	//Number of variables
+	Goal goal;
+	std::vector<Fraction> cost;	//Coefficients of the objective
+	std::vector<std::size_t> rowStart;	//The terms of the row i are those from rowStart[i] to rowStart[i+1]
+	std::vector<Term> terms;
+	std::vector<Sense> senses;
+	std::vector<Fraction> rhs;
+
+	Status status;
+	BigFraction optimum;	//Value of the objective at the solution
+	std::vector<BigFraction> x;	//Solution
+	std::size_t pivots;	//Number of pivots of the last solve()
+	std::size_t factorizations;	//Number of factorizations of the basis in the last solve()
+
+public:
+
+	//Constructors
+
+	//This Constructor creates a program with the given number of variables, no constraints and a zero objective.
+	FractionLP(std::size_t variables,Goal=eMinimize);
+
+
+	//Modifiers
+	//The modifiers throw std::invalid_argument for a variable that does not exist.
+
+	//setObjective(j,c) sets the coefficient of the variable j in the objective.
+	void setObjective(std::size_t variable,const Fraction& coefficient);
+
+	//addConstraint(terms,sense,b) adds the constraint a*x<=b, a*x=b or a*x>=b, where a is given by its non zero terms,
+	//and returns its index. Terms of the same variable are added.
+	std::size_t addConstraint(const std::vector<Term>& terms,Sense,const Fraction& rhs);
+
+
+	//Solution
+
+	//solve(refactorPeriod) solves the program and returns its status.
+	Status solve(std::size_t refactorPeriod=sc_nRefactorPeriod);
+
+	std::size_t variables() const {return n;}
+	std::size_t constraints() const {return senses.size();}
+	Status result() const {return status;}
+
+	//objective() and value(j) are the optimal value of the objective and of the variable j. They are 0 unless the status is eOptimal.
+	const BigFraction& objective() const {return optimum;}
+	const BigFraction& value(std::size_t variable) const {return x[variable];}
+	const std::vector<BigFraction>& solution() const {return x;}
+
+	//iterations() is the number of pivots of both phases, and refactorizations() the number of factorizations of the basis, the first one included.
+	std::size_t iterations() const {return pivots;}
+	std::size_t refactorizations() const {return factorizations;}
+};
+
+#endif // __FRACTION_LP_H__
@@ -0,0 +1,311 @@
+#include "FractionMatrix.h"
+
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+#include <stdexcept>
+
+namespace
+{
+	//IntegerMatrix is the integer matrix [diag(L)*A|diag(L)*B*diag(C)] of a matrix A of Fractions and of right-hand sides B.
+	//L[i] is the lcm of the denominators of the row i of A, and C[t] the lcm of the denominators of the column t of diag(L)*B.
+	//The right-hand sides are scaled by columns so that their denominators do not enlarge the elements of A.
+	struct IntegerMatrix
+	{
+		std::size_t rows;
+		std::size_t columns;
+		std::vector<BigInteger> x;	//Elements, row by row
+		BigInteger rowScale;	//Product of the L[i]
+		std::vector<BigInteger> columnScale;	//C[t]
+		double bits;	//Hadamard bound of the minors, as a base 2 logarithm
+	};
+
+	//lcm(l,q) returns the lcm of l and the denominator q.
+	BigInteger lcm(const BigInteger& l,const BigInteger& q)
+	{
+		return (q==1) ? l : divExact(l,BigInteger::gcd(l,q))*q;
+	}
+
+	//clear(A,B) returns the integer matrix of A and B, which have the same number of rows. B may have no columns.
+	IntegerMatrix clear(const FractionMatrix& A,const FractionMatrix& B)
+	{
+		IntegerMatrix M;
+		std::size_t n=A.columns(),k=B.columns();
+		M.rows=A.rows();
+		M.columns=n+k;
+		M.x.resize(M.rows*M.columns);
+		M.rowScale=1;
+		M.columnScale.assign(k,BigInteger(1));
+		std::vector<BigFraction> b(M.rows*k);
+		for(std::size_t i=0;i<M.rows;i++)
+		{
+			BigInteger l=1;
+			for(std::size_t j=0;j<n;j++)
+				l=lcm(l,BigInteger::fromMagnitude(A(i,j).denominator(),false));
+			BigInteger* row=&M.x[i*M.columns];
+			for(std::size_t j=0;j<n;j++)
+			{
+				const Fraction& f=A(i,j);
+				row[j]=(f.denominator()==1) ? BigInteger(f.numerator())*l : BigInteger(f.numerator())*divExact(l,BigInteger::fromMagnitude(f.denominator(),false));
+			}
+			for(std::size_t t=0;t<k;t++)
+			{
+				b[i*k+t]=BigFraction(BigInteger(B(i,t).numerator())*l,BigInteger::fromMagnitude(B(i,t).denominator(),false));
+				M.columnScale[t]=lcm(M.columnScale[t],b[i*k+t].denominator());
+			}
+			M.rowScale=M.rowScale*l;
+		}
+		M.bits=0;
+		for(std::size_t i=0;i<M.rows;i++)
+		{
+			BigInteger* row=&M.x[i*M.columns];
+			for(std::size_t t=0;t<k;t++)
+				row[n+t]=b[i*k+t].numerator()*divExact(M.columnScale[t],b[i*k+t].denominator());
+			//The norm of a row is at most sqrt(columns) times its largest element, and a minor at most the product of the norms of its rows.
+			std::size_t top=0;
+			for(std::size_t j=0;j<M.columns;j++)
+				top=std::max(top,row[j].bitLength());
+			if(top>0)
+				M.bits+=static_cast<double>(top)+0.5*std::log2(static_cast<double>(M.columns));
+		}
+		return M;
+	}
+
+	//update(x,p,f,y,d) is the Bareiss update x=(p*x-f*y)/d, where the division is exact.
+	inline void update(BigInteger& x,const BigInteger& p,const BigInteger& f,const BigInteger& y,const BigInteger& d)
+	{
+		BigInteger t=f.isZero() ? p*x : p*x-f*y;
+		x=(d==1) ? t : divExact(t,d);
+	}
+
+#ifdef __SIZEOF_INT128__
+	//The 64 bit elements are minors below 2^62, so the products and their difference fit in 128 bits.
+	inline void update(std::int64_t& x,std::int64_t p,std::int64_t f,std::int64_t y,std::int64_t d)
+	{
+		x=static_cast<std::int64_t>((static_cast<__int128>(p)*x-static_cast<__int128>(f)*y)/d);
+	}
+#endif
+
+	//eliminate(x,rows,columns,limit,negative) brings the first limit columns of a matrix to echelon form by fraction-free elimination
+	//and applies the same row operations to the other columns. It returns the rank and sets negative if the rows were swapped an odd number of times.
+	//A column without a pivot is skipped and the divisor stays the last pivot, which keeps the divisions exact.
+	template<typename T>
+	std::size_t eliminate(std::vector<T>& x,std::size_t rows,std::size_t columns,std::size_t limit,bool& negative)
+	{
+		negative=false;
+		T d=1;
+		std::size_t r=0;
+		for(std::size_t c=0;c<limit && r<rows;c++)
+		{
+			std::size_t k=r;
+			while(k<rows && x[k*columns+c]==0)
+				k++;
+			if(k==rows)
+				continue;
+			if(k!=r)
+			{
+				std::swap_ranges(x.begin()+k*columns,x.begin()+(k+1)*columns,x.begin()+r*columns);
+				negative=!negative;
+			}
+			const T* pivot=&x[r*columns];
+			T p=pivot[c];
+			for(std::size_t i=r+1;i<rows;i++)
+			{
+				T* row=&x[i*columns];
+				T f=row[c];
+				row[c]=0;
+				for(std::size_t j=c+1;j<columns;j++)
+					update(row[j],p,f,pivot[j],d);
+			}
+			d=p;
+			r++;
+		}
+		return r;
+	}
+
+	//Echelon is the result of an elimination, with BigInteger elements whatever the type used for it.
+	struct Echelon
+	{
+		std::vector<BigInteger> x;
+		std::size_t rank;
+		bool negative;
+	};
+
+	//echelon(M,limit) eliminates the first limit columns of M, on 64 bit integers if the Hadamard bound allows it.
+	Echelon echelon(IntegerMatrix& M,std::size_t limit)
+	{
+		Echelon E;
+#ifdef __SIZEOF_INT128__
+		if(M.bits<62)
+		{
+			std::vector<std::int64_t> y(M.x.size());
+			for(std::size_t i=0;i<y.size();i++)
+				y[i]=M.x[i].toInt64();
+			E.rank=eliminate(y,M.rows,M.columns,limit,E.negative);
+			E.x.reserve(y.size());
+			for(std::size_t i=0;i<y.size();i++)
+				E.x.push_back(BigInteger(y[i]));
+			return E;
+		}
+#endif
+		E.rank=eliminate(M.x,M.rows,M.columns,limit,E.negative);
+		E.x.swap(M.x);
+		return E;
+	}
+
+	void singular()
+	{
+		throw std::runtime_error("Math error: singular matrix\n");
+	}
+
+	//solveColumns(A,B) returns the solution X of A*X=B.
+	//After the elimination of [A|B] the pivots are the leading principal minors, the last one D being the determinant up to its sign.
+	//D*X is then an integer matrix (Cramer's rule), found by fraction-free back substitution, and X is reduced once at the end,
+	//dividing out the scale of its column too.
+	FractionMatrix solveColumns(const FractionMatrix& A,const FractionMatrix& B)
+	{
+		if(A.rows()!=A.columns())
+		{
+			throw std::invalid_argument("FractionMatrix: the matrix is not square");
+		}
+		if(B.rows()!=A.rows())
+		{
+			throw std::invalid_argument("FractionMatrix: the right-hand side has the wrong number of rows");
+		}
+		std::size_t n=A.rows(),k=B.columns();
+		IntegerMatrix M=clear(A,B);
+		Echelon E=echelon(M,n);
+		if(E.rank<n)
+			singular();
+		std::size_t columns=n+k;
+		FractionMatrix X(n,k);
+		if(n==0)
+			return X;
+		const BigInteger& D=E.x[(n-1)*columns+n-1];
+		std::vector<BigInteger> y(n);
+		for(std::size_t t=0;t<k;t++)
+		{
+			for(std::size_t i=n;i-->0;)
+			{
+				const BigInteger* row=&E.x[i*columns];
+				BigInteger s=D*row[n+t];
+				for(std::size_t j=i+1;j<n;j++)
+					if(!row[j].isZero())
+						s=s-row[j]*y[j];
+				y[i]=divExact(s,row[i]);
+			}
+			for(std::size_t i=0;i<n;i++)
+				X(i,t)=BigFraction(y[i],D*M.columnScale[t]).toFraction<std::int32_t>();
+		}
+		return X;
+	}
+}
+
+//Constructor of a zero matrix
+FractionMatrix::FractionMatrix(std::size_t rows,std::size_t columns)
+: m(rows),n(columns),a(rows*columns,Fraction::sc_fZero)
+{
+}
+
+//Constructor from a list of rows
+FractionMatrix::FractionMatrix(const std::vector<std::vector<Fraction> >& rows)
+: m(rows.size()),n(rows.empty() ? 0 : rows[0].size())
+{
+	a.reserve(m*n);
+	for(std::size_t i=0;i<m;i++)
+	{
+		if(rows[i].size()!=n)
+		{
+			throw std::invalid_argument("FractionMatrix: the rows have different lengths");
+		}
+		a.insert(a.end(),rows[i].begin(),rows[i].end());
+	}
+}
+
+//Identity matrix
+FractionMatrix FractionMatrix::identity(std::size_t n)
+{
+	FractionMatrix I(n,n);
+	for(std::size_t i=0;i<n;i++)
+		I(i,i)=Fraction::sc_fUnity;
+	return I;
+}
+
+//Determinant
+//Each row of the integer matrix was multiplied by its lcm, so the determinant of the matrix is the last pivot divided by their product.
+BigFraction FractionMatrix::determinant() const
+{
+	if(m!=n)
+	{
+		throw std::invalid_argument("FractionMatrix: the matrix is not square");
+	}
+	if(n==0)
+		return BigFraction::sc_fUnity;
+	IntegerMatrix M=clear(*this,FractionMatrix(m,0));
+	Echelon E=echelon(M,n);
+	if(E.rank<n)
+		return BigFraction::sc_fZero;
+	const BigInteger& D=E.x[n*n-1];
+	return BigFraction(E.negative ? -D : D,M.rowScale);
+}
+
+//Rank
+//Multiplying a row by a non zero integer does not change the rank.
+std::size_t FractionMatrix::rank() const
+{
+	IntegerMatrix M=clear(*this,FractionMatrix(m,0));
+	return echelon(M,n).rank;
+}
+
+//Linear system with one right-hand side
+std::vector<Fraction> FractionMatrix::solve(const std::vector<Fraction>& b) const
+{
+	FractionMatrix B(b.size(),1);
+	B.a=b;
+	return solveColumns(*this,B).a;
+}
+
+//Linear system with several right-hand sides
+FractionMatrix FractionMatrix::solve(const FractionMatrix& B) const
+{
+	return solveColumns(*this,B);
+}
+
+//Inverse
+FractionMatrix FractionMatrix::inverse() const
+{
+	return solveColumns(*this,identity(m));
+}
+
+//Matrix product
+FractionMatrix operator*(const FractionMatrix& lhs,const FractionMatrix& rhs)
+{
+	if(lhs.n!=rhs.m)
+	{
+		throw std::invalid_argument("FractionMatrix: the matrices cannot be multiplied");
+	}
+	FractionMatrix P(lhs.m,rhs.n);
+	for(std::size_t i=0;i<lhs.m;i++)
+		for(std::size_t j=0;j<rhs.n;j++)
+		{
+			BigFraction s=BigFraction::sc_fZero;
+			for(std::size_t k=0;k<lhs.n;k++)
+				if(lhs(i,k).numerator()!=0 && rhs(k,j).numerator()!=0)
+					s=s+BigFraction(lhs(i,k))*BigFraction(rhs(k,j));
+			P(i,j)=s.toFraction<std::int32_t>();
+		}
+	return P;
+}
+
+//Output Operator
+std::ostream& operator<<(std::ostream &OUT,const FractionMatrix &rhs)
+{
+	for(std::size_t i=0;i<rhs.m;i++)
+	{
+		OUT << "[";
+		for(std::size_t j=0;j<rhs.n;j++)
+			OUT << (j ? ", " : "") << rhs(i,j);
+		OUT << "]\n";
+	}
+	return OUT;
+}
@@ -0,0 +1,97 @@
+#ifndef __FRACTION_MATRIX_H__
+#define __FRACTION_MATRIX_H__
+
+#include <cstddef>
+#include <iostream>
+#include <vector>
+
+#include "BigFraction.h"
+#include "Fraction.h"
+
+//FractionMatrix is a dense matrix of Fractions, stored row by row, with exact determinant, rank, linear solver and inverse.
+//
+//Gaussian elimination on Fractions normalizes every intermediate element, at the cost of a gcd per operation,
+//and the intermediates soon outgrow 32 bits even when the result is small.
+//The algorithms here clear the denominators of each row instead, multiplying it by the lcm of its denominators,
+//and run fraction-free Bareiss elimination on the integer matrix: the update of the step k is
+//	a[i][j]=(a[k][k]*a[i][j]-a[i][k]*a[k][j])/a[k-1][k-1]
+//where the division is exact, because every element is a minor of the integer matrix (Bareiss, Math. Comp. 22, 1968).
+//No gcd is computed during the elimination and the elements grow only as fast as the determinant.
+//The results are divided out and reduced once at the end.
+//
+//The elimination runs on 64 bit integers with 128 bit products when the Hadamard bound of the integer matrix shows that every minor fits,
+//and on BigIntegers otherwise. The rows are updated one after the other, each with a single pass over its contiguous elements.
+//
+//determinant() returns a BigFraction because the determinant of a matrix of Fractions seldom fits in a Fraction.
+//solve() and inverse() return Fractions and throw std::overflow_error if an element of the result does not fit.
+//A singular matrix throws std::runtime_error and operands of the wrong size std::invalid_argument.
+class FractionMatrix
+{
+private:
+	//The data members have been made private for information hiding.
+
+	std::size_t m;	//Number of rows
+	std::size_t n;	//Number of columns
+	std::vector<Fraction> a;	//Elements, row by row
+
+public:
+
+	//Constructors
+
+	//This Constructor creates a matrix of the given size whose elements are 0.
+	FractionMatrix(std::size_t rows=0,std::size_t columns=0);
+
+	//This Constructor creates a matrix from a list of rows of equal length, e.g. FractionMatrix({{1,2},{3,Fraction(1,2)}}).
+	//It throws std::invalid_argument if the rows have different lengths.
+	FractionMatrix(const std::vector<std::vector<Fraction> >& rows);
+
+	//identity(n) returns the n by n identity matrix.
+	static FractionMatrix identity(std::size_t n);
+
+
+	//Accessors
+
+	std::size_t rows() const {return m;}
+	std::size_t columns() const {return n;}
+
+	//M(i,j) is the element in the row i and the column j. The indices are not checked.
+	Fraction& operator()(std::size_t i,std::size_t j) {return a[i*n+j];}
+	const Fraction& operator()(std::size_t i,std::size_t j) const {return a[i*n+j];}
+
+
+	//Exact Linear Algebra
+
+	//determinant() returns the determinant of a square matrix.
+	BigFraction determinant() const;
+
+	//rank() returns the rank of the matrix, the number of pivots of its echelon form.
+	std::size_t rank() const;
+
+	//solve(b) returns the x for which M*x=b. M must be square and non singular.
+	std::vector<Fraction> solve(const std::vector<Fraction>& b) const;
+
+	//solve(B) returns the X for which M*X=B, solving all the columns of B in one elimination.
+	FractionMatrix solve(const FractionMatrix& B) const;
+
+	//inverse() returns the inverse of a square non singular matrix.
+	FractionMatrix inverse() const;
+
+
+	//Binary Operators
+
+	//M1*M2 <------> operator*(M1,M2)
+	//The dot products are accumulated exactly. It throws std::overflow_error if an element of the product does not fit in a Fraction.
+	friend FractionMatrix operator*(const FractionMatrix&,const FractionMatrix&);
+
+	friend bool operator==(const FractionMatrix& lhs,const FractionMatrix& rhs) {return lhs.m==rhs.m && lhs.n==rhs.n && lhs.a==rhs.a;}
+	friend bool operator!=(const FractionMatrix& lhs,const FractionMatrix& rhs) {return !(lhs==rhs);}
+
+
+	//Output Operator
+
+	//std::cout << M1 <------> operator<<(cout,M1)
+	//Each row is written on its own line as the elements separated by commas within square brackets.
+	friend std::ostream& operator<<(std::ostream&,const FractionMatrix&);
+};
+
+#endif // __FRACTION_MATRIX_H__
@@ -0,0 +1,413 @@
+#include "FractionPolynomial.h"
+
+#include <algorithm>
+#include <stdexcept>
+
+//Products of two polynomials with at least this many coefficients each use Karatsuba multiplication.
+#ifndef FRACTION_POLYNOMIAL_KARATSUBA_THRESHOLD
+#define FRACTION_POLYNOMIAL_KARATSUBA_THRESHOLD 16
+#endif
+
+namespace
+{
+	typedef FractionPolynomial::Numerators Coefficients;
+
+	//trim(c) removes the zero top coefficients.
+	void trim(Coefficients& c)
+	{
+		while(!c.empty() && c.back().isZero())
+			c.pop_back();
+	}
+
+	//content(c) returns the non negative gcd of the coefficients.
+	BigInteger content(const Coefficients& c)
+	{
+		BigInteger g(0);
+		for(const BigInteger& x : c)
+		{
+			if(g==1)
+				break;
+			if(!x.isZero())
+				g=BigInteger::gcd(g,x);
+		}
+		return g;
+	}
+
+	//primitive(c) divides the coefficients by their content and makes the top one positive.
+	void primitive(Coefficients& c)
+	{
+		trim(c);
+		if(c.empty())
+			return;
+		BigInteger g=content(c);
+		if(c.back().isNegative())
+			g=-g;
+		if(g!=1)
+			for(BigInteger& x : c)
+				x=divExact(x,g);
+	}
+
+	//addAt(r,x,n,offset) adds the n coefficients at x to r from the coefficient offset on, growing r if needed.
+	void addAt(Coefficients& r,const BigInteger* x,std::size_t n,std::size_t offset)
+	{
+		if(r.size()<offset+n)
+			r.resize(offset+n);
+		for(std::size_t i=0;i<n;i++)
+			if(!x[i].isZero())
+				r[offset+i]=r[offset+i]+x[i];
+	}
+
+	//addSpan(x,nx,y,ny) returns the sum of two coefficient arrays.
+	Coefficients addSpan(const BigInteger* x,std::size_t nx,const BigInteger* y,std::size_t ny)
+	{
+		Coefficients r(x,x+nx);
+		addAt(r,y,ny,0);
+		return r;
+	}
+
+	//mulSchool(x,nx,y,ny) multiplies two polynomials by the schoolbook method.
+	Coefficients mulSchool(const BigInteger* x,std::size_t nx,const BigInteger* y,std::size_t ny)
+	{
+		Coefficients r(nx+ny-1);
+		for(std::size_t i=0;i<nx;i++)
+		{
+			if(x[i].isZero())
+				continue;
+			for(std::size_t j=0;j<ny;j++)
+				if(!y[j].isZero())
+					r[i+j]=r[i+j]+x[i]*y[j];
+		}
+		return r;
+	}
+
+	//mulSpan(x,nx,y,ny) multiplies two polynomials. Below the threshold it uses the schoolbook method.
+	//Above it splits both operands at half the longer length and forms three half size products (Karatsuba), so the cost is O(n^1.585) coefficient products.
+	//Unbalanced operands are cut into pieces of the length of the shorter one first.
+	Coefficients mulSpan(const BigInteger* x,std::size_t nx,const BigInteger* y,std::size_t ny)
+	{
+		if(nx<ny)
+		{
+			std::swap(x,y);
+			std::swap(nx,ny);
+		}
+		if(ny==0)
+			return Coefficients();
+		if(ny<FRACTION_POLYNOMIAL_KARATSUBA_THRESHOLD)
+			return mulSchool(x,nx,y,ny);
+		if(2*ny<=nx)
+		{
+			Coefficients r(nx+ny-1);
+			for(std::size_t offset=0;offset<nx;offset+=ny)
+			{
+				Coefficients part=mulSpan(x+offset,std::min(ny,nx-offset),y,ny);
+				addAt(r,part.data(),part.size(),offset);
+			}
+			return r;
+		}
+		std::size_t h=(nx+1)/2;
+		std::size_t ny0=std::min(h,ny);
+		Coefficients z0=mulSpan(x,h,y,ny0);
+		Coefficients z2=mulSpan(x+h,nx-h,y+ny0,ny-ny0);
+		Coefficients sx=addSpan(x,h,x+h,nx-h);
+		Coefficients sy=addSpan(y,ny0,y+ny0,ny-ny0);
+		Coefficients z1=mulSpan(sx.data(),sx.size(),sy.data(),sy.size());
+		for(std::size_t i=0;i<z0.size();i++)
+			z1[i]=z1[i]-z0[i];
+		for(std::size_t i=0;i<z2.size();i++)
+			z1[i]=z1[i]-z2[i];
+		Coefficients r(nx+ny-1);
+		addAt(r,z0.data(),z0.size(),0);
+		addAt(r,z1.data(),z1.size(),h);
+		addAt(r,z2.data(),z2.size(),2*h);
+		return r;
+	}
+
+	//divide(a,b,q,r,s) divides the integer polynomial a by the non zero b over the rationals: a=(q/s)*b+r/s with deg r < deg b.
+	//Each step cancels the top coefficient t of the remainder with the smallest multiple of the remainder:
+	//with g=gcd(t,lc(b)) the remainder becomes (lc(b)/g)*r-(t/g)*x^k*b, and the quotient and s are multiplied by lc(b)/g too.
+	//When lc(b) divides every t, as for a monic b, the coefficients do not grow at all. q may be null when only the remainder is needed.
+	void divide(const Coefficients& a,const Coefficients& b,Coefficients* q,Coefficients& r,BigInteger& s)
+	{
+		r=a;
+		s=1;
+		std::size_t n=b.size()-1;
+		const BigInteger& lc=b.back();
+		if(q)
+			q->assign(r.size()>n ? r.size()-n : 0,BigInteger(0));
+		trim(r);
+		while(r.size()>n)
+		{
+			std::size_t k=r.size()-1-n;
+			BigInteger g=BigInteger::gcd(r.back(),lc);
+			BigInteger u=divExact(lc,g),v=divExact(r.back(),g);
+			if(u!=1)
+			{
+				for(BigInteger& x : r)
+					x=x*u;
+				if(q)
+					for(BigInteger& x : *q)
+						x=x*u;
+				s=s*u;
+			}
+			for(std::size_t i=0;i<n;i++)
+				if(!b[i].isZero())
+					r[k+i]=r[k+i]-v*b[i];
+			r.pop_back();
+			if(q)
+				(*q)[k]=v;
+			trim(r);
+		}
+	}
+}
+
+//Constructor of the zero polynomial
+FractionPolynomial::FractionPolynomial()
+: d(1)
+{
+}
+
+//Constructor from Fractions
+//The denominator is the lcm of those of the coefficients.
+FractionPolynomial::FractionPolynomial(const std::vector<Fraction>& coefficients)
+: d(1)
+{
+	for(const Fraction& c : coefficients)
+	{
+		BigInteger q=BigInteger::fromMagnitude(c.denominator(),false);
+		if(q!=1)
+			d=divExact(d,BigInteger::gcd(d,q))*q;
+	}
+	a.reserve(coefficients.size());
+	for(const Fraction& c : coefficients)
+	{
+		BigInteger q=BigInteger::fromMagnitude(c.denominator(),false);
+		a.push_back(BigInteger(c.numerator())*((q==1) ? d : divExact(d,q)));
+	}
+	normalize();
+}
+
+//Constructor from numerators and a denominator
+FractionPolynomial::FractionPolynomial(const std::vector<BigInteger>& numerators,const BigInteger& denominator)
+: a(numerators.begin(),numerators.end()),d(denominator)
+{
+	if(d.isZero())
+	{
+		throw std::runtime_error("Math error: Attempted to divide by Zero\n");
+	}
+	normalize();
+}
+
+FractionPolynomial::FractionPolynomial(const Numerators& numerators,const BigInteger& denominator)
+: a(numerators),d(denominator)
+{
+	if(d.isZero())
+	{
+		throw std::runtime_error("Math error: Attempted to divide by Zero\n");
+	}
+	normalize();
+}
+
+//Normalization
+//The gcd of the denominator and the numerators is accumulated until it reaches 1, which for most polynomials takes a few coefficients.
+void FractionPolynomial::normalize()
+{
+	trim(a);
+	if(a.empty())
+	{
+		d=1;
+		return;
+	}
+	if(d.isNegative())
+	{
+		d=-d;
+		for(BigInteger& x : a)
+			x=-x;
+	}
+	BigInteger g=d;
+	for(const BigInteger& x : a)
+	{
+		if(g==1)
+			return;
+		if(!x.isZero())
+			g=BigInteger::gcd(g,x);
+	}
+	if(g==1)
+		return;
+	d=divExact(d,g);
+	for(BigInteger& x : a)
+		x=divExact(x,g);
+}
+
+//Coefficient
+BigFraction FractionPolynomial::coefficient(std::size_t i) const
+{
+	return (i<a.size()) ? BigFraction(a[i],d) : BigFraction(0);
+}
+
+//Evaluation
+//At x=p/q, s=a[n], then s=s*p+a[i]*q^(n-i) for i=n-1..0 gives the numerator of the value over d*q^n.
+BigFraction FractionPolynomial::evaluate(const BigFraction& x) const
+{
+	if(a.empty())
+		return BigFraction(0);
+	const BigInteger& p=x.numerator();
+	const BigInteger& q=x.denominator();
+	if(p.isZero())
+		return BigFraction(a[0],d);
+	BigInteger s=a.back();
+	if(q==1)
+	{
+		for(std::size_t i=a.size()-1;i-->0;)
+			s=s*p+a[i];
+		return BigFraction(s,d);
+	}
+	BigInteger power(1);
+	for(std::size_t i=a.size()-1;i-->0;)
+	{
+		power=power*q;
+		s=s*p;
+		if(!a[i].isZero())
+			s=s+a[i]*power;
+	}
+	return BigFraction(s,d*power);
+}
+
+//Unary Minus
+FractionPolynomial FractionPolynomial::operator-() const
+{
+	FractionPolynomial P(*this);
+	for(BigInteger& x : P.a)
+		x=-x;
+	return P;
+}
+
+//Binary Plus
+//The operands are brought to the lcm of their denominators.
+FractionPolynomial operator+(const FractionPolynomial& lhs,const FractionPolynomial& rhs)
+{
+	FractionPolynomial P;
+	if(lhs.d==rhs.d)
+	{
+		P.a=lhs.a;
+		P.d=lhs.d;
+		addAt(P.a,rhs.a.data(),rhs.a.size(),0);
+	}
+	else
+	{
+		BigInteger g=BigInteger::gcd(lhs.d,rhs.d);
+		BigInteger u=divExact(rhs.d,g),v=divExact(lhs.d,g);
+		P.a.resize(std::max(lhs.a.size(),rhs.a.size()));
+		for(std::size_t i=0;i<lhs.a.size();i++)
+			P.a[i]=lhs.a[i]*u;
+		for(std::size_t i=0;i<rhs.a.size();i++)
+			if(!rhs.a[i].isZero())
+				P.a[i]=P.a[i]+rhs.a[i]*v;
+		P.d=lhs.d*u;
+	}
+	P.normalize();
+	return P;
+}
+
+//Binary Minus
+FractionPolynomial operator-(const FractionPolynomial& lhs,const FractionPolynomial& rhs)
+{
+	return lhs+(-rhs);
+}
+
+//Multiply
+FractionPolynomial operator*(const FractionPolynomial& lhs,const FractionPolynomial& rhs)
+{
+	FractionPolynomial P;
+	P.a=mulSpan(lhs.a.data(),lhs.a.size(),rhs.a.data(),rhs.a.size());
+	P.d=lhs.d*rhs.d;
+	P.normalize();
+	return P;
+}
+
+//Division with remainder
+//With A=a/dA and B=b/dB, a=(q/s)*b+r/s gives A=(q*dB/(s*dA))*B+r/(s*dA).
+void divMod(const FractionPolynomial& lhs,const FractionPolynomial& rhs,FractionPolynomial& Q,FractionPolynomial& R)
+{
+	if(rhs.isZero())
+	{
+		throw std::runtime_error("Math error: Attempted to divide by Zero\n");
+	}
+	Coefficients q,r;
+	BigInteger s;
+	divide(lhs.a,rhs.a,&q,r,s);
+	BigInteger denominator=s*lhs.d;
+	for(BigInteger& x : q)
+		x=x*rhs.d;
+	Q=FractionPolynomial(q,denominator);
+	R=FractionPolynomial(r,denominator);
+}
+
+FractionPolynomial operator/(const FractionPolynomial& lhs,const FractionPolynomial& rhs)
+{
+	FractionPolynomial Q,R;
+	divMod(lhs,rhs,Q,R);
+	return Q;
+}
+
+FractionPolynomial operator%(const FractionPolynomial& lhs,const FractionPolynomial& rhs)
+{
+	FractionPolynomial Q,R;
+	divMod(lhs,rhs,Q,R);
+	return R;
+}
+
+//Greatest Common Divisor
+//The remainders are only needed up to a constant factor, so each one is replaced by its primitive part.
+FractionPolynomial FractionPolynomial::gcd(const FractionPolynomial& lhs,const FractionPolynomial& rhs)
+{
+	Coefficients x=lhs.a,y=rhs.a,r;
+	BigInteger s;
+	if(x.size()<y.size())
+		x.swap(y);
+	primitive(x);
+	primitive(y);
+	while(!y.empty())
+	{
+		divide(x,y,nullptr,r,s);
+		primitive(r);
+		x.swap(y);
+		y.swap(r);
+	}
+	if(x.empty())
+		return FractionPolynomial();
+	BigInteger lc=x.back();
+	return FractionPolynomial(x,lc);
+}
+
+//Output Operator
+std::ostream& operator<<(std::ostream &OUT,const FractionPolynomial &rhs)
+{
+	if(rhs.a.empty())
+	{
+		OUT << 0;
+		return OUT;
+	}
+	bool first=true;
+	for(std::size_t i=rhs.a.size();i-->0;)
+	{
+		if(rhs.a[i].isZero())
+			continue;
+		BigFraction c(rhs.a[i].abs(),rhs.d);
+		if(first)
+			OUT << (rhs.a[i].isNegative() ? "-" : "");
+		else
+			OUT << (rhs.a[i].isNegative() ? " - " : " + ");
+		first=false;
+		if(i==0)
+			OUT << c;
+		else if(c.denominator()!=1)
+			OUT << "(" << c << ")";
+		else if(c.numerator()!=1)
+			OUT << c;
+		if(i>=1)
+			OUT << "x";
+		if(i>=2)
+			OUT << "^" << i;
+	}
+	return OUT;
+}
@@ -0,0 +1,119 @@
+#ifndef __FRACTION_POLYNOMIAL_H__
+#define __FRACTION_POLYNOMIAL_H__
+
+#include <cstddef>
+#include <iostream>
+#include <vector>
+
+#include "BigFraction.h"
+#include "BigInteger.h"
+#include "Fraction.h"
+#include "FractionArena.h"
+
+//FractionPolynomial is a polynomial in one variable with rational coefficients, stored as an integer polynomial and one common denominator.
+//
+//Sums and products of polynomials kept as arrays of Fractions normalize every coefficient of every intermediate result,
+//and their terms soon overflow. Here the numerators are BigIntegers and the denominator is shared, so the coefficient arithmetic is integer arithmetic
+//and a whole result is reduced once, by the gcd of its denominator and the content of its numerators.
+//Products of polynomials with at least FRACTION_POLYNOMIAL_KARATSUBA_THRESHOLD coefficients use Karatsuba multiplication.
+//
+//evaluate(x) at x=p/q uses Horner's rule on the homogeneous form a[n]*p^n+a[n-1]*p^(n-1)*q+...+a[0]*q^n, all in integers,
+//and normalizes only the final BigFraction.
+//
+//Division and the gcd are exact over the rationals. gcd() runs Euclid's algorithm on primitive integer polynomials (primitive remainder sequence),
+//which keeps the coefficients of the remainders as small as their content allows, and returns a monic polynomial.
+//Division by the zero polynomial throws std::runtime_error.
+class FractionPolynomial
+{
+public:
+	//Numerators is the vector of the numerators. Like the limbs of BigInteger it allocates through ArenaAllocator,
+	//so the temporary polynomials of the Karatsuba recursion come from the FractionArena of the thread when one is installed.
+	typedef std::vector<BigInteger,ArenaAllocator<BigInteger> > Numerators;
+
+private:
+	//The data members have been made private for information hiding.
+	//The polynomial is the sum of a[i]/d*x^i. The top element of a is not zero, d is positive and it has no common factor with all the a[i].
+	//The zero polynomial has no coefficients and the denominator 1.
+
+	Numerators a;	//Numerators of the coefficients, the constant term first
+	BigInteger d;	//Common denominator
+
+	//normalize() removes the zero top coefficients and the common factors of the numerators and the denominator, and makes the denominator positive.
+	void normalize();
+
+public:
+
+	//Constructors
+
+	//This Constructor creates the zero polynomial.
+	FractionPolynomial();
+
+	//This Constructor creates the polynomial with the given coefficients, the constant term first, e.g. FractionPolynomial({1,0,Fraction(1,2)}) is 1+x^2/2.
+	FractionPolynomial(const std::vector<Fraction>& coefficients);
+
+	//This Constructor creates the polynomial sum of numerators[i]/denominator*x^i.
+	//It throws std::runtime_error if the denominator is 0.
+	FractionPolynomial(const std::vector<BigInteger>& numerators,const BigInteger& denominator=BigInteger(1));
+	FractionPolynomial(const Numerators& numerators,const BigInteger& denominator=BigInteger(1));
+
+
+	//Accessors
+
+	//degree() returns the degree of the polynomial, and -1 for the zero polynomial.
+	int degree() const {return static_cast<int>(a.size())-1;}
+
+	bool isZero() const {return a.empty();}
+
+	//coefficient(i) returns the coefficient of x^i, which is 0 above the degree.
+	BigFraction coefficient(std::size_t i) const;
+
+	//numerators() and denominator() return the common denominator form.
+	const Numerators& numerators() const {return a;}
+	const BigInteger& denominator() const {return d;}
+
+
+	//Evaluation
+
+	//evaluate(x) returns the exact value of the polynomial at x. P(x) is the same.
+	BigFraction evaluate(const BigFraction& x) const;
+	BigFraction operator()(const BigFraction& x) const {return evaluate(x);}
+
+
+	//Unary Arithmetic Operators
+
+	//-P1 <-------> P1.operator-()
+	FractionPolynomial operator-() const;
+
+
+	//Binary Arithmetic Operators
+	//P1/P2 and P1%P2 are the quotient and the remainder of the division over the rationals: P1=Q*P2+R with deg R < deg P2.
+
+	friend FractionPolynomial operator+(const FractionPolynomial&,const FractionPolynomial&);
+	friend FractionPolynomial operator-(const FractionPolynomial&,const FractionPolynomial&);
+	friend FractionPolynomial operator*(const FractionPolynomial&,const FractionPolynomial&);
+	friend FractionPolynomial operator/(const FractionPolynomial&,const FractionPolynomial&);
+	friend FractionPolynomial operator%(const FractionPolynomial&,const FractionPolynomial&);
+
+	//divMod(P1,P2,Q,R) computes the quotient and the remainder of one division at once.
+	friend void divMod(const FractionPolynomial&,const FractionPolynomial&,FractionPolynomial&,FractionPolynomial&);
+
+	//gcd(P1,P2) returns the monic Greatest Common Divisor of two polynomials, and the zero polynomial if both are zero.
+	static FractionPolynomial gcd(const FractionPolynomial&,const FractionPolynomial&);
+
+
+	//Binary Relational Operators
+
+	friend bool operator==(const FractionPolynomial& lhs,const FractionPolynomial& rhs) {return lhs.d==rhs.d && lhs.a==rhs.a;}
+	friend bool operator!=(const FractionPolynomial& lhs,const FractionPolynomial& rhs) {return !(lhs==rhs);}
+
+
+	//Output Operator
+
+	//std::cout << P1 <------> operator<<(cout,P1)
+	//The terms are written from the highest degree, e.g. (3 / 2)x^2 - x + 1 / 4.
+	friend std::ostream& operator<<(std::ostream&,const FractionPolynomial&);
+};
+
+void divMod(const FractionPolynomial&,const FractionPolynomial&,FractionPolynomial&,FractionPolynomial&);
+
+#endif // __FRACTION_POLYNOMIAL_H__
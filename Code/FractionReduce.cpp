@@ -0,0 +1,55 @@
+#include "FractionReduce.h"
+
+#include <atomic>
+#include <exception>
+#include <mutex>
+#include <thread>
+
+void fraction::detail::parallelFor(std::size_t tasks,unsigned threads,const std::function<void(std::size_t)>& task)
+{
+	if(threads==0)
+		threads=std::thread::hardware_concurrency();
+	if(threads==0)
+		threads=1;
+	if(threads>tasks)
+		threads=static_cast<unsigned>(tasks);
+
+	std::atomic<std::size_t> next(0);
+	std::exception_ptr error;
+	std::mutex errorMutex;
+	auto worker=[&]()
+	{
+		for(std::size_t k=next++;k<tasks;k=next++)
+		{
+			try
+			{
+				task(k);
+			}
+			catch(...)
+			{
+				std::lock_guard<std::mutex> lock(errorMutex);
+				if(!error)
+					error=std::current_exception();
+				next=tasks;
+			}
+		}
+	};
+
+	//If a thread cannot be started, e.g. std::system_error when the process is out of threads, the ones already started
+	//and the calling thread share the tasks: no joinable thread is destroyed and every task still runs.
+	std::vector<std::thread> pool;
+	pool.reserve(threads-1);
+	try
+	{
+		for(unsigned t=1;t<threads;t++)
+			pool.emplace_back(worker);
+	}
+	catch(...)
+	{
+	}
+	worker();
+	for(std::size_t t=0;t<pool.size();t++)
+		pool[t].join();
+	if(error)
+		std::rethrow_exception(error);
+}
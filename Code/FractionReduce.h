@@ -0,0 +1,152 @@
+#ifndef __FRACTION_REDUCE_H__
+#define __FRACTION_REDUCE_H__
+
+#include <cstddef>
+#include <functional>
+#include <stdexcept>
+#include <vector>
+
+#include "BigFraction.h"
+#include "Fraction.h"
+#include "LazyFraction.h"
+
+//Parallel exact reductions over arrays of Fractions.
+//
+//reduce_sum, reduce_product and dot split the range into chunks of sc_nReduceChunk elements that idle threads claim one after the other.
+//Every chunk is reduced as a pairwise tree of LazyFractions, and the chunk results are combined by one more pairwise tree.
+//Pairwise trees keep the operands of every addition of similar size, so the denominators stay as small as possible,
+//and the lazy intermediates compute a gcd only when a product would overflow.
+//
+//The arithmetic is exact, so the result is the value of the serial fold, whatever the number of threads.
+//If an intermediate does not fit in the 128 bit terms of LazyFraction, the reduction is redone with BigFraction.
+//std::overflow_error is thrown only if the result itself does not fit in the Fraction type,
+//so a reduction also succeeds where a serial fold over operator+ would overflow on a partial sum.
+//
+//The number of threads defaults to std::thread::hardware_concurrency(). Ranges of a single chunk run on the calling thread.
+//The sources using these functions are linked with FractionReduce.cpp and -pthread.
+namespace fraction
+{
+	//Number of elements reduced by one task
+	static const std::size_t sc_nReduceChunk=4096;
+
+	namespace detail
+	{
+		//parallelFor(tasks,threads,task) calls task(k) for k in [0,tasks) on up to threads threads, the calling thread included.
+		//Each thread claims the next unstarted task when it finishes one, so uneven tasks balance out.
+		//The first exception thrown by a task is rethrown on the calling thread after all threads have joined.
+		//A thread that cannot be started is not an error: its share of the tasks runs on the threads that did start.
+		void parallelFor(std::size_t tasks,unsigned threads,const std::function<void(std::size_t)>& task);
+
+		//pairwise(first,last,load,combine) reduces load(i) for i in [first,last) as a balanced tree of combine().
+		//Runs of up to eight elements are folded from left to right.
+		template<typename T,typename Load,typename Combine>
+		T pairwise(std::size_t first,std::size_t last,Load& load,Combine& combine)
+		{
+			if(last-first<=8)
+			{
+				T r=load(first);
+				for(std::size_t i=first+1;i<last;i++)
+					r=combine(r,load(i));
+				return r;
+			}
+			std::size_t middle=first+(last-first)/2;
+			return combine(pairwise<T>(first,middle,load,combine),pairwise<T>(middle,last,load,combine));
+		}
+
+		//reduceRange<T>(n,load,combine,threads) reduces the n loaded values of a non empty range in chunks and combines the chunk results.
+		//The chunking does not depend on the number of threads, so the tree and the result are always the same.
+		template<typename T,typename Load,typename Combine>
+		T reduceRange(std::size_t n,Load& load,Combine& combine,unsigned threads)
+		{
+			std::size_t chunks=(n+sc_nReduceChunk-1)/sc_nReduceChunk;
+			std::vector<T> partial(chunks);
+			parallelFor(chunks,threads,[&](std::size_t k)
+			{
+				std::size_t first=k*sc_nReduceChunk;
+				std::size_t last=(first+sc_nReduceChunk<n) ? first+sc_nReduceChunk : n;
+				partial[k]=pairwise<T>(first,last,load,combine);
+			});
+			auto part=[&](std::size_t k) {return partial[k];};
+			return pairwise<T>(0,chunks,part,combine);
+		}
+
+		//reduce(n,identity,load,combine,threads) is the common implementation of the reductions.
+		//load is a generic callable: load(T(),i) returns the element i converted to the accumulation type T.
+		//The reduction runs in BasicLazyFraction<IntT> and falls back to BigFraction if an intermediate overflows it.
+		template<typename IntT,typename Load,typename Combine>
+		BasicFraction<IntT> reduce(std::size_t n,IntT identity,Load load,Combine combine,unsigned threads)
+		{
+			if(n==0)
+				return BasicFraction<IntT>(identity);
+			BasicLazyFraction<IntT> lazy;
+			bool exact=true;
+			try
+			{
+				auto loadLazy=[&](std::size_t i) {return load(BasicLazyFraction<IntT>(),i);};
+				lazy=reduceRange<BasicLazyFraction<IntT> >(n,loadLazy,combine,threads);
+			}
+			catch(const std::overflow_error&)
+			{
+				exact=false;
+			}
+			if(exact)
+				return lazy.toFraction();
+			auto loadBig=[&](std::size_t i) {return load(BigFraction(),i);};
+			return reduceRange<BigFraction>(n,loadBig,combine,threads).template toFraction<IntT>();
+		}
+	}
+
+	//reduce_sum(first,last) returns the exact sum of the Fractions in [first,last), 0 for an empty range.
+	template<typename IntT>
+	BasicFraction<IntT> reduce_sum(const BasicFraction<IntT>* first,const BasicFraction<IntT>* last,unsigned threads=0)
+	{
+		return detail::reduce<IntT>(static_cast<std::size_t>(last-first),0,
+			[first](auto zero,std::size_t i) {return decltype(zero)(first[i]);},
+			[](const auto& a,const auto& b) {return a+b;},threads);
+	}
+
+	//reduce_product(first,last) returns the exact product of the Fractions in [first,last), 1 for an empty range.
+	template<typename IntT>
+	BasicFraction<IntT> reduce_product(const BasicFraction<IntT>* first,const BasicFraction<IntT>* last,unsigned threads=0)
+	{
+		return detail::reduce<IntT>(static_cast<std::size_t>(last-first),1,
+			[first](auto zero,std::size_t i) {return decltype(zero)(first[i]);},
+			[](const auto& a,const auto& b) {return a*b;},threads);
+	}
+
+	//dot(x,y,n) returns the exact sum of x[i]*y[i] for i in [0,n), 0 for n=0.
+	template<typename IntT>
+	BasicFraction<IntT> dot(const BasicFraction<IntT>* x,const BasicFraction<IntT>* y,std::size_t n,unsigned threads=0)
+	{
+		return detail::reduce<IntT>(n,0,
+			[x,y](auto zero,std::size_t i) {return decltype(zero)(x[i])*decltype(zero)(y[i]);},
+			[](const auto& a,const auto& b) {return a+b;},threads);
+	}
+
+	//The std::vector overloads reduce whole arrays.
+
+	template<typename IntT>
+	BasicFraction<IntT> reduce_sum(const std::vector<BasicFraction<IntT> >& v,unsigned threads=0)
+	{
+		return reduce_sum(v.data(),v.data()+v.size(),threads);
+	}
+
+	template<typename IntT>
+	BasicFraction<IntT> reduce_product(const std::vector<BasicFraction<IntT> >& v,unsigned threads=0)
+	{
+		return reduce_product(v.data(),v.data()+v.size(),threads);
+	}
+
+	//dot(x,y) throws std::invalid_argument if the arrays have different sizes.
+	template<typename IntT>
+	BasicFraction<IntT> dot(const std::vector<BasicFraction<IntT> >& x,const std::vector<BasicFraction<IntT> >& y,unsigned threads=0)
+	{
+		if(x.size()!=y.size())
+		{
+			throw std::invalid_argument("fraction::dot: the arrays have different sizes");
+		}
+		return dot(x.data(),y.data(),x.size(),threads);
+	}
+}
+
+#endif // __FRACTION_REDUCE_H__
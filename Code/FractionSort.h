@@ -0,0 +1,237 @@
+#ifndef __FRACTION_SORT_H__
+#define __FRACTION_SORT_H__
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <limits>
+#include <vector>
+
+#include "Fraction.h"
+#include "FractionReduce.h"
+
+//fraction::sort() sorts arrays of Fractions into the order of operator< with a radix sort.
+//
+//Every element is converted once to a 64 bit key that preserves the order: the bits of the quotient p/q rounded to a double.
+//The numerator and denominator of a Fraction convert exactly to doubles and a correctly rounded quotient never decreases when the value increases,
+//so a<b implies key(a)<=key(b). For Fraction64 the quotient is formed in the 64 bit significand of long double and then rounded to a double,
+//where the order is preserved for the same reason.
+//The records of key and value are sorted by a most significant digit first radix sort on 11 bit digits, starting below the bits that all keys share,
+//and buckets of at most 32 records are finished by insertion sort. Distinct Fractions closer than the precision of a double get the same key,
+//so records with equal keys are ordered with operator<. The result is therefore exactly the order of std::sort with operator<.
+//
+//The keys and the first distribution are computed by chunks of sc_nSortChunk elements on several threads, and the buckets are then sorted as separate tasks.
+//The number of threads defaults to std::thread::hardware_concurrency(). Ranges of a single chunk run on the calling thread.
+//Fraction128, and Fraction64 where long double has no 64 bit significand, are sorted with std::sort.
+//The sources using these functions are linked with FractionReduce.cpp and -pthread.
+namespace fraction
+{
+	//Number of elements handled by one task of the radix sort
+	static const std::size_t sc_nSortChunk=1<<16;
+
+	//Ranges of up to sc_nSortSmall elements are sorted with std::sort, which is faster there than the passes of the radix sort.
+	static const std::size_t sc_nSortSmall=256;
+
+	namespace detail
+	{
+		//hasSortKey<IntT>() is true if the quotient of two terms of BasicFraction<IntT> can be rounded to a double monotonically.
+		template<typename IntT>
+		constexpr bool hasSortKey()
+		{
+			return sizeof(IntT)<=4 || (sizeof(IntT)<=8 && std::numeric_limits<long double>::digits>=64);
+		}
+
+		//sortKey(F) maps the double nearest to F to an unsigned integer of the same order:
+		//the sign bit is flipped for positive values and every bit is flipped for negative ones.
+		//0 is always 0/1, so the key of -0.0 never occurs.
+		template<typename IntT>
+		inline std::uint64_t sortKey(const BasicFraction<IntT>& f)
+		{
+			double x;
+			if constexpr(sizeof(IntT)<=4)
+				x=static_cast<double>(f.numerator())/static_cast<double>(f.denominator());
+			else
+				x=static_cast<double>(static_cast<long double>(f.numerator())/static_cast<long double>(f.denominator()));
+			std::uint64_t u;
+			std::memcpy(&u,&x,sizeof(u));
+			return (u>>63) ? ~u : (u|(static_cast<std::uint64_t>(1)<<63));
+		}
+
+		template<typename IntT>
+		struct SortRecord
+		{
+			std::uint64_t key;
+			BasicFraction<IntT> value;
+		};
+
+		//The records are ordered by key, and by value where the keys are equal.
+		template<typename IntT>
+		inline bool recordLess(const SortRecord<IntT>& x,const SortRecord<IntT>& y)
+		{
+			return x.key<y.key || (x.key==y.key && x.value<y.value);
+		}
+
+		//A pass of the radix sort distributes the records on a digit of up to 11 bits of their keys.
+		static const int sc_nSortDigitBits=11;
+		static const std::size_t sc_nSortBuckets=static_cast<std::size_t>(1)<<sc_nSortDigitBits;
+
+		//Buckets of up to sc_nSortLeaf records are finished by insertion sort.
+		static const std::size_t sc_nSortLeaf=32;
+
+		//digitShift(lo,hi,bits) returns the shift of the first digit of the given width: the digit below the highest bit in which the smallest and the largest key differ.
+		//Keys of values of similar magnitude share their sign and exponent bits, which would otherwise take a pass that changes nothing.
+		inline int digitShift(std::uint64_t lo,std::uint64_t hi,int bits)
+		{
+			int top=64-__builtin_clzll(lo^hi);
+			return top>bits ? top-bits : 0;
+		}
+
+		//msdSort(source,scratch,n,out) sorts n records at source, using the records at scratch, and writes their values in order to out.
+		//The records are distributed on the most significant differing digit and every bucket is sorted the same way, swapping the two arrays.
+		//The digit is narrowed for small buckets so that the count arrays stay small next to the records: about 16 records go to each bucket.
+		template<typename IntT>
+		void msdSort(SortRecord<IntT>* source,SortRecord<IntT>* scratch,std::size_t n,BasicFraction<IntT>* out)
+		{
+			std::uint64_t lo=source[0].key,hi=source[0].key;
+			for(std::size_t i=1;i<n;i++)
+			{
+				lo=std::min(lo,source[i].key);
+				hi=std::max(hi,source[i].key);
+			}
+			if(lo==hi || n<=sc_nSortLeaf)
+			{
+				if(lo==hi)
+				{
+					//The values are all within the rounding error of a double of each other.
+					std::sort(source,source+n,recordLess<IntT>);
+				}
+				else
+				{
+					for(std::size_t i=1;i<n;i++)
+					{
+						SortRecord<IntT> r=source[i];
+						std::size_t j=i;
+						for(;j>0 && recordLess(r,source[j-1]);j--)
+							source[j]=source[j-1];
+						source[j]=r;
+					}
+				}
+				for(std::size_t i=0;i<n;i++)
+					out[i]=source[i].value;
+				return;
+			}
+			int bits=std::min(sc_nSortDigitBits,59-__builtin_clzll(n));
+			std::size_t buckets=static_cast<std::size_t>(1)<<bits;
+			int shift=digitShift(lo,hi,bits);
+			std::size_t start[sc_nSortBuckets+1];
+			std::fill(start,start+buckets+1,0);
+			for(std::size_t i=0;i<n;i++)
+				start[((source[i].key>>shift)&(buckets-1))+1]++;
+			for(std::size_t d=0;d<buckets;d++)
+				start[d+1]+=start[d];
+			std::size_t position[sc_nSortBuckets];
+			std::copy(start,start+buckets,position);
+			for(std::size_t i=0;i<n;i++)
+				scratch[position[(source[i].key>>shift)&(buckets-1)]++]=source[i];
+			for(std::size_t d=0;d<buckets;d++)
+				if(start[d+1]>start[d])
+					msdSort(scratch+start[d],source+start[d],start[d+1]-start[d],out+start[d]);
+		}
+
+		//radixSort(first,n,threads) sorts n>0 elements at first.
+		//The keys and the first distribution are computed by chunks in parallel, then the buckets are sorted as independent tasks.
+		template<typename IntT>
+		void radixSort(BasicFraction<IntT>* first,std::size_t n,unsigned threads)
+		{
+			typedef SortRecord<IntT> Record;
+			std::size_t chunks=(n+sc_nSortChunk-1)/sc_nSortChunk;
+			std::vector<Record> a(n),b(n);
+			std::vector<std::uint64_t> lo(chunks),hi(chunks);
+			parallelFor(chunks,threads,[&](std::size_t c)
+			{
+				std::size_t begin=c*sc_nSortChunk,end=std::min(n,begin+sc_nSortChunk);
+				std::uint64_t l=~static_cast<std::uint64_t>(0),h=0;
+				for(std::size_t i=begin;i<end;i++)
+				{
+					std::uint64_t k=sortKey(first[i]);
+					a[i].key=k;
+					a[i].value=first[i];
+					l=std::min(l,k);
+					h=std::max(h,k);
+				}
+				lo[c]=l;
+				hi[c]=h;
+			});
+			std::uint64_t l=*std::min_element(lo.begin(),lo.end()),h=*std::max_element(hi.begin(),hi.end());
+			if(l==h)
+			{
+				std::sort(first,first+n);
+				return;
+			}
+
+			//count[c*buckets+d] is the number of keys of chunk c with digit d, and then the position of the first of them in b.
+			int shift=digitShift(l,h,sc_nSortDigitBits);
+			std::vector<std::size_t> count(chunks*sc_nSortBuckets,0);
+			parallelFor(chunks,threads,[&](std::size_t c)
+			{
+				std::size_t begin=c*sc_nSortChunk,end=std::min(n,begin+sc_nSortChunk);
+				std::size_t* t=&count[c*sc_nSortBuckets];
+				for(std::size_t i=begin;i<end;i++)
+					t[(a[i].key>>shift)&(sc_nSortBuckets-1)]++;
+			});
+			//The elements of chunk c with digit d go after those of all smaller digits and those of the earlier chunks with digit d.
+			std::vector<std::size_t> start(sc_nSortBuckets+1);
+			std::size_t offset=0;
+			for(std::size_t d=0;d<sc_nSortBuckets;d++)
+			{
+				start[d]=offset;
+				for(std::size_t c=0;c<chunks;c++)
+				{
+					std::size_t k=count[c*sc_nSortBuckets+d];
+					count[c*sc_nSortBuckets+d]=offset;
+					offset+=k;
+				}
+			}
+			start[sc_nSortBuckets]=n;
+			parallelFor(chunks,threads,[&](std::size_t c)
+			{
+				std::size_t begin=c*sc_nSortChunk,end=std::min(n,begin+sc_nSortChunk);
+				std::size_t* position=&count[c*sc_nSortBuckets];
+				for(std::size_t i=begin;i<end;i++)
+					b[position[(a[i].key>>shift)&(sc_nSortBuckets-1)]++]=a[i];
+			});
+			parallelFor(sc_nSortBuckets,threads,[&](std::size_t d)
+			{
+				if(start[d+1]>start[d])
+					msdSort(&b[start[d]],&a[start[d]],start[d+1]-start[d],first+start[d]);
+			});
+		}
+	}
+
+	//sort(first,last) sorts the Fractions in [first,last) in ascending order.
+	//Equal Fractions are identical, so the result is the same as that of std::sort(first,last).
+	template<typename IntT>
+	void sort(BasicFraction<IntT>* first,BasicFraction<IntT>* last,unsigned threads=0)
+	{
+		std::size_t n=static_cast<std::size_t>(last-first);
+		if constexpr(detail::hasSortKey<IntT>())
+		{
+			if(n>sc_nSortSmall)
+			{
+				detail::radixSort(first,n,threads);
+				return;
+			}
+		}
+		std::sort(first,last);
+	}
+
+	//sort(V) sorts a whole array.
+	template<typename IntT>
+	void sort(std::vector<BasicFraction<IntT> >& v,unsigned threads=0)
+	{
+		sort(v.data(),v.data()+v.size(),threads);
+	}
+}
+
+#endif // __FRACTION_SORT_H__
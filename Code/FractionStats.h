@@ -0,0 +1,199 @@
+#ifndef __FRACTION_STATS_H__
+#define __FRACTION_STATS_H__
+
+#include <cstddef>
+#include <cstdint>
+#include <iostream>
+
+//Instrumentation Counters
+//When FRACTION_STATS is defined, e.g. -DFRACTION_STATS, the Fraction operators and the GCD engine count their work in counters of the calling thread:
+//the operations by type, the calls of normalize(), the calls and loop steps of gcd() with a histogram of the steps per call,
+//the bit lengths of the denominators of the results, the results within a factor of two of overflow (near misses) and the overflows.
+//A counter is a plain increment of a thread_local variable, with no atomic operation and no sharing between threads.
+//Nothing is counted during constant evaluation, so the constexpr Fractions stay constexpr.
+//
+//Without FRACTION_STATS the FRACTION_STATS_* macros expand to nothing, the Fraction code is exactly the uninstrumented one,
+//and snapshot() returns zero counters.
+//FRACTION_STATS must be defined the same way in every translation unit of a program, since it changes the inline functions of BasicFraction.h.
+
+namespace FractionStats
+{
+	//Operations counted by type
+	enum Operation
+	{
+		eConstruct,	//Fraction(m,n) and make(m,n)
+		eAdd,
+		eSub,
+		eMul,
+		eDiv,
+		eMod,	//operator%, floorDiv() and divmod()
+		eCompare,	//compare() and the ordering operators
+		eOperationCount
+	};
+
+	//Buckets of the histograms
+	static const std::size_t sc_nStepBuckets=16;	//gcd() calls by steps: 0, 1, 2-3, 4-7, ..., and 2^14 or more
+	static const std::size_t sc_nBitBuckets=129;	//Results by bit length of the denominator, 1 to 128
+
+#ifdef FRACTION_STATS
+	static const bool sc_bEnabled=true;
+#else
+	static const bool sc_bEnabled=false;
+#endif
+
+	//Counters is the set of counters of one thread, or the sum or difference of several snapshots.
+	struct Counters
+	{
+		std::uint64_t operations[eOperationCount];
+		std::uint64_t normalizations;	//Calls of normalize()
+		std::uint64_t gcds;	//Calls of FractionGCD::gcd()
+		std::uint64_t gcdSteps;	//Loop steps of the GCD algorithms: subtractions of binary(), divisions of euclid(), digit rounds of lehmer()
+		std::uint64_t gcdStepHistogram[sc_nStepBuckets];	//gcd() calls by the steps they took
+		std::uint64_t denominatorBits[sc_nBitBuckets];	//Results checked for overflow that fit, by bit length of the denominator
+		std::uint64_t nearMisses;	//Results that fit with a term in the top bit of its type
+		std::uint64_t overflows;	//Results that do not fit
+
+		Counters& operator+=(const Counters&);
+		Counters& operator-=(const Counters&);
+	};
+
+	//local() returns the counters of the calling thread.
+	inline Counters& local()
+	{
+		static thread_local Counters counters={};
+		return counters;
+	}
+
+	//bucket() returns the index of x in a histogram of powers of two: 0 for 0, then the bit length of x, at most last.
+	inline std::size_t bucket(std::uint64_t x,std::size_t last)
+	{
+		std::size_t b=x ? static_cast<std::size_t>(64-__builtin_clzll(x)) : 0;
+		return b<last ? b : last;
+	}
+
+	//The recording functions called by the FRACTION_STATS_* macros.
+
+	inline void count(Operation op) {local().operations[op]++;}
+
+	inline void normalization() {local().normalizations++;}
+
+	//The algorithms of FractionGCD add their loop steps with gcdSteps(). FractionGCD::gcd() reads the step counter with mark() before it runs
+	//and records the call with gcd(), which puts the steps taken since the mark in the histogram.
+	inline void gcdSteps(std::uint64_t steps) {local().gcdSteps+=steps;}
+
+	inline void mark(std::uint64_t& before) {before=local().gcdSteps;}
+
+	inline void gcd(std::uint64_t before)
+	{
+		Counters& c=local();
+		c.gcds++;
+		c.gcdStepHistogram[bucket(c.gcdSteps-before,sc_nStepBuckets-1)]++;
+	}
+
+	//result(den,nearMiss) records a result that fits, with the denominator den. U is a 64 or 128 bit unsigned type.
+	template<typename U>
+	inline void result(U den,bool nearMiss)
+	{
+		std::size_t bits=0;
+		while(den>static_cast<U>(~std::uint64_t(0)))
+		{
+			den=den>>32>>32;
+			bits+=64;
+		}
+		bits+=bucket(static_cast<std::uint64_t>(den),64);
+		Counters& c=local();
+		c.denominatorBits[bits<sc_nBitBuckets ? bits : sc_nBitBuckets-1]++;
+		c.nearMisses+=nearMiss ? 1 : 0;
+	}
+
+	inline void overflow() {local().overflows++;}
+
+
+	//Snapshots
+
+	//snapshot() returns a copy of the counters of the calling thread. The difference of two snapshots is the work done in between.
+	//The snapshots of several threads are summed with +=.
+	inline Counters snapshot() {return local();}
+
+	//reset() sets the counters of the calling thread to zero.
+	inline void reset() {local()=Counters();}
+
+	inline Counters& Counters::operator+=(const Counters& rhs)
+	{
+		for(std::size_t i=0;i<eOperationCount;i++)
+			operations[i]+=rhs.operations[i];
+		normalizations+=rhs.normalizations;
+		gcds+=rhs.gcds;
+		gcdSteps+=rhs.gcdSteps;
+		for(std::size_t i=0;i<sc_nStepBuckets;i++)
+			gcdStepHistogram[i]+=rhs.gcdStepHistogram[i];
+		for(std::size_t i=0;i<sc_nBitBuckets;i++)
+			denominatorBits[i]+=rhs.denominatorBits[i];
+		nearMisses+=rhs.nearMisses;
+		overflows+=rhs.overflows;
+		return *this;
+	}
+
+	inline Counters& Counters::operator-=(const Counters& rhs)
+	{
+		for(std::size_t i=0;i<eOperationCount;i++)
+			operations[i]-=rhs.operations[i];
+		normalizations-=rhs.normalizations;
+		gcds-=rhs.gcds;
+		gcdSteps-=rhs.gcdSteps;
+		for(std::size_t i=0;i<sc_nStepBuckets;i++)
+			gcdStepHistogram[i]-=rhs.gcdStepHistogram[i];
+		for(std::size_t i=0;i<sc_nBitBuckets;i++)
+			denominatorBits[i]-=rhs.denominatorBits[i];
+		nearMisses-=rhs.nearMisses;
+		overflows-=rhs.overflows;
+		return *this;
+	}
+
+	inline Counters operator-(Counters lhs,const Counters& rhs) {return lhs-=rhs;}
+	inline Counters operator+(Counters lhs,const Counters& rhs) {return lhs+=rhs;}
+
+	//dump() writes the counters in a readable form, one group per line; the histograms list their non zero buckets only.
+	inline void dump(std::ostream& OUT,const Counters& c)
+	{
+		static const char* const names[eOperationCount]={"construct","add","sub","mul","div","mod","compare"};
+		OUT << "operations:";
+		for(std::size_t i=0;i<eOperationCount;i++)
+			OUT << " " << names[i] << " " << c.operations[i];
+		OUT << "\nnormalize: " << c.normalizations << ", gcd: " << c.gcds << " calls, " << c.gcdSteps << " steps";
+		if(c.gcds)
+			OUT << ", " << static_cast<double>(c.gcdSteps)/static_cast<double>(c.gcds) << " per call";
+		OUT << "\ngcd steps per call:";
+		for(std::size_t i=0;i<sc_nStepBuckets;i++)
+			if(c.gcdStepHistogram[i])
+			{
+				std::uint64_t lo=i ? std::uint64_t(1)<<(i-1) : 0;
+				OUT << " [" << lo;
+				if(i+1==sc_nStepBuckets)
+					OUT << "+";
+				else if(i>1)
+					OUT << "-" << (std::uint64_t(1)<<i)-1;
+				OUT << "] " << c.gcdStepHistogram[i];
+			}
+		OUT << "\ndenominator bits:";
+		for(std::size_t i=0;i<sc_nBitBuckets;i++)
+			if(c.denominatorBits[i])
+				OUT << " [" << i << "] " << c.denominatorBits[i];
+		OUT << "\nnear misses: " << c.nearMisses << ", overflows: " << c.overflows << "\n";
+	}
+}
+
+//Instrumentation Macros
+//They are used in the constexpr code of BasicFraction.h and FractionGCD.h and skip the counting during constant evaluation.
+#ifdef FRACTION_STATS
+#define FRACTION_STATS_RECORD(call) do { if(!__builtin_is_constant_evaluated()) FractionStats::call; } while(0)
+#define FRACTION_STATS_STEPS(name) std::uint64_t name=0
+#define FRACTION_STATS_STEP(name) (++name)
+#else
+//The Fraction code is unchanged: FRACTION_STATS_STEPS(name) declares nothing and the other macros are empty statements.
+#define FRACTION_STATS_RECORD(call) do {} while(0)
+#define FRACTION_STATS_STEPS(name) static_assert(true,"")
+#define FRACTION_STATS_STEP(name) ((void)0)
+#endif
+
+#endif // __FRACTION_STATS_H__
@@ -0,0 +1,379 @@
+#include "FractionVector.h"
+#include <stdexcept>
+
+#if defined(__AVX2__) && !defined(FRACTION_VECTOR_SCALAR)
+#define FRACTION_VECTOR_AVX2
+#include <immintrin.h>
+#endif
+
+namespace
+{
+#ifdef FRACTION_VECTOR_AVX2
+	//AVX2 Building Blocks
+	//Eight 32 bit lanes per register. Masks are lanes of all ones or all zeros.
+
+	typedef __m256i Lanes;
+
+	inline Lanes splat(std::uint32_t x) {return _mm256_set1_epi32(static_cast<int>(x));}
+
+	inline Lanes equal(Lanes x,Lanes y) {return _mm256_cmpeq_epi32(x,y);}
+
+	inline Lanes select(Lanes mask,Lanes ifTrue,Lanes ifFalse) {return _mm256_blendv_epi8(ifFalse,ifTrue,mask);}
+
+	//lessEqualUnsigned() is the mask of the lanes with x<=y as unsigned integers.
+	inline Lanes lessEqualUnsigned(Lanes x,Lanes y) {return equal(_mm256_max_epu32(x,y),y);}
+
+	//greaterUnsigned() is the mask of the lanes with x>y as unsigned integers.
+	inline Lanes greaterUnsigned(Lanes x,Lanes y)
+	{
+		Lanes bias=splat(0x80000000u);
+		return _mm256_cmpgt_epi32(_mm256_xor_si256(x,bias),_mm256_xor_si256(y,bias));
+	}
+
+	//negateIf() negates the lanes selected by mask.
+	inline Lanes negateIf(Lanes x,Lanes mask) {return _mm256_sub_epi32(_mm256_xor_si256(x,mask),mask);}
+
+	//countTrailingZeros() of non zero lanes.
+	//The lowest set bit x&-x is converted to float, whose exponent field is its position.
+	inline Lanes countTrailingZeros(Lanes x)
+	{
+		Lanes low=_mm256_and_si256(x,_mm256_sub_epi32(_mm256_setzero_si256(),x));
+		Lanes bits=_mm256_castps_si256(_mm256_cvtepi32_ps(low));
+		Lanes exponent=_mm256_and_si256(_mm256_srli_epi32(bits,23),splat(0xFF));
+		return _mm256_sub_epi32(exponent,splat(127));
+	}
+
+	//gcd() is the binary GCD of FractionGCD::binary() run on eight lanes at once.
+	//Lanes that have converged keep their value while the others finish.
+	inline Lanes gcd(Lanes u,Lanes v)
+	{
+		Lanes zero=_mm256_setzero_si256(),one=splat(1);
+		Lanes uZero=equal(u,zero),vZero=equal(v,zero);
+		Lanes a=select(uZero,one,u),b=select(vZero,one,v);
+		Lanes shift=countTrailingZeros(_mm256_or_si256(a,b));
+		a=_mm256_srlv_epi32(a,countTrailingZeros(a));
+		b=_mm256_srlv_epi32(b,countTrailingZeros(b));
+		for(;;)
+		{
+			Lanes same=equal(a,b);
+			if(_mm256_movemask_epi8(same)==-1)
+				break;
+			Lanes zeros=countTrailingZeros(select(same,one,_mm256_sub_epi32(a,b)));
+			Lanes low=_mm256_min_epu32(a,b);
+			Lanes high=_mm256_max_epu32(a,b);
+			a=low;
+			b=select(same,low,_mm256_srlv_epi32(_mm256_sub_epi32(high,low),zeros));
+		}
+		Lanes g=_mm256_sllv_epi32(a,shift);
+		g=select(uZero,v,g);
+		return select(vZero,u,g);
+	}
+
+	//divideExact() divides lanes n by divisors d that divide them exactly.
+	//After removing the common trailing zeros, n/d is n times the inverse of the odd d modulo 2^32, which Newton's iteration x=x*(2-d*x) finds in four steps.
+	inline Lanes divideExact(Lanes n,Lanes d)
+	{
+		d=select(equal(d,_mm256_setzero_si256()),splat(1),d);
+		Lanes k=countTrailingZeros(d);
+		d=_mm256_srlv_epi32(d,k);
+		n=_mm256_srlv_epi32(n,k);
+		Lanes two=splat(2),inverse=d;
+		for(int i=0;i<4;i++)
+			inverse=_mm256_mullo_epi32(inverse,_mm256_sub_epi32(two,_mm256_mullo_epi32(d,inverse)));
+		return _mm256_mullo_epi32(n,inverse);
+	}
+
+	//multiplyWide() forms the 64 bit products of unsigned lanes and returns their low and high 32 bit halves.
+	inline void multiplyWide(Lanes x,Lanes y,Lanes& low,Lanes& high)
+	{
+		Lanes even=_mm256_mul_epu32(x,y);
+		Lanes odd=_mm256_mul_epu32(_mm256_srli_epi64(x,32),_mm256_srli_epi64(y,32));
+		low=_mm256_blend_epi32(even,_mm256_slli_epi64(odd,32),0xAA);
+		high=_mm256_blend_epi32(_mm256_srli_epi64(even,32),odd,0xAA);
+	}
+
+	//numeratorLimit() is the largest magnitude of a numerator of the given sign: 2^31-1, or 2^31 for negative lanes.
+	inline Lanes numeratorLimit(Lanes negative) {return _mm256_sub_epi32(splat(0x7FFFFFFFu),negative);}
+
+	//The block kernels compute eight results and return the mask of the lanes that must be recomputed by the scalar checked operators.
+
+	//Multiplication: the numerator of each operand is cancelled against the denominator of the other, as in Fraction.
+	//Division is the same product with the roles of the second numerator and denominator exchanged.
+	Lanes productBlock(Lanes a,Lanes b,Lanes c,Lanes d,bool divide,Lanes& p,Lanes& q)
+	{
+		Lanes zero=_mm256_setzero_si256();
+		Lanes A=_mm256_abs_epi32(a),C=_mm256_abs_epi32(c);
+		Lanes negative=_mm256_srai_epi32(_mm256_xor_si256(a,c),31);
+		Lanes num1=A,num2=divide ? d : C;
+		Lanes den1=b,den2=divide ? C : d;
+		//num1 cancels against den2 and num2 against den1.
+		Lanes g1=gcd(num1,den2),g2=gcd(num2,den1);
+		Lanes numLow,numHigh,denLow,denHigh;
+		multiplyWide(divideExact(num1,g1),divideExact(num2,g2),numLow,numHigh);
+		multiplyWide(divideExact(den1,g2),divideExact(den2,g1),denLow,denHigh);
+		Lanes ok=_mm256_and_si256(_mm256_and_si256(equal(numHigh,zero),equal(denHigh,zero)),lessEqualUnsigned(numLow,numeratorLimit(negative)));
+		Lanes aZero=equal(a,zero),cZero=equal(c,zero);
+		Lanes resultZero=divide ? _mm256_andnot_si256(cZero,aZero) : _mm256_or_si256(aZero,cZero);
+		p=select(resultZero,zero,negateIf(numLow,negative));
+		q=select(resultZero,splat(1),denLow);
+		ok=_mm256_or_si256(ok,resultZero);
+		if(divide)
+			ok=_mm256_andnot_si256(cZero,ok);
+		return _mm256_andnot_si256(ok,splat(0xFFFFFFFFu));
+	}
+
+	//Addition: with g=gcd(b,d), t=a*(d/g)+c*(b/g) is formed as a signed magnitude, and only gcd(t,g) is cancelled, as in Fraction.
+	//Lanes whose terms or sum leave 32 bits fall back to the scalar operator.
+	Lanes sumBlock(Lanes a,Lanes b,Lanes c,Lanes d,bool subtract,Lanes& p,Lanes& q)
+	{
+		Lanes zero=_mm256_setzero_si256(),ones=splat(0xFFFFFFFFu);
+		Lanes g=gcd(b,d);
+		Lanes b1=divideExact(b,g),d1=divideExact(d,g);
+		Lanes x,xHigh,y,yHigh;
+		multiplyWide(_mm256_abs_epi32(a),d1,x,xHigh);
+		multiplyWide(_mm256_abs_epi32(c),b1,y,yHigh);
+		Lanes xSign=_mm256_srai_epi32(a,31);
+		Lanes ySign=_mm256_srai_epi32(c,31);
+		if(subtract)
+			ySign=_mm256_xor_si256(ySign,ones);
+		Lanes same=equal(xSign,ySign);
+		Lanes sum=_mm256_add_epi32(x,y);
+		Lanes carry=_mm256_andnot_si256(lessEqualUnsigned(x,sum),same);
+		Lanes xLarger=lessEqualUnsigned(y,x);
+		Lanes difference=select(xLarger,_mm256_sub_epi32(x,y),_mm256_sub_epi32(y,x));
+		Lanes t=select(same,sum,difference);
+		Lanes negative=select(same,xSign,select(xLarger,xSign,ySign));
+		Lanes tZero=equal(t,zero);
+		Lanes g2=gcd(t,g);
+		Lanes num=divideExact(t,g2);
+		Lanes den,denHigh;
+		multiplyWide(b1,divideExact(d,g2),den,denHigh);
+		Lanes termsFit=_mm256_and_si256(equal(xHigh,zero),equal(yHigh,zero));
+		Lanes resultFits=_mm256_and_si256(_mm256_andnot_si256(carry,equal(denHigh,zero)),lessEqualUnsigned(num,numeratorLimit(negative)));
+		Lanes ok=_mm256_and_si256(termsFit,_mm256_or_si256(tZero,resultFits));
+		p=select(tZero,zero,negateIf(num,negative));
+		q=select(tZero,splat(1),den);
+		return _mm256_andnot_si256(ok,ones);
+	}
+
+	//Three-way comparison: the signs decide unless they are equal, then |a|*d and |c|*b are compared as 64 bit unsigned products.
+	Lanes compareBlock(Lanes a,Lanes b,Lanes c,Lanes d)
+	{
+		Lanes zero=_mm256_setzero_si256(),one=splat(1);
+		Lanes aSign=_mm256_sub_epi32(_mm256_and_si256(_mm256_cmpgt_epi32(a,zero),one),_mm256_and_si256(_mm256_cmpgt_epi32(zero,a),one));
+		Lanes cSign=_mm256_sub_epi32(_mm256_and_si256(_mm256_cmpgt_epi32(c,zero),one),_mm256_and_si256(_mm256_cmpgt_epi32(zero,c),one));
+		Lanes bySign=_mm256_sub_epi32(_mm256_and_si256(_mm256_cmpgt_epi32(aSign,cSign),one),_mm256_and_si256(_mm256_cmpgt_epi32(cSign,aSign),one));
+		Lanes lLow,lHigh,rLow,rHigh;
+		multiplyWide(_mm256_abs_epi32(a),d,lLow,lHigh);
+		multiplyWide(_mm256_abs_epi32(c),b,rLow,rHigh);
+		Lanes highEqual=equal(lHigh,rHigh);
+		Lanes greater=select(highEqual,greaterUnsigned(lLow,rLow),greaterUnsigned(lHigh,rHigh));
+		Lanes less=select(highEqual,greaterUnsigned(rLow,lLow),greaterUnsigned(rHigh,lHigh));
+		Lanes byMagnitude=_mm256_sub_epi32(_mm256_and_si256(greater,one),_mm256_and_si256(less,one));
+		byMagnitude=negateIf(byMagnitude,_mm256_cmpgt_epi32(zero,aSign));
+		return select(equal(aSign,cSign),byMagnitude,bySign);
+	}
+
+	inline Lanes load(const void* p) {return _mm256_load_si256(static_cast<const Lanes*>(p));}
+#endif
+}
+
+//Element Access
+
+Fraction FractionVector::element(Numerator m,Denominator n)
+{
+	return Fraction(m,n,Fraction::Reduced());
+}
+
+void FractionVector::checkSizes(const FractionVector& x,const FractionVector& y)
+{
+	if(x.size()!=y.size())
+	{
+		throw std::invalid_argument("FractionVector: the operands have different sizes");
+	}
+}
+
+//Constructors
+
+FractionVector::FractionVector(std::size_t n,const Fraction& value)
+: p(n,value.numerator()),q(n,value.denominator())
+{
+}
+
+FractionVector::FractionVector(const std::vector<Fraction>& v)
+: p(v.size()),q(v.size())
+{
+	for(std::size_t i=0;i<v.size();i++)
+	{
+		p[i]=v[i].numerator();
+		q[i]=v[i].denominator();
+	}
+}
+
+std::vector<Fraction> FractionVector::toVector() const
+{
+	std::vector<Fraction> v;
+	v.reserve(size());
+	for(std::size_t i=0;i<size();i++)
+		v.push_back(element(p[i],q[i]));
+	return v;
+}
+
+//Container Operations
+
+void FractionVector::resize(std::size_t n,const Fraction& value)
+{
+	p.resize(n,value.numerator());
+	q.resize(n,value.denominator());
+}
+
+void FractionVector::push_back(const Fraction& f)
+{
+	p.push_back(f.numerator());
+	q.push_back(f.denominator());
+}
+
+Fraction FractionVector::get(std::size_t i) const
+{
+	return element(p[i],q[i]);
+}
+
+void FractionVector::set(std::size_t i,const Fraction& f)
+{
+	p[i]=f.numerator();
+	q[i]=f.denominator();
+}
+
+//Batch Kernels
+
+//apply() computes one element with the checked operators.
+CheckedFraction FractionVector::apply(Operation operation,const FractionVector& x,const Numerator* yp,const Denominator* yq,std::size_t yStride,std::size_t i)
+{
+	Fraction a=element(x.p[i],x.q[i]);
+	Fraction b=element(yp[i*yStride],yq[i*yStride]);
+	switch(operation)
+	{
+	case eOperationAdd:
+		return checkedAdd(a,b);
+	case eOperationSub:
+		return checkedSub(a,b);
+	case eOperationMul:
+		return checkedMul(a,b);
+	default:
+		return checkedDiv(a,b);
+	}
+}
+
+//run() applies an arithmetic operation to every element.
+//Blocks of eight go through the AVX2 block kernels, and the lanes they reject as well as the tail through apply().
+//The rejected lanes are computed before the block is stored, because out may be one of the operands.
+FractionStatus FractionVector::run(Operation operation,const FractionVector& x,const Numerator* yp,const Denominator* yq,std::size_t yStride,FractionVector& out)
+{
+	std::size_t n=x.size();
+	out.resize(n);
+	FractionStatus status=eFractionOk;
+	std::size_t i=0;
+#ifdef FRACTION_VECTOR_AVX2
+	for(;i+8<=n;i+=8)
+	{
+		Lanes a=load(x.p.data()+i),b=load(x.q.data()+i);
+		Lanes c=yStride ? load(yp+i) : splat(static_cast<std::uint32_t>(yp[0]));
+		Lanes d=yStride ? load(yq+i) : splat(yq[0]);
+		Lanes m,k,rejected;
+		if(operation==eOperationMul || operation==eOperationDiv)
+			rejected=productBlock(a,b,c,d,operation==eOperationDiv,m,k);
+		else
+			rejected=sumBlock(a,b,c,d,operation==eOperationSub,m,k);
+		int mask=_mm256_movemask_ps(_mm256_castsi256_ps(rejected));
+		CheckedFraction r[8];
+		for(int lane=0;lane<8;lane++)
+			if(mask&(1<<lane))
+				r[lane]=apply(operation,x,yp,yq,yStride,i+lane);
+		_mm256_store_si256(reinterpret_cast<Lanes*>(out.p.data()+i),m);
+		_mm256_store_si256(reinterpret_cast<Lanes*>(out.q.data()+i),k);
+		for(int lane=0;lane<8;lane++)
+			if(mask&(1<<lane))
+			{
+				out.p[i+lane]=r[lane].value.numerator();
+				out.q[i+lane]=r[lane].value.denominator();
+				if(status==eFractionOk)
+					status=r[lane].status;
+			}
+	}
+#endif
+	for(;i<n;i++)
+	{
+		CheckedFraction r=apply(operation,x,yp,yq,yStride,i);
+		out.p[i]=r.value.numerator();
+		out.q[i]=r.value.denominator();
+		if(status==eFractionOk)
+			status=r.status;
+	}
+	return status;
+}
+
+FractionStatus FractionVector::add(const FractionVector& x,const FractionVector& y,FractionVector& out)
+{
+	checkSizes(x,y);
+	return run(eOperationAdd,x,y.p.data(),y.q.data(),1,out);
+}
+
+FractionStatus FractionVector::sub(const FractionVector& x,const FractionVector& y,FractionVector& out)
+{
+	checkSizes(x,y);
+	return run(eOperationSub,x,y.p.data(),y.q.data(),1,out);
+}
+
+FractionStatus FractionVector::mul(const FractionVector& x,const FractionVector& y,FractionVector& out)
+{
+	checkSizes(x,y);
+	return run(eOperationMul,x,y.p.data(),y.q.data(),1,out);
+}
+
+FractionStatus FractionVector::div(const FractionVector& x,const FractionVector& y,FractionVector& out)
+{
+	checkSizes(x,y);
+	return run(eOperationDiv,x,y.p.data(),y.q.data(),1,out);
+}
+
+FractionStatus FractionVector::scale(const FractionVector& x,const Fraction& f,FractionVector& out)
+{
+	Numerator m=f.numerator();
+	Denominator n=f.denominator();
+	return run(eOperationMul,x,&m,&n,0,out);
+}
+
+//compareAll() writes the three-way comparison of every pair of elements to out.
+void FractionVector::compareAll(const FractionVector& x,const FractionVector& y,std::int8_t* out)
+{
+	checkSizes(x,y);
+	std::size_t n=x.size(),i=0;
+#ifdef FRACTION_VECTOR_AVX2
+	for(;i+8<=n;i+=8)
+	{
+		alignas(32) std::int32_t r[8];
+		_mm256_store_si256(reinterpret_cast<Lanes*>(r),compareBlock(load(x.p.data()+i),load(x.q.data()+i),load(y.p.data()+i),load(y.q.data()+i)));
+		for(int k=0;k<8;k++)
+			out[i+k]=static_cast<std::int8_t>(r[k]);
+	}
+#endif
+	for(;i<n;i++)
+	{
+		Fraction a=element(x.p[i],x.q[i]),b=element(y.p[i],y.q[i]);
+		out[i]=static_cast<std::int8_t>((a>b)-(a<b));
+	}
+}
+
+void FractionVector::less(const FractionVector& x,const FractionVector& y,std::vector<std::uint8_t>& mask)
+{
+	mask.resize(x.size());
+	compareAll(x,y,reinterpret_cast<std::int8_t*>(mask.data()));
+	for(std::size_t i=0;i<mask.size();i++)
+		mask[i]=(static_cast<std::int8_t>(mask[i])<0);
+}
+
+void FractionVector::compare(const FractionVector& x,const FractionVector& y,std::vector<std::int8_t>& out)
+{
+	out.resize(x.size());
+	compareAll(x,y,out.data());
+}
@@ -0,0 +1,160 @@
+#ifndef __FRACTION_VECTOR_H__
+#define __FRACTION_VECTOR_H__
+
+#include <cstddef>
+#include <cstdint>
+#include <new>
+#include <vector>
+
+#include "Fraction.h"
+
+//AlignedAllocator is a std::allocator replacement whose blocks are aligned to Alignment bytes.
+//It lets the batch kernels of FractionVector use aligned vector loads on whole cache lines.
+template<typename T,std::size_t Alignment>
+struct AlignedAllocator
+{
+	typedef T value_type;
+
+	template<typename U>
+	struct rebind
+	{
+		typedef AlignedAllocator<U,Alignment> other;
+	};
+
+	AlignedAllocator() {}
+
+	template<typename U>
+	AlignedAllocator(const AlignedAllocator<U,Alignment>&) {}
+
+	T* allocate(std::size_t n)
+	{
+		return static_cast<T*>(::operator new(n*sizeof(T),std::align_val_t(Alignment)));
+	}
+
+	void deallocate(T* p,std::size_t)
+	{
+		::operator delete(p,std::align_val_t(Alignment));
+	}
+
+	template<typename U>
+	bool operator==(const AlignedAllocator<U,Alignment>&) const {return true;}
+
+	template<typename U>
+	bool operator!=(const AlignedAllocator<U,Alignment>&) const {return false;}
+};
+
+//FractionVector is a structure of arrays of Fractions.
+//The numerators and the denominators are stored in two separate 64 byte aligned arrays, so that a batch kernel loads eight numerators or eight denominators with one AVX2 instruction.
+//Every element is a normalized Fraction, exactly as it would be stored in a Fraction object.
+//
+//The batch kernels compute elementwise results that are bit-identical to the checked operators of Fraction.
+//With AVX2 (compile with -mavx2 or -march=native) they run eight elements at a time with a vectorized binary GCD and exact divisions by modular inverses.
+//Elements whose intermediate products leave 32 bits are recomputed by the scalar checked operators, so the results never differ.
+//Without AVX2, or when FRACTION_VECTOR_SCALAR is defined, the kernels are plain loops over the checked operators.
+class FractionVector
+{
+public:
+	typedef std::int32_t Numerator;
+	typedef std::uint32_t Denominator;
+	typedef std::vector<Numerator,AlignedAllocator<Numerator,64> > Numerators;
+	typedef std::vector<Denominator,AlignedAllocator<Denominator,64> > Denominators;
+
+private:
+	//The data members have been made private for information hiding.
+	//p[i]/q[i] is the element i.
+
+	Numerators p;	//Numerators
+	Denominators q;	//Denominators
+
+	//element() returns the Fraction stored as the normalized pair (m,n) without computing a gcd.
+	static Fraction element(Numerator m,Denominator n);
+
+	//checkSizes() throws std::invalid_argument unless the operands of an elementwise kernel have the same size.
+	static void checkSizes(const FractionVector&,const FractionVector&);
+
+	enum Operation
+	{
+		eOperationAdd,
+		eOperationSub,
+		eOperationMul,
+		eOperationDiv
+	};
+
+	//run() is the common implementation of the arithmetic kernels.
+	//The second operand is given as raw arrays with a stride of 1, or of 0 for a single Fraction broadcast to every element.
+	static FractionStatus run(Operation,const FractionVector&,const Numerator*,const Denominator*,std::size_t,FractionVector&);
+
+	//apply() computes the element i of run() with the scalar checked operators.
+	static CheckedFraction apply(Operation,const FractionVector&,const Numerator*,const Denominator*,std::size_t,std::size_t);
+
+	//compareAll() is the common implementation of less() and compare().
+	static void compareAll(const FractionVector&,const FractionVector&,std::int8_t*);
+
+	//FractionFile builds elements and whole arrays from the normalized pairs stored in a file.
+	friend class FractionFile;
+
+public:
+
+	//Constructors
+
+	//This Constructor creates n copies of a Fraction, like the std::vector Constructor.
+	explicit FractionVector(std::size_t n=0,const Fraction& value=Fraction::sc_fZero);
+
+	//This Constructor copies an array of Fractions into the structure of arrays.
+	explicit FractionVector(const std::vector<Fraction>&);
+
+	//toVector() copies the elements back to an array of Fractions.
+	std::vector<Fraction> toVector() const;
+
+
+	//Container Operations
+
+	std::size_t size() const {return p.size();}
+	bool empty() const {return p.empty();}
+	void reserve(std::size_t n) {p.reserve(n); q.reserve(n);}
+	void resize(std::size_t n,const Fraction& value=Fraction::sc_fZero);
+	void clear() {p.clear(); q.clear();}
+	void push_back(const Fraction&);
+
+	//get(i) returns the element i as a Fraction and set(i,F) stores a Fraction at element i.
+	Fraction get(std::size_t i) const;
+	void set(std::size_t i,const Fraction&);
+
+	//F=V[i] <------> V.get(i)
+	Fraction operator[](std::size_t i) const {return get(i);}
+
+	//numerators() and denominators() give direct read access to the two arrays.
+	const Numerator* numerators() const {return p.data();}
+	const Denominator* denominators() const {return q.data();}
+
+
+	//Batch Kernels
+	//Each kernel writes its results to out, which is resized to the size of the operands and may be one of them.
+	//The returned status is eFractionOk if every element was computed exactly.
+	//Otherwise it is the status of the first failing element, and every failing element holds 0/1 like the value of a failed checked operation.
+	//The elementwise kernels throw std::invalid_argument if the sizes of the operands differ.
+
+	//add(X,Y,out) <------> out[i]=checkedAdd(X[i],Y[i])
+	static FractionStatus add(const FractionVector&,const FractionVector&,FractionVector&);
+
+	//sub(X,Y,out) <------> out[i]=checkedSub(X[i],Y[i])
+	static FractionStatus sub(const FractionVector&,const FractionVector&,FractionVector&);
+
+	//mul(X,Y,out) <------> out[i]=checkedMul(X[i],Y[i])
+	static FractionStatus mul(const FractionVector&,const FractionVector&,FractionVector&);
+
+	//div(X,Y,out) <------> out[i]=checkedDiv(X[i],Y[i])
+	static FractionStatus div(const FractionVector&,const FractionVector&,FractionVector&);
+
+	//scale(X,F,out) <------> out[i]=checkedMul(X[i],F)
+	static FractionStatus scale(const FractionVector&,const Fraction&,FractionVector&);
+
+	//less(X,Y,mask) <------> mask[i]=(X[i]<Y[i])
+	//The mask holds one byte per element, 1 for true and 0 for false.
+	static void less(const FractionVector&,const FractionVector&,std::vector<std::uint8_t>&);
+
+	//compare(X,Y,out) <------> out[i]=compare(X[i],Y[i]) with the results -1, 0 or 1.
+	static void compare(const FractionVector&,const FractionVector&,std::vector<std::int8_t>&);
+};
+
+#endif // __FRACTION_VECTOR_H__
@@ -0,0 +1,262 @@
+#ifndef __LAZY_FRACTION_H__
+#define __LAZY_FRACTION_H__
+
+#include <cstdint>
+#include <iostream>
+#include <stdexcept>
+
+#include "Fraction.h"
+
+//BasicLazyFraction is the opt-in unnormalized companion of BasicFraction<IntT> for accumulation heavy code.
+//Its numerator and denominator are kept in the 128 bit intermediate type and the arithmetic operators do not cancel common factors:
+//a*b, a+b, a-b and a/b are plain cross products as long as they fit.
+//Only when a product would overflow are the operands reduced and the operation retried with cross-cancellation,
+//so a chain such as a*b+c*d-e on small operands computes a single gcd, in toFraction(), instead of one per operator.
+//The comparison operators need no reduction at all: they compare the continued fraction expansions of the two values (FractionGCD::compareRatios).
+//
+//An operation whose result cannot be formed in the 128 bit intermediates, even from reduced operands, throws std::overflow_error, and toFraction() throws it if the result does not fit in BasicFraction<IntT>.
+//Division by zero throws std::runtime_error like the operators of BasicFraction.
+//
+//LazyFraction a(x);
+//Fraction r=(a*y+LazyFraction(z)*w-v).toFraction();
+template<typename IntT>
+class BasicLazyFraction
+{
+public:
+	//Wide is the type of the numerator and of the denominator: the intermediate type of the next wider BasicFraction.
+	typedef typename FractionWidth<2*sizeof(IntT)>::Wide Wide;
+	typedef typename FractionWidth<2*sizeof(IntT)>::UWide UWide;
+	static_assert(sizeof(Wide)>sizeof(IntT),"BasicLazyFraction needs an intermediate type wider than the denominator");
+
+private:
+	//The data members have been made private for information hiding.
+	//n/d is the value in any terms, with d>0.
+
+	Wide n;	//Numerator
+	Wide d;	//Denominator
+
+	constexpr BasicLazyFraction(Wide m,Wide k,bool) : n(m),d(k) {}
+
+	//Utility Functions
+
+	static constexpr UWide magnitude(Wide x) {return x<0 ? static_cast<UWide>(0-static_cast<UWide>(x)) : static_cast<UWide>(x);}
+
+	//gcd(Wide,Wide) returns the gcd of the magnitudes of two values, not both zero.
+	//Terms that have stayed below 2^64 take the single register GCD of Fraction64.
+	static constexpr Wide gcd(Wide a,Wide b)
+	{
+		UWide x=magnitude(a),y=magnitude(b);
+		if(((x|y)>>63>>1)==0)
+			return static_cast<Wide>(FractionGCD::gcd<std::uint64_t>(static_cast<std::uint64_t>(x),static_cast<std::uint64_t>(y)));
+		return static_cast<Wide>(FractionGCD::gcd<UWide>(x,y));
+	}
+
+	//fail() throws the exception of an intermediate whose lowest terms leave Wide.
+	static void fail()
+	{
+		throw std::overflow_error("Math error: LazyFraction intermediate overflow\n");
+	}
+
+	//reduced() returns the value in lowest terms.
+	constexpr BasicLazyFraction reduced() const
+	{
+		if(this->n==0)
+			return BasicLazyFraction(0,1,true);
+		Wide g=gcd(this->n,this->d);
+		return BasicLazyFraction(this->n/g,this->d/g,true);
+	}
+
+	//product(a,b,c,d) returns a*b/(c*d) with c,d>0, where a/c and b/d are the operands.
+	//The plain products are tried first. If one overflows, each operand is reduced and cancelled against the other as in Fraction,
+	//which leaves the result in lowest terms, so an overflow of the retry is an overflow of the value itself.
+	static constexpr BasicLazyFraction product(Wide a,Wide b,Wide c,Wide d)
+	{
+		Wide m=0,k=0;
+		if(!__builtin_mul_overflow(a,b,&m) && !__builtin_mul_overflow(c,d,&k))
+			return BasicLazyFraction(m,k,true);
+		if(a==0 || b==0)
+			return BasicLazyFraction(0,1,true);
+		Wide g=gcd(a,c);
+		a/=g;
+		c/=g;
+		g=gcd(b,d);
+		b/=g;
+		d/=g;
+		Wide g1=gcd(a,d),g2=gcd(b,c);
+		if(__builtin_mul_overflow(a/g1,b/g2,&m) || __builtin_mul_overflow(c/g2,d/g1,&k))
+			fail();
+		return BasicLazyFraction(m,k,true);
+	}
+
+	//sum(lhs,rhs) returns lhs+rhs.
+	//Equal denominators add the numerators. Otherwise the cross products are tried first, and if they overflow the sum of the reduced operands is formed as in Fraction (Knuth, TAOCP 4.5.1).
+	static constexpr BasicLazyFraction sum(const BasicLazyFraction& lhs,const BasicLazyFraction& rhs)
+	{
+		Wide x=0,y=0,t=0,k=0;
+		if(lhs.d==rhs.d && !__builtin_add_overflow(lhs.n,rhs.n,&t))
+			return BasicLazyFraction(t,lhs.d,true);
+		if(!__builtin_mul_overflow(lhs.n,rhs.d,&x) && !__builtin_mul_overflow(rhs.n,lhs.d,&y) && !__builtin_add_overflow(x,y,&t) && !__builtin_mul_overflow(lhs.d,rhs.d,&k))
+			return BasicLazyFraction(t,k,true);
+		BasicLazyFraction a=lhs.reduced(),c=rhs.reduced();
+		Wide g=gcd(a.d,c.d);
+		if(__builtin_mul_overflow(a.n,c.d/g,&x) || __builtin_mul_overflow(c.n,a.d/g,&y) || __builtin_add_overflow(x,y,&t))
+			fail();
+		Wide g2=(t==0) ? g : gcd(t,g);
+		if(__builtin_mul_overflow(a.d/g,c.d/g2,&k))
+			fail();
+		return BasicLazyFraction(t/g2,k,true);
+	}
+
+	//negated() returns -n/d. Only the most negative numerator can overflow.
+	constexpr BasicLazyFraction negated() const
+	{
+		Wide m=0;
+		if(__builtin_sub_overflow(static_cast<Wide>(0),this->n,&m))
+		{
+			BasicLazyFraction r=this->reduced();
+			if(__builtin_sub_overflow(static_cast<Wide>(0),r.n,&m))
+				fail();
+			return BasicLazyFraction(m,r.d,true);
+		}
+		return BasicLazyFraction(m,this->d,true);
+	}
+
+public:
+
+	//Constructors
+
+	//This Constructor converts an integer. The default value is zero, the start of an accumulation.
+	constexpr BasicLazyFraction(IntT m=0) : n(m),d(1) {}
+
+	//This Constructor converts a Fraction. It is implicit, so that Fractions mix freely with LazyFractions in expressions.
+	constexpr BasicLazyFraction(const BasicFraction<IntT>& f) : n(f.numerator()),d(static_cast<Wide>(f.denominator())) {}
+
+
+	//Accessors
+
+	//numerator() and denominator() return the current, possibly unreduced, terms. The denominator is always positive.
+	constexpr Wide numerator() const {return this->n;}
+	constexpr Wide denominator() const {return this->d;}
+
+
+	//Conversions
+
+	//reduce() cancels the common factors of the stored terms.
+	constexpr void reduce() {*this=this->reduced();}
+
+	//toFraction() returns the normalized Fraction of the value.
+	//It throws std::overflow_error if the lowest terms do not fit in BasicFraction<IntT>.
+	constexpr BasicFraction<IntT> toFraction() const
+	{
+		BasicLazyFraction r=this->reduced();
+		typedef typename BasicFraction<IntT>::Unsigned Unsigned;
+		UWide maxDenominator=static_cast<Unsigned>(~static_cast<Unsigned>(0));
+		UWide maxNumerator=maxDenominator>>1;
+		if(static_cast<UWide>(r.d)>maxDenominator || magnitude(r.n)>maxNumerator+(r.n<0))
+		{
+			throw std::overflow_error("Math error: Fraction overflow\n");
+		}
+		return BasicFraction<IntT>(static_cast<IntT>(r.n),static_cast<Unsigned>(r.d),typename BasicFraction<IntT>::Reduced());
+	}
+
+	//explicit BasicFraction<IntT>(L) <------> L.toFraction()
+	//It is explicit, so that mixed expressions are never ambiguous between the two types of operators.
+	constexpr explicit operator BasicFraction<IntT>() const {return this->toFraction();}
+
+
+	//Unary Arithmetic Operators
+
+	//-L1 <-------> L1.operator-()
+	constexpr BasicLazyFraction operator-() const {return this->negated();}
+
+	//+L1 <-------> L1.operator+()
+	constexpr BasicLazyFraction operator+() const {return *this;}
+
+
+	//Binary Arithmetic Operators
+	//They are friends defined inside the class, so a Fraction or an integer on either side converts to a LazyFraction.
+
+	//L1+L2 <------> operator+(L1,L2)
+	friend constexpr BasicLazyFraction operator+(const BasicLazyFraction& lhs,const BasicLazyFraction& rhs)
+	{
+		return sum(lhs,rhs);
+	}
+
+	//L1-L2 <------> operator-(L1,L2)
+	friend constexpr BasicLazyFraction operator-(const BasicLazyFraction& lhs,const BasicLazyFraction& rhs)
+	{
+		return sum(lhs,rhs.negated());
+	}
+
+	//L1*L2 <------> operator*(L1,L2)
+	friend constexpr BasicLazyFraction operator*(const BasicLazyFraction& lhs,const BasicLazyFraction& rhs)
+	{
+		return product(lhs.n,rhs.n,lhs.d,rhs.d);
+	}
+
+	//L1/L2 <------> operator/(L1,L2)
+	//If L2=0 then, it throws an exception because the value L1/L2 is undefined.
+	friend constexpr BasicLazyFraction operator/(const BasicLazyFraction& lhs,const BasicLazyFraction& rhs)
+	{
+		if(rhs.n==0)
+		{
+			throw std::runtime_error("Math error: Attempted to divide by Zero\n");
+		}
+		BasicLazyFraction r=(rhs.n<0) ? rhs.negated() : rhs;
+		r=product(lhs.n,r.d,lhs.d,r.n);
+		return (rhs.n<0) ? r.negated() : r;
+	}
+
+	//Compound assignment operators for accumulation loops.
+	constexpr BasicLazyFraction& operator+=(const BasicLazyFraction& rhs) {return *this=*this+rhs;}
+	constexpr BasicLazyFraction& operator-=(const BasicLazyFraction& rhs) {return *this=*this-rhs;}
+	constexpr BasicLazyFraction& operator*=(const BasicLazyFraction& rhs) {return *this=*this*rhs;}
+	constexpr BasicLazyFraction& operator/=(const BasicLazyFraction& rhs) {return *this=*this/rhs;}
+
+
+	//Binary Relational Operators
+	//They compare the values, whatever the terms: 2/4==1/2.
+
+	//compare(L1,L2) returns a negative value, zero or a positive value if L1 is less than, equal to or greater than L2.
+	friend constexpr int compare(const BasicLazyFraction& lhs,const BasicLazyFraction& rhs)
+	{
+		int ls=(lhs.n>0)-(lhs.n<0);
+		int rs=(rhs.n>0)-(rhs.n<0);
+		if(ls!=rs || ls==0)
+		{
+			return ls-rs;
+		}
+		int c=FractionGCD::compareRatios<UWide>(magnitude(lhs.n),static_cast<UWide>(lhs.d),magnitude(rhs.n),static_cast<UWide>(rhs.d));
+		return ls<0 ? -c : c;
+	}
+
+	friend constexpr bool operator==(const BasicLazyFraction& lhs,const BasicLazyFraction& rhs) {return compare(lhs,rhs)==0;}
+	friend constexpr bool operator!=(const BasicLazyFraction& lhs,const BasicLazyFraction& rhs) {return compare(lhs,rhs)!=0;}
+	friend constexpr bool operator<(const BasicLazyFraction& lhs,const BasicLazyFraction& rhs) {return compare(lhs,rhs)<0;}
+	friend constexpr bool operator<=(const BasicLazyFraction& lhs,const BasicLazyFraction& rhs) {return compare(lhs,rhs)<=0;}
+	friend constexpr bool operator>(const BasicLazyFraction& lhs,const BasicLazyFraction& rhs) {return compare(lhs,rhs)>0;}
+	friend constexpr bool operator>=(const BasicLazyFraction& lhs,const BasicLazyFraction& rhs) {return compare(lhs,rhs)>=0;}
+
+
+	//Advanced Operators
+
+	//std::cout << L1 <------> operator<<(cout,L1)
+	//The value is printed in lowest terms, in the format of Fraction.
+	friend std::ostream& operator<<(std::ostream &OUT,const BasicLazyFraction &rhs)
+	{
+		BasicLazyFraction r=rhs.reduced();
+		writeInteger(OUT,r.n);
+		if(r.d!=1)
+		{
+			OUT << " / ";
+			writeInteger(OUT,r.d);
+		}
+		return OUT;
+	}
+};
+
+//LazyFraction accumulates Fraction values and LazyFraction64 accumulates Fraction64 values, both in 128 bit terms.
+typedef BasicLazyFraction<std::int32_t> LazyFraction;
+typedef BasicLazyFraction<std::int64_t> LazyFraction64;
+
+#endif // __LAZY_FRACTION_H__
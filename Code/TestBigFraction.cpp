@@ -0,0 +1,171 @@
+// File: TestBigFraction.cpp
+// Contains: void TestBigFraction()
+/************ C++ Headers ************************************/
+
+#include <iostream>
+#include <sstream>
+#include <stdexcept>
+#include <vector>
+using namespace std;
+
+/************ PROJECT Headers ********************************/
+
+#include "BigFraction.h"
+#include "Fraction.h"
+#include "FractionArena.h"
+#include "FractionLP.h"
+#include "FractionMatrix.h"
+#include "FractionPolynomial.h"
+
+void TestBigFraction() {
+
+	cout << "\nTest BigFraction Data Type" << endl;
+
+	// CONSTRUCTORS
+	// ------------
+
+	BigFraction b1(10, -4);
+	BigFraction b2(Fraction(7, 3));
+	BigFraction b3(BigInteger::fromString("123456789012345678901234567890"), BigInteger::fromString("987654321098765432109876543210"));
+	cout << "BigFraction b1(10, -4) = " << b1 << endl;
+	cout << "BigFraction b2(Fraction(7, 3)) = " << b2 << endl;
+	cout << "BigFraction b3(123456789012345678901234567890, 987654321098765432109876543210) = " << b3 << endl;
+
+	// ARITHMETIC BEYOND THE RANGE OF FRACTION
+	// ---------------------------------------
+
+	// The harmonic number H(100) has a 40 digit numerator.
+	BigFraction h = BigFraction::sc_fZero;
+	for (int k = 1; k <= 100; k++)
+		h = h + BigFraction(1, k);
+	cout << "H(100) = " << h << endl;
+	cout << "H(100) as double = " << h.toDouble() << endl;
+
+	Fraction f1(65537, 65536), f2(65539, 65538);
+	try {
+		Fraction f3 = f1 * f2;
+		cout << "Fraction product = " << f3 << endl;
+	}
+	catch (const overflow_error&) {
+		cout << "Fraction product of " << f1 << " and " << f2 << " overflows" << endl;
+	}
+	cout << "BigFraction product = " << BigFraction(f1) * BigFraction(f2) << endl;
+
+	// The same sum in a FractionArena: the limbs come from its chunks, and the arena is reset when the scope ends.
+	FractionArena arena;
+	{
+		FractionArena::Scope scope(arena);
+		BigFraction pooled = BigFraction::sc_fZero;
+		for (int k = 1; k <= 100; k++)
+			pooled = pooled + BigFraction(1, k);
+		cout << "H(100) in an arena is the same = " << (pooled == h) << ", blocks in use = " << arena.liveBlocks() << endl;
+	}
+	cout << "Blocks in use after the scope = " << arena.liveBlocks() << ", blocks served = " << (arena.blocks() > 0) << endl;
+
+	BigFraction b4(BigInteger::fromString("-100000000000000000000000000001"), 3);
+	BigFraction b5(7, 2);
+	cout << "Binary Minus: " << b4 << " - " << b5 << " = " << b4 - b5 << endl;
+	cout << "Divide: " << b4 << " / " << b5 << " = " << b4 / b5 << endl;
+	cout << "Residue: " << b4 << " % " << b5 << " = " << b4 % b5 << endl;
+	cout << "Reciprocal: !" << b4 << " = " << !b4 << endl;
+
+	// BINARY RELATIONAL OPERATORS
+	// ---------------------------
+
+	bool bTest = b4 < b5;
+	cout << "Less: Test = " << ((bTest)? "true": "false")
+		<< ". b4 = " << b4 << ". b5 = " << b5 << endl;
+
+	bTest = h > BigFraction(5);
+	cout << "Greater: Test = " << ((bTest)? "true": "false")
+		<< ". H(100) > 5" << endl;
+
+	bTest = (b1 - b1) == BigFraction::sc_fZero;
+	cout << "Equal: Test = " << ((bTest)? "true": "false")
+		<< ". b1 - b1 == 0" << endl;
+
+	// TEXT CONVERSION
+	// ---------------
+
+	// The extraction operator reads the output of the insertion operator back, with the grammar of the Fraction extractor.
+	stringstream text;
+	text << b4 << " " << b5 << " " << BigFraction(-12) << " 6/8";
+	cout << "Round trip of \"" << text.str() << "\":";
+	BigFraction parsed;
+	while (text >> parsed)
+		cout << " [" << parsed << "]";
+	cout << endl;
+
+	// EXACT LINEAR ALGEBRA
+	// --------------------
+
+	// The 4 x 4 Hilbert matrix H(i, j) = 1 / (i + j + 1) has the determinant 1/6048000 and an integer inverse.
+	FractionMatrix H(4, 4);
+	for (size_t i = 0; i < 4; i++)
+		for (size_t j = 0; j < 4; j++)
+			H(i, j) = Fraction(1, static_cast<int>(i + j + 1));
+	cout << "det(Hilbert 4 x 4) = " << H.determinant() << endl;
+	cout << "inverse(Hilbert 4 x 4) =\n" << H.inverse();
+	vector<Fraction> x = H.solve({Fraction(1), Fraction(1, 2), Fraction(1, 3), Fraction(1, 4)});
+	cout << "Hilbert 4 x 4 * x = first column: x = " << x[0] << ", " << x[1] << ", " << x[2] << ", " << x[3] << endl;
+	FractionMatrix S({{Fraction(1, 2), Fraction(1, 3), Fraction(1)}, {Fraction(1), Fraction(2, 3), Fraction(2)}, {Fraction(1, 5), Fraction(0), Fraction(-1)}});
+	cout << "rank of a 3 x 3 matrix whose second row is twice the first = " << S.rank() << ", det = " << S.determinant() << endl;
+	try {
+		S.inverse();
+	}
+	catch (const runtime_error& e) {
+		cout << "inverse of a singular matrix: " << e.what();
+	}
+
+	// LINEAR PROGRAMMING
+	// ------------------
+
+	// maximize 3x + 5y subject to x <= 4, 2y <= 12, 3x + 2y <= 18, x, y >= 0 has the optimum 36 at (2, 6).
+	FractionLP lp(2, FractionLP::eMaximize);
+	lp.setObjective(0, Fraction(3));
+	lp.setObjective(1, Fraction(5));
+	lp.addConstraint({{0, Fraction(1)}}, FractionLP::eLessEqual, Fraction(4));
+	lp.addConstraint({{1, Fraction(2)}}, FractionLP::eLessEqual, Fraction(12));
+	lp.addConstraint({{0, Fraction(3)}, {1, Fraction(2)}}, FractionLP::eLessEqual, Fraction(18));
+	lp.solve();
+	cout << "max 3x + 5y = " << lp.objective() << " at x = " << lp.value(0) << ", y = " << lp.value(1) << endl;
+
+	// minimize x + y subject to x + 3y >= 1/2, 2x + y = 7/3 needs the first phase. The optimum 7/6 has no exact floating point value.
+	FractionLP mix(2);
+	mix.setObjective(0, Fraction(1));
+	mix.setObjective(1, Fraction(1));
+	mix.addConstraint({{0, Fraction(1)}, {1, Fraction(3)}}, FractionLP::eGreaterEqual, Fraction(1, 2));
+	mix.addConstraint({{0, Fraction(2)}, {1, Fraction(1)}}, FractionLP::eEqual, Fraction(7, 3));
+	mix.solve();
+	cout << "min x + y = " << mix.objective() << " at x = " << mix.value(0) << ", y = " << mix.value(1) << endl;
+
+	// x >= 2 and x <= 1 have no solution; maximizing x alone has no bound.
+	FractionLP none(1), unbounded(1, FractionLP::eMaximize);
+	none.addConstraint({{0, Fraction(1)}}, FractionLP::eGreaterEqual, Fraction(2));
+	none.addConstraint({{0, Fraction(1)}}, FractionLP::eLessEqual, Fraction(1));
+	unbounded.setObjective(0, Fraction(1));
+	unbounded.addConstraint({{0, Fraction(1)}}, FractionLP::eGreaterEqual, Fraction(2));
+	cout << "x >= 2, x <= 1: " << (none.solve() == FractionLP::eInfeasible ? "infeasible" : "feasible")
+		<< ". max x, x >= 2: " << (unbounded.solve() == FractionLP::eUnbounded ? "unbounded" : "bounded") << endl;
+
+	// POLYNOMIALS
+	// -----------
+
+	// (x - 1/2)(x + 2/3) = x^2 + (1/6)x - 1/3, and (x - 1/2)(x^2 + 1) shares the factor x - 1/2 with it.
+	FractionPolynomial P1({Fraction(-1, 2), Fraction(1)}), P2({Fraction(2, 3), Fraction(1)}), P3({Fraction(1), Fraction(0), Fraction(1)});
+	FractionPolynomial FG = P1 * P2, FH = P1 * P3;
+	cout << "(x - 1/2)(x + 2/3) = " << FG << ", at 3/4: " << FG(BigFraction(3, 4)) << endl;
+	cout << "gcd(" << FG << ", " << FH << ") = " << FractionPolynomial::gcd(FG, FH) << endl;
+	FractionPolynomial Q, R;
+	divMod(FH, P2, Q, R);
+	cout << "(" << FH << ") / (" << P2 << ") = " << Q << ", remainder " << R << endl;
+	try {
+		cout << FG / FractionPolynomial() << endl;
+	}
+	catch (const runtime_error& e) {
+		cout << "Division by the zero polynomial: " << e.what();
+	}
+
+	return;
+}
+// End-of-File: TestBigFraction.cpp
@@ -2,12 +2,28 @@
 // Contains: void TestFraction()
 /************ C++ Headers ************************************/
 
+#include <algorithm>
+#include <charconv>
 #include <iostream>
+#include <limits>
+#include <sstream>
+#include <stdexcept>
+#include <string>
+#include <unordered_set>
+#include <vector>
 using namespace std;
 
 /************ PROJECT Headers ********************************/
 
+#include <ratio>
 #include "Fraction.h"
+#include "FractionHash.h"
+#include "FractionReduce.h"
+#include "FractionSort.h"
+#include "FractionStats.h"
+#include "LazyFraction.h"
+
+using namespace fraction::literals;
 
 void TestFraction() {
 	
@@ -22,6 +38,8 @@ void TestFraction() {
 	cout << "Fraction f1(5, 3) = " << f1 << endl;
 	cout << "Fraction f2(7.2) = " << f2 << endl;
 	cout << "Fraction f3 = " << f3 << endl;
+	cout << "Fraction(0.375) = " << Fraction(0.375) << endl;
+	cout << "Fraction::bestRational(3.14159265358979, 1000) = " << Fraction::bestRational(3.14159265358979, 1000) << endl;
 	
 	// BASIC ASSIGNEMENT OPERATOR
 	// --------------------------
@@ -102,6 +120,64 @@ void TestFraction() {
 	cout << "Residue: f3 = " << f3 << ". f1 = " << f1
 		<< ". f2 = " << f2 << endl;
 	
+	// An integer operand takes no Fraction of its own: F + k is (p + k * q) / q, F * k and F / k cancel one gcd.
+	f1 = Fraction(5, 12);
+	cout << "Integer operands: f1 + 2 = " << f1 + 2 << ". 1 - f1 = " << 1 - f1 << ". f1 * 8 = " << f1 * 8
+		<< ". f1 / 10 = " << f1 / 10 << ". 3 / f1 = " << 3 / f1 << endl;
+	// An unsigned or wider integer keeps its value: it is not truncated to int first.
+	cout << "Fraction(1, 3000) * 3000000000u = " << Fraction(1, 3000) * 3000000000u
+		<< ". Fraction(1, 4) * 4294967296LL = " << Fraction(1, 4) * 4294967296LL << endl;
+	bool thrown = false;
+	try {
+		Fraction(1, 2) * (1ULL << 32);
+	}
+	catch (const overflow_error&) {
+		thrown = true;
+	}
+	cout << "1/2 * 2^32 overflows = " << thrown;
+	thrown = false;
+	try {
+		-Fraction(numeric_limits<int>::min());
+	}
+	catch (const overflow_error&) {
+		thrown = true;
+	}
+	cout << ". -Fraction(INT_MIN) overflows = " << thrown << endl;
+	
+	f1 = Fraction(-7, 2);
+	f2 = Fraction(1);
+	FractionDivMod dm = divmod(f1, f2);
+	cout << f1 << " % " << f2 << " = " << f1 % f2 << ". floorDiv = " << floorDiv(f1, f2)
+		<< ". divmod = {" << dm.quotient << ", " << dm.remainder << "}" << endl;
+	cout << "1000000 % 1/1000 = " << Fraction(1000000) % Fraction(1, 1000)
+		<< ". 1000000 % 3/1000 = " << Fraction(1000000) % Fraction(3, 1000) << endl;
+	// The scaled numerators of Fraction128 operands may take 256 bits; the remainder is still exact when it fits.
+	Fraction128 g1(__int128(1) << 90, (__int128(1) << 60) + 1);
+	Fraction128 g2(__int128(1) << 95, (__int128(1) << 61) + 3);
+	cout << "Fraction128 a = 2^90/(2^60+1), b = 2^95/(2^61+3): a % b == a = " << (g1 % g2 == g1)
+		<< ". floorDiv(a, b) = " << floorDiv(g1, g2) << ". floorDiv(-a, b) = " << floorDiv(-g1, g2) << endl;
+	
+	// Checked arithmetic reports errors in its result instead of throwing.
+	CheckedFraction r1 = Fraction::make(5, 0), r2 = checkedDiv(f1, Fraction(0)), r3 = checkedInverse(Fraction(1, 3));
+	cout << "make(5, 0) ok = " << r1.has_value() << ". f1 / 0 divides by zero = " << (r2.error() == eFractionDivideByZero)
+		<< ". checkedInverse(1/3) = " << r3.value_or(Fraction(0)) << endl;
+	FractionStickyStatus sticky;
+	Fraction large(2000000000), total(0);
+	for (int i = 0; i < 3; i++)
+		total = sticky(checkedAdd(total, large));
+	cout << "Three times " << large << " overflows = " << (sticky.status == eFractionOverflow) << endl;
+	// The throwing Constructor and make() agree on the most negative numerator.
+	thrown = false;
+	try {
+		Fraction(numeric_limits<int>::min(), -1);
+	}
+	catch (const overflow_error&) {
+		thrown = true;
+	}
+	cout << "Fraction(INT_MIN, -1) throws = " << thrown << ". make(INT_MIN, -1) overflows = "
+		<< (Fraction::make(numeric_limits<int>::min(), -1).error() == eFractionOverflow) << ". Fraction(INT_MIN, -2) = "
+		<< Fraction(numeric_limits<int>::min(), -2) << endl;
+	
 	
 	// BINARY RELATIONAL OPERATORS
 	// ---------------------------
@@ -145,6 +221,116 @@ void TestFraction() {
 	cout << "Greater Equal: Test = " << ((bTest)? "true": "false")
 		<< ". f1 = " << f1 << ". f3 = " << f3 << endl;
 		
+	// COMPILE-TIME FRACTIONS
+	// ----------------------
+	
+	constexpr Fraction c1 = 0.125_fr;
+	constexpr Fraction c2 = Fraction(std::centi());
+	constexpr Fraction c3 = c1 + c2 * 3_fr;
+	cout << "Constant: c3 = " << c3 << ". c1 = " << c1
+		<< ". c2 = " << c2 << endl;
+		
+	// LAZY NORMALIZATION
+	// ------------------
+	
+	// The chain keeps unreduced terms and cancels them once, in toFraction().
+	LazyFraction l1 = LazyFraction(Fraction(2, 3)) * Fraction(3, 4) + LazyFraction(Fraction(5, 6)) * Fraction(3, 5) - Fraction(1, 2);
+	cout << "Lazy: 2/3 * 3/4 + 5/6 * 3/5 - 1/2 unreduced = " << static_cast<long long>(l1.numerator()) << " / " << static_cast<long long>(l1.denominator())
+		<< ". Reduced = " << l1.toFraction() << endl;
+		
+	bTest = l1 == LazyFraction(Fraction(1, 2));
+	cout << "Lazy Equal: Test = " << ((bTest)? "true": "false")
+		<< ". l1 = " << l1 << endl;
+		
+	// PARALLEL REDUCTIONS
+	// -------------------
+	
+	// 1/1 + 1/2 + ... + 1/20, the telescoping product 2/1 * 3/2 * ... * 21/20 and the sum of k*k * 1/k over two threads.
+	vector<Fraction> u, v, w;
+	for (int k = 1; k <= 20; k++) {
+		u.push_back(Fraction(k * k));
+		v.push_back(Fraction(1, k));
+		w.push_back(Fraction(k + 1, k));
+	}
+	cout << "reduce_sum(1/1 .. 1/20) = " << fraction::reduce_sum(v, 2) << endl;
+	cout << "reduce_product(2/1 .. 21/20) = " << fraction::reduce_product(w, 2) << endl;
+	cout << "dot(k * k, 1/k) for k = 1 .. 20 = " << fraction::dot(u, v, 2) << endl;
+	
+	// The partial sum 2^30 + 2^30 overflows a Fraction, the total does not.
+	vector<Fraction> big = {Fraction(1 << 30), Fraction(1 << 30), Fraction(-(1 << 30))};
+	cout << "reduce_sum(2^30, 2^30, -2^30) = " << fraction::reduce_sum(big) << endl;
+	
+	// fraction::sort gives the order of std::sort. The two largest values are closer than the precision of a double.
+	vector<Fraction> sorted;
+	sorted.push_back(Fraction(999999999, 1000000000));
+	for (int k = 1; k <= 1000; k++)
+		sorted.push_back(Fraction((k * 7919) % 1999 - 999, 1000 + k));
+	sorted.push_back(Fraction(999999998, 999999999));
+	fraction::sort(sorted);
+	cout << "fraction::sort of " << sorted.size() << " Fractions: " << sorted.front() << " .. " << sorted[sorted.size() - 2]
+		<< ", " << sorted.back() << (is_sorted(sorted.begin(), sorted.end()) ? " (sorted)" : " (not sorted)") << endl;
+		
+	// TEXT CONVERSION
+	// ---------------
+	
+	// to_chars writes to a caller-provided buffer. from_chars reads p/q, p / q, integers and decimals.
+	char text[64];
+	to_chars_result written = fraction::to_chars(text, text + sizeof(text), Fraction(-5, 12));
+	cout << "to_chars(-5/12) = " << string(text, written.ptr) << endl;
+	const char* inputs[] = {"6/4", "-3 / 9", "42", "-0.125", "6.02e3", "4294967296"};
+	for (const char* input : inputs) {
+		f1 = Fraction::sc_fZero;
+		from_chars_result parsed = fraction::from_chars(input, input + char_traits<char>::length(input), f1);
+		cout << "from_chars(\"" << input << "\") = " << f1
+			<< ((parsed.ec == errc::result_out_of_range) ? " (out of range)" : "") << endl;
+	}
+	
+	// The extraction operator reads the output of the insertion operator back.
+	stringstream log;
+	log << Fraction(3, 4) << " " << Fraction(-7) << " " << Fraction(-1, 6);
+	cout << "Round trip of \"" << log.str() << "\":";
+	while (log >> f1)
+		cout << " [" << f1 << "]";
+	cout << endl;
+	// A denominator may exceed the largest numerator: 1/65536 * 1/32768 is 1 / 2147483648, and it reads back too.
+	stringstream wide;
+	wide << Fraction(1, 65536) * Fraction(1, 32768);
+	cout << "Round trip of \"" << wide.str() << "\": ";
+	if (wide >> f1)
+		cout << f1 << ((f1 == Fraction(1, 65536) * Fraction(1, 32768)) ? " (equal)" : " (different)") << endl;
+	else
+		cout << "failed" << endl;
+		
+	// HASHING
+	// -------
+	
+	// Equal Fractions have equal terms, so 1/2 and 2/4 are one key.
+	FractionHashMap<int> counts;
+	Fraction keys[] = {Fraction(1, 2), Fraction(2, 4), Fraction(-1, 3), Fraction(3, 6), Fraction(-2, 6)};
+	for (const Fraction& key : keys)
+		counts[key]++;
+	cout << "Distinct keys = " << counts.size() << ", count of 1/2 = " << *counts.find(Fraction(1, 2))
+		<< ", count of -1/3 = " << *counts.find(Fraction(-1, 3)) << endl;
+	counts.erase(Fraction(4, 8));
+	cout << "After erasing 4/8: contains 1/2 = " << counts.contains(Fraction(1, 2)) << ", size = " << counts.size() << endl;
+	unordered_set<Fraction> seen(begin(keys), end(keys));
+	cout << "std::unordered_set of the same keys has " << seen.size() << " elements" << endl;
+		
+	// INSTRUMENTATION
+	// ---------------
+	
+	// The counters of the thread are only kept in a build with -DFRACTION_STATS.
+	if (FractionStats::sc_bEnabled) {
+		FractionStats::Counters before = FractionStats::snapshot();
+		Fraction harmonic = Fraction::sc_fZero;
+		for (int k = 1; k <= 20; k++)
+			harmonic = harmonic + Fraction(1, k);
+		cout << "Counters of the sum 1/1 + ... + 1/20 = " << harmonic << ":" << endl;
+		FractionStats::dump(cout, FractionStats::snapshot() - before);
+	}
+	else
+		cout << "FractionStats is disabled, build with -DFRACTION_STATS to count the operations" << endl;
+		
 	return;
 }
 // End-of-File: TestFraction.cxx
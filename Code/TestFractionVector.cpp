@@ -0,0 +1,101 @@
+// File: TestFractionVector.cpp
+// Contains: void TestFractionVector()
+/************ C++ Headers ************************************/
+
+#include <cstdio>
+#include <iostream>
+#include <vector>
+using namespace std;
+
+/************ PROJECT Headers ********************************/
+
+#include "Fraction.h"
+#include "FractionFile.h"
+#include "FractionVector.h"
+
+static void Print(const string& name, const FractionVector& v) {
+	cout << name << " = [";
+	for (size_t i = 0; i < v.size(); i++)
+		cout << ((i == 0) ? "" : ", ") << v[i];
+	cout << "]" << endl;
+}
+
+void TestFractionVector() {
+
+	cout << "\nTest FractionVector Data Type" << endl;
+
+	// CONSTRUCTORS
+	// ------------
+
+	// Ten elements, so that the batch kernels run a block of eight and a tail of two.
+	vector<Fraction> a, b;
+	for (int i = 1; i <= 10; i++) {
+		a.push_back(Fraction(i, i + 1));
+		b.push_back(Fraction(-i, 2 * i + 3));
+	}
+	FractionVector x(a), y(b);
+	Print("x", x);
+	Print("y", y);
+	FractionVector z(3, Fraction(1, 2));
+	Print("FractionVector z(3, 1/2)", z);
+
+	// BATCH KERNELS
+	// -------------
+
+	FractionVector r;
+	FractionVector::add(x, y, r);
+	Print("add(x, y)", r);
+	FractionVector::sub(x, y, r);
+	Print("sub(x, y)", r);
+	FractionVector::mul(x, y, r);
+	Print("mul(x, y)", r);
+	FractionVector::div(x, y, r);
+	Print("div(x, y)", r);
+	FractionVector::scale(x, Fraction(3, 5), r);
+	Print("scale(x, 3/5)", r);
+
+	vector<int8_t> c;
+	FractionVector::compare(x, y, c);
+	cout << "compare(x, y) = [";
+	for (size_t i = 0; i < c.size(); i++)
+		cout << ((i == 0) ? "" : ", ") << static_cast<int>(c[i]);
+	cout << "]" << endl;
+
+	// The batch results are the results of the checked operators.
+	bool bTest = true;
+	FractionVector::add(x, y, r);
+	for (size_t i = 0; i < x.size(); i++)
+		bTest = bTest && (r[i] == a[i] + b[i]);
+	cout << "Batch add equals operator+: Test = " << ((bTest)? "true": "false") << endl;
+
+	// OVERFLOW
+	// --------
+
+	// An element that overflows holds 0/1 and the status of the first failing element is returned.
+	FractionVector big(9, Fraction(65537, 65536));
+	big.set(4, Fraction(1, 2));
+	FractionStatus status = FractionVector::mul(big, big, r);
+	cout << "mul of 65537/65536 elements: status overflow = " << ((status == eFractionOverflow)? "true": "false")
+		<< ". r[4] = " << r[4] << ". r[0] = " << r[0] << endl;
+
+	// BINARY FILES
+	// ------------
+
+	// x is written in both encodings and read back through a mapped view.
+	const char* path = "TestFractionVector.bin";
+	FractionFile::write(path, x, FractionFile::eEncodingVarint);
+	{
+		FractionFile file(path);
+		cout << "FractionFile varint: size = " << file.size() << ". file[3] = " << file[3]
+			<< ". Equal to x: " << ((file.toVector().toVector() == x.toVector())? "true": "false") << endl;
+	}
+	FractionFile::write(path, x);
+	{
+		FractionFile file(path);
+		Print("FractionFile fixed", file.toVector());
+	}
+	remove(path);
+
+	return;
+}
+// End-of-File: TestFractionVector.cpp
@@ -6,9 +6,13 @@ using namespace std;
 /************ PROJECT Headers ********************************/
 #include "Fraction.h"
 void TestFraction();
+void TestBigFraction();
+void TestFractionVector();
 
 int main() {
 	TestFraction();
+	TestBigFraction();
+	TestFractionVector();
 	return 0;
 }
 // End-of-File: Main.cxx